@@ -5,6 +5,8 @@
  *      Author: bog
  */
 
+#include "../bugs/Infrastructure.h"
+
 #include <easyunit/testharness.h>
 
 using namespace easyunit;
@@ -14,6 +16,9 @@ int main()
 
   TestRegistry::runAndPrint();
 
+  // the tests that update a World use the shared thread pool, which must be stopped before exiting:
+  Infrastructure::shutDown();
+
 }
 
 
@@ -0,0 +1,69 @@
+/*
+ * bigFile-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/serialization/BigFile.h"
+
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+const char* bigFilePath = "/tmp/bigFile-test.data";
+
+} // namespace
+
+TEST(bigFile, saveAndMap) {
+	std::vector<char> big(1 << 20);
+	for (unsigned i=0; i<big.size(); i++)
+		big[i] = (char)(i * 7);
+	std::string master = "master record";
+	{
+		BigFile out;
+		out.addFile("master", master.data(), master.size());
+		out.addFile("big", big.data(), big.size());
+		out.addFile("empty", nullptr, 0);
+		ASSERT_TRUE(out.saveToDisk(bigFilePath));
+	}
+	BigFile in;
+	ASSERT_TRUE(in.loadFromDisk(bigFilePath));
+	BigFile::FileDescriptor fd = in.getFile("master");
+	ASSERT_EQUALS((int)master.size(), (int)fd.size);
+	ASSERT_TRUE(!memcmp(fd.pStart, master.data(), master.size()));
+	BigFile::FileDescriptor fdBig = in.getFile("big");
+	ASSERT_EQUALS((int)big.size(), (int)fdBig.size);
+	ASSERT_TRUE(!memcmp(fdBig.pStart, big.data(), big.size()));
+	ASSERT_TRUE(in.getFile("empty").pStart == nullptr);
+	ASSERT_EQUALS(3, (int)in.getAllFiles().size());
+	// writing into a loaded buffer doesn't change the file:
+	((char*)fdBig.pStart)[0] = 1;
+	BigFile in2;
+	ASSERT_TRUE(in2.loadFromDisk(bigFilePath));
+	ASSERT_EQUALS(0, (int)((char*)in2.getFile("big").pStart)[0]);
+}
+
+TEST(bigFile, truncated) {
+	std::vector<char> data(1000, 'x');
+	{
+		BigFile out;
+		out.addFile("data", data.data(), data.size());
+		ASSERT_TRUE(out.saveToDisk(bigFilePath));
+	}
+	ASSERT_EQUALS(0, truncate(bigFilePath, 500));
+	BigFile in;
+	ASSERT_TRUE(!in.loadFromDisk(bigFilePath));
+	ASSERT_TRUE(in.getAllFiles().empty());
+	ASSERT_EQUALS(0, truncate(bigFilePath, 0));
+	ASSERT_TRUE(!in.loadFromDisk(bigFilePath));
+	ASSERT_TRUE(!in.loadFromDisk("/tmp/bigFile-test.missing"));
+	remove(bigFilePath);
+}
@@ -0,0 +1,51 @@
+/*
+ * bugGenome-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/entities/Bug.h"
+#include "../../bugs/genetics/MutationEngine.h"
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+// true if all the segments of [c] are shared with the default chromosome template
+bool sharesTemplate(Chromosome const& c) {
+	GeneSequence const& basic = Bug::getBasicChromosome().genes;
+	if (c.genes.size() != basic.size())
+		return false;
+	for (size_t i=0; i<basic.getSegmentCount(); i++)
+		if (!c.genes.sharesSegment(basic, i))
+			return false;
+	return true;
+}
+
+} // namespace
+
+TEST(bugGenome, basicGenomesShareTemplate) {
+	Genome g1 = Bug::createBasicGenome();
+	Genome g2 = Bug::createBasicGenome();
+	ASSERT_TRUE(g1.first.genes.size() > 0);
+	ASSERT_TRUE(sharesTemplate(g1.first));
+	ASSERT_TRUE(sharesTemplate(g1.second));
+	ASSERT_TRUE(sharesTemplate(g2.first));
+}
+
+TEST(bugGenome, alteringDoesNotTouchTemplate) {
+	Chromosome const& basic = Bug::getBasicChromosome();
+	size_t size = basic.genes.size();
+	float firstChance = basic.genes[0].chance_to_delete.value;
+	for (int i=0; i<10; i++) {
+		Genome g = Bug::createBasicGenome();
+		MutationEngine::alterChromosome(g.first);
+		MutationEngine::alterChromosome(g.second);
+		ASSERT_TRUE(!sharesTemplate(g.first));
+	}
+	ASSERT_EQUALS((int)size, (int)basic.genes.size());
+	ASSERT_EQUALS(firstChance, basic.genes[0].chance_to_delete.value);
+	ASSERT_TRUE(sharesTemplate(Bug::createBasicGenome().first));
+}
@@ -0,0 +1,161 @@
+/*
+ * event-bench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+/*
+ * Checks the Event semantics (stable handles, removal while triggering) and compares the cost of triggering an
+ * event with a few handlers (like PhysicsBody::onCollision with a Mouth listening) against the old implementation,
+ * which kept std::function objects and copied each of them on every trigger.
+ */
+
+#include "../../bugs/utils/Event.h"
+
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <iostream>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+// the previous Event implementation, for comparison
+template <typename T>
+class StdFunctionEvent {
+public:
+	int add(std::function<T> fn) {
+		callbackList_.push_back(fn);
+		return callbackList_.size() - 1;
+	}
+
+	template<typename... argTypes>
+	void trigger(argTypes... argList) {
+		for (auto c : callbackList_)
+			if (c)
+				c(argList...);
+	}
+
+private:
+	std::vector<std::function<T>> callbackList_;
+};
+
+struct listener {
+	float eaten = 0;
+	unsigned calls = 0;
+	void onCollision(void* other, float impulse) {
+		eaten += impulse;
+		calls++;
+	}
+};
+
+constexpr unsigned nTriggers = 2000000;
+constexpr unsigned nHandlers = 3;
+
+template<class E>
+float runBenchmark(const char* name) {
+	E event;
+	listener l[nHandlers];
+	for (auto &li : l)
+		event.add(std::bind(&listener::onCollision, &li, std::placeholders::_1, std::placeholders::_2));
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned i=0; i<nTriggers; i++)
+		event.trigger(nullptr, 1.e-3f);
+	auto end = std::chrono::high_resolution_clock::now();
+	float ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / (float)nTriggers;
+	std::cout << "\t" << name << ":\t" << ns << " ns/trigger\n";
+	return l[0].eaten + l[nHandlers-1].eaten;
+}
+
+} // namespace
+
+TEST(event, handles) {
+	Event<void(int)> ev;
+	std::vector<int> calls;
+	int h0 = ev.add([&calls] (int x) { calls.push_back(x); });
+	int h1 = ev.add([&calls] (int x) { calls.push_back(10 + x); });
+	int h2 = ev.add([&calls] (int x) { calls.push_back(20 + x); });
+	ev.trigger(1);
+	ASSERT_EQUALS(3, (int)calls.size());
+	ASSERT_EQUALS(11, calls[1]);
+
+	// removing one doesn't invalidate the others' handles:
+	ev.remove(h1);
+	calls.clear();
+	ev.trigger(2);
+	ASSERT_EQUALS(2, (int)calls.size());
+	ASSERT_EQUALS(2, calls[0]);
+	ASSERT_EQUALS(22, calls[1]);
+	ev.remove(h2);
+	int h3 = ev.add([&calls] (int x) { calls.push_back(30 + x); });
+	ASSERT_TRUE(h3 != h0 && h3 != h1 && h3 != h2);
+	ev.remove(h0);
+	calls.clear();
+	ev.trigger(3);
+	ASSERT_EQUALS(1, (int)calls.size());
+	ASSERT_EQUALS(33, calls[0]);
+}
+
+TEST(event, removeWhileTriggering) {
+	Event<void()> ev;
+	int count = 0;
+	int self = -1;
+	self = ev.add([&] {
+		count++;
+		ev.remove(self);	// one-shot
+	});
+	ev.add([&count] { count += 10; });
+	ev.trigger();
+	ASSERT_EQUALS(11, count);
+	ev.trigger();
+	ASSERT_EQUALS(21, count);
+}
+
+TEST(event, addAndRemoveWhileTriggering) {
+	Event<void()> ev;
+	std::vector<int> calls;
+	std::vector<int> handles;
+	// a callback that removes itself and keeps using its own captures, then adds enough others to grow the list:
+	handles.push_back(ev.add([&ev, &calls, &handles, tag = 1] {
+		ev.remove(handles[0]);
+		for (int i=0; i<64; i++)
+			handles.push_back(ev.add([&calls, i] { calls.push_back(100 + i); }));
+		calls.push_back(tag);
+	}));
+	ev.add([&calls] { calls.push_back(2); });
+	ev.trigger();
+	ASSERT_EQUALS(2, (int)calls.size());	// the new ones are only called next time
+	ASSERT_EQUALS(1, calls[0]);
+	ASSERT_EQUALS(2, calls[1]);
+	// a callback added during the trigger can be removed before it ever runs:
+	ev.remove(handles[1]);
+	calls.clear();
+	ev.trigger();
+	ASSERT_EQUALS(64, (int)calls.size());
+	ASSERT_EQUALS(2, calls[0]);
+	ASSERT_EQUALS(101, calls[1]);
+	ASSERT_EQUALS(163, calls[63]);
+}
+
+TEST(event, bigCallable) {
+	// too big for the inline storage, goes on the heap:
+	float big[16] {};
+	big[15] = 2.f;
+	float sum = 0;
+	Event<void(float)> ev;
+	ev.add([big, &sum] (float x) { sum += big[15] * x; });
+	Event<void(float)> copy = ev;
+	ev.trigger(1.f);
+	copy.trigger(2.f);
+	ASSERT_EQUALS_DELTA(6.f, sum, 1.e-5f);
+}
+
+TEST(event, benchmark) {
+	std::cout << "\n[event] " << nHandlers << " handlers, " << nTriggers << " triggers:\n";
+	float r1 = runBenchmark<StdFunctionEvent<void(void*, float)>>("std::function, copied");
+	float r2 = runBenchmark<Event<void(void*, float)>>("Event (Delegate)\t");
+	ASSERT_EQUALS_DELTA(r1, r2, r1 * 1.e-3f);
+}
@@ -0,0 +1,52 @@
+/*
+ * flatMap-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../utils/FlatMap.h"
+
+#include <map>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+TEST(flatMap, insertAndFind) {
+	FlatMap<int, int> m;
+	ASSERT_TRUE(m.find(3) == nullptr);
+	std::map<int, int> ref;
+	// negative, sequential and sparse keys; enough of them to grow the table several times
+	for (int i=-500; i<500; i++) {
+		int key = i * (i % 3 ? 1 : 7919);
+		m[key] += i;
+		ref[key] += i;
+	}
+	ASSERT_EQUALS((int)ref.size(), (int)m.size());
+	for (auto &p : ref) {
+		int* v = m.find(p.first);
+		ASSERT_TRUE(v != nullptr);
+		ASSERT_EQUALS(p.second, *v);
+	}
+	ASSERT_TRUE(!m.contains(123456789));
+	int n = 0, mismatches = 0;
+	m.forEach([&] (int key, int value) {
+		n++;
+		mismatches += ref[key] != value;
+	});
+	ASSERT_EQUALS((int)ref.size(), n);
+	ASSERT_EQUALS(0, mismatches);
+}
+
+TEST(flatMap, clear) {
+	FlatMap<const void*, int> m;
+	int a, b;
+	m[&a] = 1;
+	m[&b] = 2;
+	m.clear();
+	ASSERT_TRUE(m.empty());
+	ASSERT_TRUE(m.find(&a) == nullptr);
+	m[&b] = 3;
+	ASSERT_EQUALS(1, (int)m.size());
+	ASSERT_EQUALS(3, *m.find(&b));
+}
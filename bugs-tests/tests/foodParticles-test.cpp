@@ -0,0 +1,91 @@
+/*
+ * foodParticles-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/entities/food/FoodParticles.h"
+
+#include <vector>
+#include <algorithm>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+// the particles never look into their chunks, so any distinct addresses will do:
+FoodChunk* fakeChunk(int i) {
+	return reinterpret_cast<FoodChunk*>(0x1000 + i * 0x10);
+}
+
+std::vector<unsigned> queryAll(FoodParticles const& particles, glm::vec2 center, float radius) {
+	std::vector<unsigned> ret;
+	particles.query(center, radius, [&] (unsigned i) {
+		ret.push_back(i);
+	});
+	std::sort(ret.begin(), ret.end());
+	return ret;
+}
+
+} // namespace
+
+TEST(foodParticles, dragAndBounds) {
+	FoodParticles particles;
+	particles.setBounds(aabb(glm::vec2(-10, -10), glm::vec2(10, 10)));
+	particles.add(fakeChunk(0), glm::vec2(0, 0), glm::vec2(1, 0), 0.1f);
+	particles.add(fakeChunk(1), glm::vec2(9.9f, 0), glm::vec2(5, 0), 0.1f);
+	particles.update(0.1f);
+
+	// drag slows the particles down while they move:
+	ASSERT_TRUE(particles.getVelocity(0).x < 1.f && particles.getVelocity(0).x > 0.9f);
+	ASSERT_TRUE(particles.getPosition(0).x > 0.f && particles.getPosition(0).x < 0.1f);
+	// the second one hit the wall and bounced back, staying inside:
+	ASSERT_TRUE(particles.getVelocity(1).x < 0);
+	ASSERT_TRUE(particles.getPosition(1).x + particles.getRadius(1) <= 10.f);
+}
+
+TEST(foodParticles, query) {
+	FoodParticles particles;
+	particles.setBounds(aabb(glm::vec2(-10, -10), glm::vec2(10, 10)));
+	particles.add(fakeChunk(0), glm::vec2(0, 0), glm::vec2(0), 0.1f);
+	particles.add(fakeChunk(1), glm::vec2(1.3f, 0), glm::vec2(0), 0.4f);
+	particles.add(fakeChunk(2), glm::vec2(5, 5), glm::vec2(0), 0.1f);
+	particles.add(fakeChunk(3), glm::vec2(-20, -20), glm::vec2(0), 0.1f);	// outside, pushed into the bounds
+	// not in the grid before the first update:
+	ASSERT_TRUE(queryAll(particles, glm::vec2(0), 1.f).empty());
+	particles.update(0.f);
+
+	auto found = queryAll(particles, glm::vec2(0), 1.f);
+	// the second one's center is outside the circle (and its cell), but its edge is inside:
+	ASSERT_EQUALS(2, (int)found.size());
+	ASSERT_EQUALS(0, (int)found[0]);
+	ASSERT_EQUALS(1, (int)found[1]);
+	ASSERT_EQUALS(1, (int)queryAll(particles, glm::vec2(5.2f, 5), 0.2f).size());
+	ASSERT_EQUALS(1, (int)queryAll(particles, glm::vec2(-9.9f, -9.9f), 0.1f).size());
+	ASSERT_TRUE(queryAll(particles, glm::vec2(-5, 5), 2.f).empty());
+}
+
+TEST(foodParticles, remove) {
+	FoodParticles particles;
+	particles.setBounds(aabb(glm::vec2(-10, -10), glm::vec2(10, 10)));
+	for (int i=0; i<4; i++)
+		particles.add(fakeChunk(i), glm::vec2(i, 0), glm::vec2(0), 0.1f);
+	particles.update(0.f);
+
+	// the last one takes the place of the removed one:
+	ASSERT_TRUE(particles.remove(1) == fakeChunk(3));
+	ASSERT_EQUALS(3, (int)particles.size());
+	ASSERT_TRUE(particles.getChunk(1) == fakeChunk(3));
+	ASSERT_EQUALS_DELTA(3.f, particles.getPosition(1).x, 1.e-5f);
+	ASSERT_TRUE(particles.remove(2) == nullptr);
+	ASSERT_EQUALS(2, (int)particles.size());
+
+	// the grid is stale until the next update:
+	ASSERT_TRUE(queryAll(particles, glm::vec2(3, 0), 0.5f).empty());
+	particles.update(0.f);
+	auto found = queryAll(particles, glm::vec2(3, 0), 0.5f);
+	ASSERT_EQUALS(1, (int)found.size());
+	ASSERT_TRUE(particles.getChunk(found[0]) == fakeChunk(3));
+}
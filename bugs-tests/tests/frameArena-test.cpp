@@ -0,0 +1,110 @@
+/*
+ * frameArena-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../utils/FrameArena.h"
+#include "../../perf/mallocCounter.h"
+#include "../../bugs/World.h"
+#include "../../bugs/entities/enttypes.h"
+
+#include <Box2D/Box2D.h>
+
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include <cmath>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+// does what the bugs' parts do every frame with transient data: a spatial query, and a deferred action with
+// captures too big for a Delegate's inline storage
+class probe : public Entity {
+public:
+	probe(glm::vec2 pos) : pos_(pos) {}
+
+	FunctionalityFlags getFunctionalityFlags() const override { return FunctionalityFlags::UPDATABLE; }
+	glm::vec3 getWorldTransform() const override { return glm::vec3(pos_, 0); }
+	EntityType getEntityType() const override { return EntityType::FOOD_DISPENSER; }
+	aabb getAABB() const override { return aabb(pos_ - glm::vec2(1), pos_ + glm::vec2(1)); }
+
+	void update(float dt) override {
+		found_.clear();
+		getWorld()->getEntitiesInBox(found_, EntityType::FOOD_CHUNK, FunctionalityFlags::NONE, pos_, 2.f, true);
+		float a = found_.size(), b = dt, c = 1, d = 2, e = 3, f = 4, g = 5, h = 6;
+		getWorld()->queueDeferredAction([this, a, b, c, d, e, f, g, h] {
+			sum_ += a + b + c + d + e + f + g + h;
+		});
+	}
+
+	float sum_ = 0;
+
+private:
+	glm::vec2 pos_;
+	std::vector<Entity*> found_;	// kept across frames, like the parts' own buffers
+};
+
+} // namespace
+
+TEST(frameArena, reuseAndAlignment) {
+	FrameArena::nextFrame();
+	auto &arena = FrameArena::get();
+	char* a = static_cast<char*>(arena.allocate(3, 1));
+	double* d = static_cast<double*>(arena.allocate(sizeof(double), alignof(double)));
+	ASSERT_TRUE((uintptr_t)d % alignof(double) == 0);
+	ASSERT_TRUE((char*)d > a);
+	*d = 1.5;
+	// bigger than a block:
+	void* big = arena.allocate(FrameArena::BlockSize * 2, 16);
+	ASSERT_TRUE(big != nullptr);
+	// the next frame starts again from the beginning:
+	FrameArena::nextFrame();
+	char* a2 = static_cast<char*>(arena.allocate(3, 1));
+	ASSERT_TRUE(a2 == a);
+#ifdef DEBUG
+	// the old frame's memory is poisoned:
+	ASSERT_TRUE(*(unsigned char*)d == 0xDD);
+#endif
+}
+
+// heap allocations per World::update, with [nEntities] probes in the world
+float measureWorldUpdate(unsigned nEntities) {
+	b2World phys(b2Vec2(0, 0));
+	World world;
+	world.setPhysics(&phys);
+	world.setBounds(-50, 50, 50, -50);
+	std::vector<probe*> probes;
+	for (unsigned i=0; i<nEntities; i++) {
+		probes.push_back(new probe(glm::vec2(i % 100 - 50.f, i / 10 - 50.f)));
+		world.takeOwnershipOf(std::unique_ptr<Entity>(probes.back()));
+	}
+	// the first frames take over the entities and grow the arenas and the persistent buffers:
+	const int nWarmup = 40, nFrames = 60;
+	for (int f=0; f<nWarmup; f++)
+		world.update(0.02f);
+	int64_t before = perf::getMallocCount();
+	for (int f=0; f<nFrames; f++)
+		world.update(0.02f);
+	float mallocsPerUpdate = (float)(perf::getMallocCount() - before) / nFrames;
+	for (probe* p : probes)
+		if (fabs(p->sum_ - (nWarmup + nFrames) * 21.02f) > 1.e-2f)
+			return -1;	// some deferred actions were lost
+	return mallocsPerUpdate;
+}
+
+TEST(frameArena, worldUpdateMallocs) {
+	if (perf::getMallocCount() < 0)
+		return;	// the counter is disabled in this build
+	float small = measureWorldUpdate(100);
+	float big = measureWorldUpdate(1000);
+	std::cout << "\n[frameArena] heap allocations per World::update: " << small << " with 100 entities, "
+			<< big << " with 1000 entities\n";
+	ASSERT_TRUE(small >= 0 && big >= 0);
+	// the transient data of the entities doesn't touch the heap, whatever allocates is per update, not per entity:
+	ASSERT_EQUALS_DELTA(small, big, 0.5f);
+}
@@ -0,0 +1,90 @@
+/*
+ * geneSequence-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/genetics/GeneSequence.h"
+#include "../../perf/counters.h"
+
+#include <easyunit/test.h>
+
+using namespace easyunit;
+
+namespace {
+
+Gene synapseGene(int from) {
+	GeneSynapse g;
+	g.from.set(from);
+	g.to.set(0);
+	g.weight.set(0.5f);
+	g.priority.set(1.f);
+	return g;
+}
+
+GeneSequence makeSequence(unsigned n) {
+	GeneSequence seq;
+	for (unsigned i=0; i<n; i++)
+		seq.push_back(synapseGene(i));
+	return seq;
+}
+
+int64_t counter(const char* name) {
+	return perf::Counters::get(name).load();
+}
+
+} // namespace
+
+TEST(geneSequence, pushAndInsert) {
+	GeneSequence seq = makeSequence(70);
+	ASSERT_EQUALS(70, (int)seq.size());
+	ASSERT_EQUALS(3, (int)seq.getSegmentCount());
+	seq.insert(5, GeneNoOp());
+	ASSERT_EQUALS(71, (int)seq.size());
+	ASSERT_TRUE(seq[5].type == gene_type::NO_OP);
+	ASSERT_EQUALS(4, (int)seq[4].data.gene_synapse.from);
+	ASSERT_EQUALS(5, (int)seq[6].data.gene_synapse.from);
+	ASSERT_EQUALS(69, (int)seq[70].data.gene_synapse.from);
+	int k = 0;
+	for (Gene const& g : seq)
+		k++, (void)g;
+	ASSERT_EQUALS(71, k);
+}
+
+TEST(geneSequence, copyOnWrite) {
+	GeneSequence a = makeSequence(100);
+	GeneSequence const b = a;
+	for (unsigned k=0; k<a.getSegmentCount(); k++)
+		ASSERT_TRUE(a.sharesSegment(b, k));
+	int64_t resident = counter("genome-bytes-resident");
+	// modifying one gene only materializes its segment:
+	a[40].data.gene_synapse.from.set(-1);
+	ASSERT_EQUALS(-1, (int)a[40].data.gene_synapse.from);
+	ASSERT_EQUALS(40, (int)b[40].data.gene_synapse.from);
+	ASSERT_TRUE(a.sharesSegment(b, 0));
+	ASSERT_TRUE(!a.sharesSegment(b, 1));
+	ASSERT_TRUE(a.sharesSegment(b, 2));
+	ASSERT_TRUE(counter("genome-bytes-resident") - resident == (int64_t)(sizeof(Gene) * GeneSequence::SegmentLength));
+}
+
+TEST(geneSequence, appendSegmentAndCounters) {
+	int64_t logical0 = counter("genome-bytes-logical");
+	int64_t resident0 = counter("genome-bytes-resident");
+	{
+		GeneSequence a = makeSequence(40);
+		GeneSequence c;
+		c.appendSegment(a, 0);
+		c.appendSegment(a, 1);
+		ASSERT_EQUALS(40, (int)c.size());
+		ASSERT_TRUE(c.sharesSegment(a, 0) && c.sharesSegment(a, 1));
+		ASSERT_TRUE(counter("genome-bytes-logical") - logical0 == (int64_t)(80 * sizeof(Gene)));
+		ASSERT_TRUE(counter("genome-bytes-resident") - resident0 == (int64_t)(2 * GeneSequence::SegmentLength * sizeof(Gene)));
+		// appending to a shared tail segment materializes it:
+		c.push_back(GeneStop());
+		ASSERT_EQUALS(40, (int)a.size());
+		ASSERT_TRUE(!c.sharesSegment(a, 1));
+	}
+	ASSERT_TRUE(counter("genome-bytes-logical") == logical0);
+	ASSERT_TRUE(counter("genome-bytes-resident") == resident0);
+}
@@ -0,0 +1,148 @@
+/*
+ * genomeCodec-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/serialization/GenomeCodec.h"
+#include "../../bugs/serialization/BinaryStream.h"
+#include "../../bugs/serialization/ChromosomeSerialization.h"
+#include "../../bugs/genetics/MutationEngine.h"
+#include "../../bugs/entities/Bug.h"
+#include "../../bugs/utils/rand.h"
+
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+// a genome as seen after a few generations: both chromosomes mutated independently, with some genes inserted
+Genome makeGenome() {
+	randSeed(4321);
+	Genome genome = Bug::createBasicGenome();
+	for (int i=0; i<50; i++) {
+		MutationEngine::alterChromosome(genome.first);
+		MutationEngine::alterChromosome(genome.second);
+	}
+	return genome;
+}
+
+bool close(float a, float b, float relativeError) {
+	return a == b || std::abs(a - b) <= relativeError * std::max(std::abs(a), std::abs(b));
+}
+
+// counts the differences between the genes of two chromosomes (values and meta-genes)
+int countDifferences(Chromosome const& c1, Chromosome const& c2, float metaGeneError) {
+	if (c1.genes.size() != c2.genes.size())
+		return 1 + std::abs((int)c1.genes.size() - (int)c2.genes.size());
+	int diffs = 0;
+	for (size_t i=0; i<c1.genes.size(); i++) {
+		Gene g1 = c1.genes[i], g2 = c2.genes[i];
+		if (g1.type != g2.type) {
+			diffs++;
+			continue;
+		}
+		MetaGene *m1[Gene::MaxMetaGenes], *m2[Gene::MaxMetaGenes];
+		unsigned n = g1.getMetaGenes(m1);
+		g2.getMetaGenes(m2);
+		for (unsigned k=0; k<n; k++)
+			diffs += !close(m1[k]->value, m2[k]->value, metaGeneError) || m1[k]->dynamic_variation != m2[k]->dynamic_variation;
+		std::vector<float> values;
+		MutationEngine::forEachMutableAtom(g1, [&values] (auto const& atom) { values.push_back((float)atom.value); });
+		unsigned k = 0;
+		MutationEngine::forEachMutableAtom(g2, [&values, &k, &diffs] (auto const& atom) { diffs += values[k++] != (float)atom.value; });
+	}
+	diffs += c1.insertions.size() != c2.insertions.size();
+	for (size_t i=0; i<std::min(c1.insertions.size(), c2.insertions.size()); i++)
+		diffs += c1.insertions[i].index != c2.insertions[i].index || c1.insertions[i].age != c2.insertions[i].age;
+	return diffs;
+}
+
+} // namespace
+
+TEST(genomeCodec, roundTrip) {
+	Genome genome = makeGenome();
+	BinaryStream stream(1024);
+	GenomeCodec::encode(stream, genome);
+	BinaryStream legacy(1024);
+	legacy << genome.first << genome.second;
+	std::cout << "\n[genomeCodec] " << genome.first.genes.size() << " + " << genome.second.genes.size() << " genes: "
+			<< stream.getSize() << " bytes (original format: " << legacy.getSize() << " bytes)\n";
+	ASSERT_TRUE(stream.getSize() < legacy.getSize());
+
+	stream.seek(0);
+	Genome decoded;
+	GenomeCodec::decode(stream, decoded);
+	ASSERT_TRUE(stream.eof());
+	ASSERT_EQUALS(0, countDifferences(genome.first, decoded.first, 0));
+	ASSERT_EQUALS(0, countDifferences(genome.second, decoded.second, 0));
+}
+
+TEST(genomeCodec, quantizedMetaGenes) {
+	Genome genome = makeGenome();
+	for (unsigned bits : {24u, 16u}) {
+		GenomeCodec::Options options;
+		options.metaGeneBits = bits;
+		BinaryStream stream(1024);
+		GenomeCodec::encode(stream, genome, options);
+		std::cout << "\n[genomeCodec] " << bits << " bit meta-genes: " << stream.getSize() << " bytes\n";
+		stream.seek(0);
+		Genome decoded;
+		GenomeCodec::decode(stream, decoded);
+		float error = 1.f / (1 << (bits - 8 - 1));	// half a step of the mantissa that's kept
+		ASSERT_EQUALS(0, countDifferences(genome.first, decoded.first, error));
+		ASSERT_EQUALS(0, countDifferences(genome.second, decoded.second, error));
+		if (bits == 16) {
+			BinaryStream legacy(1024);
+			legacy << genome.first << genome.second;
+			ASSERT_TRUE(stream.getSize() * 2 < legacy.getSize());
+		}
+	}
+}
+
+TEST(genomeCodec, identicalChromosomes) {
+	// the second chromosome of a genome that has not been altered yet is a single edit:
+	Genome genome = Bug::createBasicGenome();
+	BinaryStream both(1024);
+	GenomeCodec::encode(both, genome);
+	genome.second = Chromosome();
+	BinaryStream firstOnly(1024);
+	GenomeCodec::encode(firstOnly, genome);
+	ASSERT_TRUE(both.getSize() <= firstOnly.getSize() + 4);
+}
+
+TEST(genomeCodec, readsOriginalFormat) {
+	Genome genome = makeGenome();
+	BinaryStream legacy(1024);
+	legacy << genome.first << genome.second;
+	legacy.seek(0);
+	Genome decoded;
+	GenomeCodec::decode(legacy, decoded);
+	ASSERT_TRUE(legacy.eof());
+	ASSERT_EQUALS((int)genome.first.genes.size(), (int)decoded.first.genes.size());
+	ASSERT_EQUALS((int)genome.second.genes.size(), (int)decoded.second.genes.size());
+	for (size_t i=0; i<genome.first.genes.size(); i++)
+		ASSERT_TRUE(genome.first.genes[i].type == decoded.first.genes[i].type);
+}
+
+TEST(genomeCodec, corruptData) {
+	Genome genome = makeGenome();
+	BinaryStream stream(1024);
+	GenomeCodec::encode(stream, genome);
+	// cut the data short:
+	std::vector<char> bytes((char*)stream.getBuffer(), (char*)stream.getBuffer() + stream.getSize() / 2);
+	BinaryStream truncated(bytes.data(), bytes.size());
+	Genome decoded;
+	bool thrown = false;
+	try {
+		GenomeCodec::decode(truncated, decoded);
+	} catch (std::runtime_error &e) {
+		thrown = true;
+	}
+	ASSERT_TRUE(thrown);
+}
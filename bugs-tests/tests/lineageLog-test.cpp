@@ -0,0 +1,151 @@
+/*
+ * lineageLog-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/session/LineageLog.h"
+#include "../../bugs/session/LineageReader.h"
+
+#include <algorithm>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+const char* logPath = "/tmp/lineageLog-test.log";
+
+bool contains(std::vector<uint64_t> const& v, uint64_t x) {
+	return std::find(v.begin(), v.end(), x) != v.end();
+}
+
+/*
+ * founders 1 and 2; 3 = (1,2), 4 = (1,2), 5 = (3,4), 6 = (5,2)
+ */
+void writeFamily(LineageLog &log) {
+	log.recordBirth(1, 0, 0, 1, 0x11);
+	log.recordBirth(2, 0, 0, 1, 0x22);
+	log.update(10);
+	log.recordEgg(1, 0.5f);
+	log.recordEgg(2, 0.5f);
+	log.recordBirth(3, 1, 2, 2, 0x33);
+	log.recordEgg(1, 0.5f);
+	log.recordEgg(2, 0.5f);
+	log.recordBirth(4, 1, 2, 2, 0x44);
+	log.update(10);
+	log.recordDeath(1, LineageLog::DeathCause::STARVATION, 19.f, 3.f);
+	log.recordEgg(3, 0.5f);
+	log.recordEgg(4, 0.5f);
+	log.recordBirth(5, 3, 4, 3, 0x55);
+	log.recordEgg(5, 0.5f);
+	log.recordEgg(2, 0.5f);
+	log.recordBirth(6, 5, 2, 4, 0x66);
+	log.recordDeath(6, LineageLog::DeathCause::NOT_VIABLE, 0, 1.f);
+}
+
+} // namespace
+
+TEST(lineageLog, roundTrip) {
+	{
+		LineageLog::Config config;
+		config.outputPath = logPath;
+		config.batchSize = 4;
+		LineageLog log(config);
+		writeFamily(log);
+		log.flush();
+		ASSERT_EQUALS(16, (int)log.getEventsWritten());
+	}
+	LineageReader reader;
+	ASSERT_TRUE(reader.load(logPath));
+	ASSERT_TRUE(!reader.isTruncated());
+	ASSERT_EQUALS(16, (int)reader.getEventCount());
+	ASSERT_EQUALS(6, (int)reader.getIndividualCount());
+
+	auto b1 = reader.find(1);
+	ASSERT_TRUE(b1 != nullptr);
+	ASSERT_TRUE(b1->dead);
+	ASSERT_EQUALS(2, (int)b1->eggsLaid);
+	ASSERT_EQUALS(2, (int)b1->children.size());
+	ASSERT_EQUALS_DELTA(20.f, b1->deathTime, 1.e-5f);
+
+	auto b6 = reader.find(6);
+	ASSERT_TRUE(b6 != nullptr && b6->birthRecorded);
+	ASSERT_EQUALS(4, (int)b6->generation);
+	ASSERT_TRUE(b6->genomeHash == 0x66);
+	ASSERT_TRUE(b6->deathCause == LineageLog::DeathCause::NOT_VIABLE);
+	ASSERT_TRUE(reader.find(7) == nullptr);
+
+	auto founders = reader.getFounders();
+	ASSERT_EQUALS(2, (int)founders.size());
+
+	auto ancestors = reader.getAncestors(6);
+	ASSERT_EQUALS(5, (int)ancestors.size());
+	ASSERT_TRUE(ancestors[0] == 5 || ancestors[0] == 2);
+	ASSERT_EQUALS(2, (int)reader.getAncestors(6, 1).size());
+
+	auto descendants = reader.getDescendants(3);
+	ASSERT_EQUALS(2, (int)descendants.size());
+	ASSERT_TRUE(contains(descendants, 5) && contains(descendants, 6));
+	ASSERT_EQUALS(4, (int)reader.getDescendants(2).size());
+
+	ASSERT_TRUE(reader.findCommonAncestor(3, 4) == 1 || reader.findCommonAncestor(3, 4) == 2);
+	ASSERT_TRUE(reader.findCommonAncestor(5, 6) == 5);
+	ASSERT_TRUE(reader.findCommonAncestor(1, 2) == 0);
+	std::remove(logPath);
+}
+
+TEST(lineageLog, concurrentRecording) {
+	const unsigned nThreads = 4, perThread = 5000;
+	{
+		LineageLog::Config config;
+		config.outputPath = logPath;
+		config.batchSize = 256;
+		LineageLog log(config);
+		std::vector<std::thread> threads;
+		for (unsigned t=0; t<nThreads; t++)
+			threads.push_back(std::thread([&log, t] {
+				for (unsigned i=0; i<perThread; i++)
+					log.recordEgg(t + 1, 1.f);
+			}));
+		for (auto &t : threads)
+			t.join();
+		// the destructor writes everything that's still pending
+	}
+	LineageReader reader;
+	ASSERT_TRUE(reader.load(logPath));
+	ASSERT_EQUALS((int)(nThreads * perThread), (int)reader.getEventCount());
+	for (unsigned t=0; t<nThreads; t++)
+		ASSERT_EQUALS((int)perThread, (int)reader.find(t + 1)->eggsLaid);
+	std::remove(logPath);
+}
+
+TEST(lineageLog, truncatedLog) {
+	{
+		LineageLog::Config config;
+		config.outputPath = logPath;
+		LineageLog log(config);
+		writeFamily(log);
+	}
+	// cut the last event in half, as if the simulation was killed while writing:
+	std::vector<char> data;
+	{
+		std::ifstream in(logPath, std::ios::binary);
+		data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+	{
+		std::ofstream out(logPath, std::ios::binary | std::ios::trunc);
+		out.write(data.data(), data.size() - 5);
+	}
+	LineageReader reader;
+	ASSERT_TRUE(reader.load(logPath));
+	ASSERT_TRUE(reader.isTruncated());
+	ASSERT_EQUALS(15, (int)reader.getEventCount());
+	ASSERT_TRUE(!reader.find(6)->dead);
+	std::remove(logPath);
+}
@@ -0,0 +1,229 @@
+/*
+ * mutationEngine-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+/*
+ * Checks that the events drawn in bulk by the MutationEngine happen with the same frequencies as in the gene-by-gene
+ * algorithm: each gene is deleted/swapped and each atom mutated with its own chance (scaled by the per-chromosome
+ * factors), a gene that swaps forward takes the next one out of the roll, and deleted genes are left untouched.
+ * The chromosome is made of synapse genes that carry their index in their "from" atom, so they can be followed.
+ */
+
+#include "../../bugs/genetics/MutationEngine.h"
+#include "../../bugs/utils/rand.h"
+#include "../../bugs/math/math3D.h"
+
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include <type_traits>
+#include <iostream>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+constexpr int nGenes = 40;
+constexpr int nRuns = 40000;
+constexpr int idScale = 1000;
+
+Chromosome makeChromosome() {
+	Chromosome c;
+	for (int i=0; i<nGenes; i++) {
+		GeneSynapse gs;
+		gs.from.set((i+1) * idScale);
+		gs.to.set((i+1) * idScale);
+		gs.weight.set(0);
+		gs.weight.chanceToMutate.value = 0.01f;		// the weight mutates more often than from/to
+		gs.from.chanceToMutate.value = 0.001f;
+		gs.to.chanceToMutate.value = 0.001f;
+		Gene g(gs);
+		g.chance_to_delete.value = i % 2 ? 0.005f : 0.02f;
+		g.chance_to_swap.value = 0.01f;
+		c.genes.push_back(g);
+	}
+	return c;
+}
+
+// returns the original index of the gene, or -1 if it's a new one
+int geneId(Gene const& g) {
+	if (g.type != gene_type::SYNAPSE && g.type != gene_type::NO_OP)
+		return -1;
+	int id = (int)std::lround((float)g.data.gene_synapse.from.value / idScale) - 1;
+	// spawned NO_OP genes carry leftover data; ours have the same id in "to":
+	if (id != (int)std::lround((float)g.data.gene_synapse.to.value / idScale) - 1)
+		return -1;
+	return id >= 0 && id < nGenes ? id : -1;
+}
+
+bool withinPoissonBounds(double observed, double expected) {
+	return std::abs(observed - expected) <= 5 * std::sqrt(expected) + 1;
+}
+
+/*
+ * the gene-by-gene algorithm that the MutationEngine replaced (GeneticOperations::alterChromosome before it),
+ * rolling rand() for every gene, atom and meta-gene; used as the baseline for the benchmark
+ */
+void legacyAlterChromosome(Chromosome &c) {
+	float totalMutate = 0, totalSwap = 0, totalDelete = 0;
+	GeneSequence const& genes = c.genes;
+	for (unsigned i=0; i<genes.size(); i++) {
+		float mutateCh, swapCh, deleteCh;
+		GeneticOperations::getAlterationChances(genes[i], mutateCh, swapCh, deleteCh);
+		totalMutate += mutateCh;
+		totalSwap += swapCh;
+		totalDelete += deleteCh;
+	}
+	float mutateFactor = std::min(1.f, 0.125f / totalMutate);
+	float swapFactor = std::min(1.f, 0.0625f / totalSwap);
+	float deleteFactor = std::min(1.f, 0.025f / totalDelete);
+	auto alterGene = [mutateFactor] (Gene &g) {
+		MutationEngine::forEachMutableAtom(g, [mutateFactor] (auto &atom) {
+			if (randf() < std::max(atom.chanceToMutate.value * mutateFactor, constants::global_alteration_override_chance)) {
+				if (std::is_integral<std::decay_t<decltype(atom.value)>>::value)
+					atom.value += (randf()<0.5f) ? +1 : -1;
+				else
+					atom.value += srandf() * atom.changeAmount.value;
+			}
+		});
+		MetaGene* metaGenes[Gene::MaxMetaGenes];
+		unsigned nMeta = g.getMetaGenes(metaGenes);
+		for (unsigned i=0; i<nMeta; i++)
+			metaGenes[i]->value = std::max(0.f, metaGenes[i]->value + srandf() * metaGenes[i]->dynamic_variation);
+	};
+	for (unsigned i=0; i<c.genes.size(); i++) {
+		if (randf() < c.genes[i].chance_to_delete.value * deleteFactor) {
+			c.genes[i].type = gene_type::NO_OP;
+			continue;
+		}
+		if (randf() < c.genes[i].chance_to_swap.value * swapFactor) {
+			if (i+1 < c.genes.size()) { // swap ahead
+				xchg(c.genes[i], c.genes[i+1]);
+				alterGene(c.genes[i]);
+				alterGene(c.genes[++i]);
+			} else if (i > 0) { // swap behind
+				xchg(c.genes[i], c.genes[i-1]);
+				alterGene(c.genes[i-1]);
+			} else
+				alterGene(c.genes[i]);
+		} else
+			alterGene(c.genes[i]);
+	}
+}
+
+} // namespace
+
+TEST(mutationEngine, eventDistribution) {
+	randSeed(1234);
+	Chromosome original = makeChromosome();
+
+	// the chances as scaled by GeneticOperations (at most 0.025 deletions, 0.0625 swaps, 0.125 mutations per chromosome):
+	double totalDel = 0, totalSwap = 0;
+	for (int i=0; i<nGenes; i++) {
+		totalDel += original.genes[i].chance_to_delete.value;
+		totalSwap += original.genes[i].chance_to_swap.value;
+	}
+	double pDel[nGenes], pSwap[nGenes];
+	for (int i=0; i<nGenes; i++) {
+		pDel[i] = original.genes[i].chance_to_delete.value * std::min(1.0, 0.025 / totalDel);
+		pSwap[i] = original.genes[i].chance_to_swap.value * std::min(1.0, 0.0625 / totalSwap);
+	}
+	double mutFactor = std::min(1.0, 0.125 / (nGenes * 0.012));
+	double pMutWeight = std::max(0.01 * mutFactor, (double)constants::global_alteration_override_chance);
+
+	// expected counts: a gene only gets its own roll if the previous one didn't swap forward with it
+	double expDelEven = 0, expDelOdd = 0, expSwaps = 0, expWeightMutations = 0;
+	double processed = 1;
+	for (int i=0; i<nGenes; i++) {
+		(i % 2 ? expDelOdd : expDelEven) += processed * pDel[i];
+		double swap = processed * (1 - pDel[i]) * pSwap[i];
+		expSwaps += swap;
+		// a gene consumed by a swap still gets mutated; only deleted genes don't:
+		expWeightMutations += (1 - processed * pDel[i]) * pMutWeight;
+		processed = 1 - swap;
+	}
+	expDelEven *= nRuns; expDelOdd *= nRuns; expSwaps *= nRuns; expWeightMutations *= nRuns;
+
+	int delEven = 0, delOdd = 0, swaps = 0, weightMutations = 0, newGenes = 0;
+	int deletedButAltered = 0, badSizes = 0;
+	double metaDriftSum = 0, metaDriftAbsSum = 0;
+	int metaDriftCount = 0;
+	for (int r=0; r<nRuns; r++) {
+		Chromosome c = original;
+		MutationEngine::Stats stats = MutationEngine::alterChromosome(c);
+		newGenes += stats.newGenes;
+		if (c.genes.size() != (size_t)nGenes + (c.insertions.empty() ? 0 : 1))
+			badSizes++;
+		std::vector<int> ids;
+		std::vector<Gene const*> genes;
+		for (size_t k=0; k<c.genes.size(); k++) {
+			int id = geneId(c.genes[k]);
+			if (id < 0)
+				continue;	// spawned gene
+			ids.push_back(id);
+			genes.push_back(&c.genes[k]);
+		}
+		for (size_t k=0; k<ids.size(); k++) {
+			Gene const& g = *genes[k];
+			Gene const& orig = original.genes[ids[k]];
+			if (k+1 < ids.size() && ids[k] == (int)k+1 && ids[k+1] == (int)k)
+				swaps++;
+			if (g.type == gene_type::NO_OP) {
+				(ids[k] % 2 ? delOdd : delEven)++;
+				if (g.chance_to_swap.value != orig.chance_to_swap.value)
+					deletedButAltered++;
+				continue;
+			}
+			if (g.data.gene_synapse.weight.value != orig.data.gene_synapse.weight.value)
+				weightMutations++;
+			float drift = g.chance_to_swap.value - orig.chance_to_swap.value;
+			metaDriftSum += drift;
+			metaDriftAbsSum += std::abs(drift);
+			metaDriftCount++;
+		}
+	}
+
+	std::cout << "\n[mutationEngine] " << nRuns << " runs on " << nGenes << " genes:"
+			<< "\n\tdeletions (even/odd genes): " << delEven << " / " << delOdd << "\texpected " << expDelEven << " / " << expDelOdd
+			<< "\n\tswaps: " << swaps << "\texpected " << expSwaps
+			<< "\n\tweight mutations: " << weightMutations << "\texpected " << expWeightMutations
+			<< "\n\tnew genes: " << newGenes << "\texpected " << nRuns * constants::global_chance_to_spawn_gene * nGenes << "\n";
+
+	ASSERT_TRUE(withinPoissonBounds(delEven, expDelEven));
+	ASSERT_TRUE(withinPoissonBounds(delOdd, expDelOdd));
+	ASSERT_TRUE(withinPoissonBounds(swaps, expSwaps));
+	ASSERT_TRUE(withinPoissonBounds(weightMutations, expWeightMutations));
+	ASSERT_TRUE(withinPoissonBounds(newGenes, nRuns * constants::global_chance_to_spawn_gene * nGenes));
+	ASSERT_EQUALS(0, deletedButAltered);
+	ASSERT_EQUALS(0, badSizes);
+	// meta-genes drift uniformly within +/- dynamic_variation:
+	ASSERT_EQUALS_DELTA(0.0, metaDriftSum / metaDriftCount, 1.e-5);
+	ASSERT_EQUALS_DELTA(constants::change_gene_swap / 2, metaDriftAbsSum / metaDriftCount, 1.e-5);
+}
+
+TEST(mutationEngine, benchmark) {
+	// a large chromosome, as seen after many generations:
+	Chromosome c;
+	Chromosome base = makeChromosome();
+	while (c.genes.size() < 20000)
+		for (unsigned i=0; i<base.genes.size(); i++)
+			c.genes.push_back(base.genes[i]);
+	Chromosome legacy = c;
+	constexpr int nAlterations = 200;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i=0; i<nAlterations; i++)
+		legacyAlterChromosome(legacy);
+	auto mid = std::chrono::high_resolution_clock::now();
+	for (int i=0; i<nAlterations; i++)
+		MutationEngine::alterChromosome(c);
+	auto end = std::chrono::high_resolution_clock::now();
+	float usLegacy = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count() / (float)nAlterations;
+	float us = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count() / (float)nAlterations;
+	std::cout << "\n[mutationEngine] " << c.genes.size() << " genes: " << usLegacy << " us/alteration gene-by-gene, "
+			<< us << " us/alteration with the engine\n";
+	ASSERT_TRUE(c.genes.size() >= 20000);
+}
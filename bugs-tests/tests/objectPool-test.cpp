@@ -0,0 +1,177 @@
+/*
+ * objectPool-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../utils/ObjectPool.h"
+
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <algorithm>
+#include <set>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+struct part {
+	static ObjectPool::Context sharedContext;
+	static void* operator new(size_t size) {
+		ObjectPool::Context* ctx = ObjectPool::getCurrentContext();
+		return ObjectPool::allocate(size, ctx ? *ctx : sharedContext);
+	}
+	static void operator delete(void* p, size_t size) { ObjectPool::free(p, size); }
+
+	float payload[20];
+};
+ObjectPool::Context part::sharedContext(ObjectPool::Policy::ReuseSlots);
+
+struct big {
+	static void* operator new(size_t size) { return ObjectPool::allocate(size, part::sharedContext); }
+	static void operator delete(void* p, size_t size) { ObjectPool::free(p, size); }
+
+	char payload[ObjectPool::MaxObjectSize + 1];
+};
+
+} // namespace
+
+TEST(objectPool, contextsAndReuse) {
+	ObjectPool::Stats before = ObjectPool::getStats();
+	std::vector<part*> bug1, bug2;
+	{
+		ObjectPool::Context ctx1, ctx2;
+		// two bugs developing at the same time, their parts interleaved in time:
+		for (int i=0; i<10; i++) {
+			{
+				ObjectPool::Scope scope(ctx1);
+				bug1.push_back(new part());
+			}
+			ObjectPool::Scope scope(ctx2);
+			bug2.push_back(new part());
+		}
+		// each bug's parts are contiguous:
+		for (int i=1; i<10; i++) {
+			ASSERT_EQUALS((int)sizeof(part), (int)((char*)bug1[i] - (char*)bug1[i-1]));
+			ASSERT_EQUALS((int)sizeof(part), (int)((char*)bug2[i] - (char*)bug2[i-1]));
+		}
+		ObjectPool::Stats s = ObjectPool::getStats();
+		ASSERT_EQUALS(20, (int)(s.liveObjects - before.liveObjects));
+		ASSERT_EQUALS(2, (int)(s.chunksInUse - before.chunksInUse));
+		ASSERT_TRUE(s.getFragmentation() > 0.8f);	// the chunks are mostly unused yet
+		// the contexts go away before their objects (the bugs are destroyed, the dead parts decay later)
+	}
+	for (part* p : bug1)
+		delete p;
+	ObjectPool::Stats s = ObjectPool::getStats();
+	ASSERT_EQUALS(1, (int)(s.chunksInUse - before.chunksInUse));
+	ASSERT_EQUALS(1, (int)(s.chunksFree - before.chunksFree));
+	for (part* p : bug2)
+		delete p;
+	s = ObjectPool::getStats();
+	ASSERT_EQUALS(0, (int)(s.chunksInUse - before.chunksInUse));
+	ASSERT_EQUALS(0, (int)(s.liveObjects - before.liveObjects));
+
+	// the next context reuses a free chunk:
+	ObjectPool::Context ctx3;
+	ObjectPool::Scope scope(ctx3);
+	part* p = new part();
+	ASSERT_EQUALS(2, (int)(ObjectPool::getStats().chunksFree + 1 - before.chunksFree));
+	delete p;
+}
+
+TEST(objectPool, fullChunksAndBigObjects) {
+	ObjectPool::Stats before = ObjectPool::getStats();
+	std::vector<part*> parts;
+	ObjectPool::Context ctx;
+	ObjectPool::Scope scope(ctx);
+	for (int i=0; i<1000; i++)
+		parts.push_back(new part());
+	ObjectPool::Stats s = ObjectPool::getStats();
+	int chunks = s.chunksInUse - before.chunksInUse;
+	ASSERT_TRUE(chunks >= 5 && chunks <= 6);	// ~200 per chunk
+	for (part* p : parts)
+		delete p;
+
+	big* b = new big();
+	s = ObjectPool::getStats();
+	ASSERT_EQUALS(1, (int)(s.heapObjects - before.heapObjects));
+	delete b;
+	ASSERT_EQUALS(0, (int)(ObjectPool::getStats().liveObjects - before.liveObjects));
+}
+
+TEST(objectPool, threads) {
+	ObjectPool::Stats before = ObjectPool::getStats();
+	std::vector<std::thread> threads;
+	std::vector<std::vector<part*>> parts(4);
+	for (unsigned t=0; t<parts.size(); t++)
+		threads.push_back(std::thread([t, &parts] {
+			ObjectPool::Context ctx;
+			ObjectPool::Scope scope(ctx);
+			for (int i=0; i<2000; i++)
+				parts[t].push_back(new part());
+			// and some of the shared context's:
+			ObjectPool::Scope none(part::sharedContext);
+			for (int i=0; i<2000; i++)
+				parts[t].push_back(new part());
+		}));
+	for (auto &t : threads)
+		t.join();
+	// freed on another thread, in a different order:
+	for (int i=3; i>=0; i--)
+		for (part* p : parts[i])
+			delete p;
+	ObjectPool::Stats s = ObjectPool::getStats();
+	ASSERT_EQUALS(0, (int)(s.liveObjects - before.liveObjects));
+	// the shared context keeps its chunks, with the slots on its free list:
+	ASSERT_EQUALS(8000, (int)(s.freeSlots - before.freeSlots));
+	ASSERT_TRUE(s.chunksInUse - before.chunksInUse <= 40 + 1);
+	std::vector<part*> again;
+	for (int i=0; i<8000; i++)
+		again.push_back(new part());
+	ASSERT_EQUALS((int)s.chunksInUse, (int)ObjectPool::getStats().chunksInUse);
+	for (part* p : again)
+		delete p;
+}
+
+TEST(objectPool, freeListsReuseSlots) {
+	ObjectPool::Stats before = ObjectPool::getStats();
+	{
+		ObjectPool::Context ctx(ObjectPool::Policy::ReuseSlots);
+		ObjectPool::Scope scope(ctx);
+		std::vector<part*> parts;
+		for (int i=0; i<1000; i++)
+			parts.push_back(new part());
+		int chunks = ObjectPool::getStats().chunksInUse - before.chunksInUse;
+		// free every other one, the new ones take their slots:
+		std::set<part*> freed;
+		for (int i=0; i<1000; i+=2) {
+			freed.insert(parts[i]);
+			delete parts[i];
+		}
+		ASSERT_EQUALS(500, (int)(ObjectPool::getStats().freeSlots - before.freeSlots));
+		for (int i=0; i<1000; i+=2) {
+			parts[i] = new part();
+			ASSERT_TRUE(freed.count(parts[i]) == 1);
+		}
+		ASSERT_EQUALS(0, (int)(ObjectPool::getStats().freeSlots - before.freeSlots));
+
+		// objects dying one by one, in random order: the chunks don't grow past what the live ones need
+		for (int i=0; i<20000; i++) {
+			unsigned k = (i * 7919u) % parts.size();
+			delete parts[k];
+			parts[k] = new part();
+		}
+		ASSERT_EQUALS(chunks, (int)(ObjectPool::getStats().chunksInUse - before.chunksInUse));
+		for (part* p : parts)
+			delete p;
+	}
+	// the context is gone, and so are its chunks and free lists:
+	ObjectPool::Stats s = ObjectPool::getStats();
+	ASSERT_EQUALS(0, (int)(s.chunksInUse - before.chunksInUse));
+	ASSERT_EQUALS(0, (int)(s.freeSlots - before.freeSlots));
+	ASSERT_EQUALS(0, (int)(s.liveObjects - before.liveObjects));
+}
@@ -0,0 +1,74 @@
+/*
+ * phenotypeCache-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/genetics/PhenotypeCache.h"
+#include "../../perf/counters.h"
+
+#include <easyunit/test.h>
+
+using namespace easyunit;
+
+namespace {
+
+Genome makeGenome() {
+	Genome g;
+	for (int i=0; i<40; i++) {
+		GeneSynapse s;
+		s.from.set(i);
+		s.to.set(i+1);
+		s.weight.set(0.25f * i);
+		s.priority.set(1.f);
+		g.first.genes.push_back(s);
+		g.second.genes.push_back(i % 2 ? Gene(GeneStop()) : Gene(s));
+	}
+	return g;
+}
+
+} // namespace
+
+TEST(phenotypeCache, keyIgnoresMetaGenes) {
+	Genome a = makeGenome();
+	Genome b = a;
+	b.first.genes[3].data.gene_synapse.weight.chanceToMutate.value = 0.9f;
+	b.second.genes[10].chance_to_delete.value = 0.5f;
+	ASSERT_TRUE(PhenotypeCache::makeKey(a) == PhenotypeCache::makeKey(b));
+	b.first.genes[3].data.gene_synapse.weight.value = -1.f;
+	ASSERT_TRUE(PhenotypeCache::makeKey(a) != PhenotypeCache::makeKey(b));
+	// the same genes split differently between the chromosomes are a different genome:
+	Genome c = a;
+	c.second.genes.push_back(GeneNoOp());
+	ASSERT_TRUE(PhenotypeCache::makeKey(a) != PhenotypeCache::makeKey(c));
+}
+
+TEST(phenotypeCache, findAndInsert) {
+	PhenotypeCache &cache = PhenotypeCache::get();
+	cache.clear();
+	int64_t hits = perf::Counters::get("phenotype-cache-hits").load();
+	int64_t misses = perf::Counters::get("phenotype-cache-misses").load();
+
+	PhenotypeCache::Key key = PhenotypeCache::makeKey(makeGenome());
+	ASSERT_TRUE(cache.find(key) == nullptr);
+	std::shared_ptr<Phenotype> ph = std::make_shared<Phenotype>();
+	ph->developmentSteps = 17;
+	cache.insert(key, ph);
+	std::shared_ptr<const Phenotype> found = cache.find(key);
+	ASSERT_TRUE(found == ph);
+	ASSERT_EQUALS(17, (int)found->developmentSteps);
+	ASSERT_TRUE(perf::Counters::get("phenotype-cache-hits").load() - hits == 1);
+	ASSERT_TRUE(perf::Counters::get("phenotype-cache-misses").load() - misses == 1);
+
+	// oldest entries are evicted when the capacity is exceeded:
+	PhenotypeCache::Key key2 = key;
+	key2.push_back(1);
+	cache.setCapacity(1);
+	cache.insert(key2, std::make_shared<Phenotype>());
+	ASSERT_EQUALS(1, (int)cache.size());
+	ASSERT_TRUE(cache.find(key) == nullptr);
+	ASSERT_TRUE(cache.find(key2) != nullptr);
+	cache.setCapacity(4096);
+	cache.clear();
+}
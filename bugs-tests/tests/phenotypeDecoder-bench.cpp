@@ -0,0 +1,51 @@
+/*
+ * phenotypeDecoder-bench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+/*
+ * Decodes the default genome (Bug::createBasicChromosome) many times on one thread and prints the average time
+ * per decoding.
+ */
+
+#include "../../bugs/genetics/PhenotypeDecoder.h"
+#include "../../bugs/entities/Bug.h"
+
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+constexpr unsigned nDecodes = 5000;
+
+template<class F>
+float timeMicroseconds(F f) {
+	auto start = std::chrono::high_resolution_clock::now();
+	f();
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() * 1.e-3f;
+}
+
+} // namespace
+
+TEST(phenotypeDecoder, benchmark) {
+	Genome genome = Bug::createBasicGenome();
+	size_t checksum = 0;
+	float us = timeMicroseconds([&] {
+		for (unsigned i=0; i<nDecodes; i++) {
+			Phenotype ph = PhenotypeDecoder::decode(genome);
+			checksum += ph.parts.size() + ph.synapses.size();
+		}
+	});
+	Phenotype ph = PhenotypeDecoder::decode(genome);
+	std::cout << "\n[phenotypeDecoder] default genome (" << genome.first.genes.size() << " genes/chromosome, "
+			<< ph.parts.size() << " parts, " << ph.neurons.size() << " neurons, " << ph.synapses.size() << " synapses):\n"
+			<< "\t" << nDecodes << " decodes:\t" << us / nDecodes << " us/decode\n";
+	ASSERT_EQUALS((int)(nDecodes * (ph.parts.size() + ph.synapses.size())), (int)checksum);
+}
@@ -0,0 +1,70 @@
+/*
+ * phenotypeDecoder-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/genetics/PhenotypeDecoder.h"
+#include "../../bugs/entities/Bug.h"
+
+#include <easyunit/test.h>
+
+using namespace easyunit;
+
+namespace {
+
+int countParts(Phenotype const& ph, BodyPartType type) {
+	int n = 0;
+	for (auto &p : ph.parts)
+		n += p.type == type;
+	return n;
+}
+
+} // namespace
+
+TEST(phenotypeDecoder, basicGenome) {
+	Phenotype ph = PhenotypeDecoder::decode(Bug::createBasicGenome());
+	ASSERT_TRUE(ph.viable);
+	ASSERT_TRUE(ph.developmentSteps > 0);
+	ASSERT_TRUE(ph.parts.size() > 1);
+	ASSERT_TRUE(ph.parts[0].type == BodyPartType::TORSO);
+	ASSERT_EQUALS(-1, ph.parts[0].parentIndex);
+	ASSERT_TRUE(countParts(ph, BodyPartType::MOUTH) > 0);
+	ASSERT_TRUE(countParts(ph, BodyPartType::EGGLAYER) > 0);
+	for (unsigned i=1; i<ph.parts.size(); i++) {
+		auto &p = ph.parts[i];
+		ASSERT_TRUE(p.parentIndex >= 0 && p.parentIndex < (int)i);
+		ASSERT_EQUALS(ph.parts[p.parentIndex].depth + 1, p.depth);
+		// bones and grippers are always attached through a joint:
+		if (p.type == BodyPartType::BONE || p.type == BodyPartType::GRIPPER)
+			ASSERT_TRUE(ph.parts[p.parentIndex].type == BodyPartType::JOINT);
+		for (auto &a : p.attributes)
+			ASSERT_TRUE(a.index < PhenotypeDecoder::getAttributeSlotCount(p.type, a.attribute));
+	}
+	ASSERT_TRUE(ph.neuronCount > 0 && ph.neuronCount <= ph.neurons.size());
+	ASSERT_TRUE(!ph.synapses.empty());
+}
+
+TEST(phenotypeDecoder, deterministic) {
+	Genome g = Bug::createBasicGenome();
+	Phenotype a = PhenotypeDecoder::decode(g);
+	// meta-genes don't affect the phenotype:
+	g.first.genes[0].chance_to_delete.value = 0.75f;
+	Phenotype b = PhenotypeDecoder::decode(g);
+	ASSERT_EQUALS((int)a.developmentSteps, (int)b.developmentSteps);
+	ASSERT_EQUALS((int)a.parts.size(), (int)b.parts.size());
+	for (unsigned i=0; i<a.parts.size(); i++) {
+		ASSERT_TRUE(a.parts[i].type == b.parts[i].type);
+		ASSERT_EQUALS(a.parts[i].parentIndex, b.parts[i].parentIndex);
+		ASSERT_EQUALS((int)a.parts[i].attributes.size(), (int)b.parts[i].attributes.size());
+	}
+	ASSERT_EQUALS((int)a.synapses.size(), (int)b.synapses.size());
+}
+
+TEST(phenotypeDecoder, emptyGenomeNotViable) {
+	Phenotype ph = PhenotypeDecoder::decode(Genome());
+	ASSERT_TRUE(!ph.viable);
+	ASSERT_EQUALS(1, (int)ph.parts.size());
+	ASSERT_EQUALS(1, (int)ph.developmentSteps);
+}
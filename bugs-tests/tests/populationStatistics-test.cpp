@@ -0,0 +1,71 @@
+/*
+ * populationStatistics-test.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "../../bugs/genetics/PopulationStatistics.h"
+#include "../../bugs/entities/Bug.h"
+#include "../../bugs/utils/ThreadPool.h"
+
+#include <sstream>
+#include <algorithm>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+TEST(populationStatistics, identicalPopulation) {
+	ThreadPool pool(4);
+	PopulationStatistics::Snapshot s;
+	for (int i=0; i<4; i++)
+		s.genomes.push_back(Bug::createBasicGenome());
+	s.gametes.push_back(Bug::getBasicChromosome());
+	PopulationStatistics::Report r = PopulationStatistics::analyze(s, 100, pool);
+	pool.stop();
+
+	int length = Bug::getBasicChromosome().genes.size();
+	ASSERT_EQUALS(9, (int)r.chromosomes);
+	ASSERT_EQUALS(length, (int)r.lengthMin);
+	ASSERT_EQUALS(length, (int)r.lengthMax);
+	ASSERT_EQUALS(0.f, r.alleleDiversity);
+	ASSERT_EQUALS(1.f, r.allelesPerLocus);
+	ASSERT_EQUALS(6, (int)r.distanceSamples);	// all the pairs of 4 bugs
+	ASSERT_EQUALS(0.f, r.distanceMax);
+	float sum = 0;
+	for (float f : r.geneTypeFrequency)
+		sum += f;
+	ASSERT_EQUALS_DELTA(1.f, sum, 1.e-5f);
+	ASSERT_TRUE(r.geneTypeFrequency[(int)gene_type::SYNAPSE] > 0);
+}
+
+TEST(populationStatistics, divergentPopulation) {
+	ThreadPool pool(4);
+	PopulationStatistics::Snapshot s;
+	Genome a = Bug::createBasicGenome();
+	Genome b = a;
+	b.first.genes[0] = Gene(GeneNoOp());
+	b.second.genes[0] = Gene(GeneNoOp());
+	b.second.genes.push_back(Gene(GeneStop()));
+	s.genomes.push_back(a);
+	s.genomes.push_back(b);
+	PopulationStatistics::Report r = PopulationStatistics::analyze(s, 100, pool);
+	pool.stop();
+
+	float length = a.first.genes.size();
+	ASSERT_EQUALS((int)length + 1, (int)r.lengthMax);
+	// locus 0 has two alleles, two chromosomes each: 4/3 * (1 - 2 * 0.5^2) = 2/3;
+	// the extra locus has a single chromosome, so it doesn't count:
+	ASSERT_EQUALS_DELTA(2.f / 3 / length, r.alleleDiversity, 1.e-6f);
+	ASSERT_EQUALS_DELTA(1 + 1.f / length, r.allelesPerLocus, 1.e-6f);
+	ASSERT_EQUALS(1, (int)r.distanceSamples);
+	ASSERT_EQUALS_DELTA(0.5f * (1 / length + 2 / (length + 1)), r.distanceMean, 1.e-6f);
+
+	std::stringstream csv;
+	PopulationStatistics::writeCSVHeader(csv);
+	PopulationStatistics::writeCSVRow(csv, r);
+	std::string header, row;
+	std::getline(csv, header);
+	std::getline(csv, row);
+	ASSERT_EQUALS(std::count(header.begin(), header.end(), ','), std::count(row.begin(), row.end(), ','));
+}
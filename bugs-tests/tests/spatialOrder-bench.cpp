@@ -0,0 +1,159 @@
+/*
+ * spatialOrder-bench.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+/*
+ * Measures World::update before and after the world sorts its update list along the Z-order curve
+ * (World::sortUpdateListSpatially, every 30 frames). The entities are probes that do what a typical sensor does: they
+ * look for the food chunks around them with World::getEntitiesInBox, through the world's SpatialCache. The food chunks
+ * are real FoodChunks kept as food particles, so no physics is needed. Run under "perf stat -e cache-misses" to get
+ * hardware cache miss counts.
+ */
+
+#include "../../math/morton.h"
+#include "../../bugs/utils/ThreadPool.h"
+#include "../../bugs/utils/parallel.h"
+#include "../../bugs/World.h"
+#include "../../bugs/entities/enttypes.h"
+#include "../../bugs/entities/food/FoodChunk.h"
+
+#include <Box2D/Box2D.h>
+
+#include <vector>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+#include <easyunit/test.h>
+using namespace easyunit;
+
+namespace {
+
+constexpr float worldSize = 500.f;	// meters
+constexpr float queryRadius = 5.f;
+constexpr unsigned nProbes = 20000;
+constexpr unsigned nFoodChunks = 20000;
+constexpr unsigned nThreads = 4;
+constexpr int spatialSortPeriod = 30;	// as in World.cpp
+
+// looks for the food chunks around it every frame, like a sensor
+class probe : public Entity {
+public:
+	probe(glm::vec2 pos) : pos_(pos) {}
+
+	FunctionalityFlags getFunctionalityFlags() const override { return FunctionalityFlags::UPDATABLE; }
+	glm::vec3 getWorldTransform() const override { return glm::vec3(pos_, 0); }
+	EntityType getEntityType() const override { return EntityType::FOOD_DISPENSER; }
+	aabb getAABB() const override { return aabb(pos_ - glm::vec2(0.5f), pos_ + glm::vec2(0.5f)); }
+
+	void update(float dt) override {
+		found_.clear();
+		getWorld()->getEntitiesInBox(found_, EntityType::FOOD_CHUNK, FunctionalityFlags::NONE, pos_, queryRadius, true);
+		nFound_ += found_.size();
+	}
+
+	uint64_t nFound_ = 0;
+
+private:
+	glm::vec2 pos_;
+	std::vector<Entity*> found_;
+};
+
+// updates the world [nFrames] times; returns the time per frame in ms
+float timeUpdates(World &world, int nFrames) {
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int f=0; f<nFrames; f++)
+		world.update(0.02f);
+	auto end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() * 1.e-3f / nFrames;
+}
+
+uint64_t totalFound(std::vector<probe*> const& probes) {
+	uint64_t total = 0;
+	for (probe* p : probes)
+		total += p->nFound_;
+	return total;
+}
+
+} // namespace
+
+TEST(spatialOrder, morton) {
+	for (uint16_t x : {0, 1, 7, 300, 65535})
+		for (uint16_t y : {0, 2, 9, 1000, 65535}) {
+			uint16_t dx, dy;
+			mortonDecode(mortonEncode(x, y), dx, dy);
+			ASSERT_EQUALS((int)x, (int)dx);
+			ASSERT_EQUALS((int)y, (int)dy);
+		}
+	ASSERT_TRUE(mortonEncode((uint16_t)1, (uint16_t)0) == 1u);
+	ASSERT_TRUE(mortonEncode((uint16_t)0, (uint16_t)1) == 2u);
+	ASSERT_TRUE(mortonEncode((uint16_t)3, (uint16_t)3) == 15u);
+	// out of range points are clamped:
+	ASSERT_TRUE(mortonEncode(-10.f, -10.f, 0, 1, 0, 1) == 0u);
+	ASSERT_TRUE(mortonEncode(10.f, 10.f, 0, 1, 0, 1) == 0xffffffffu);
+}
+
+TEST(spatialOrder, parallelForCoherentCoversRange) {
+	ThreadPool pool(nThreads);
+	for (unsigned n : {1u, 3u, 15u, 16u, 17u, 1000u}) {
+		std::vector<std::atomic<int>> hits(n);
+		for (auto &h : hits)
+			h = 0;
+		parallel_for_coherent(hits.begin(), hits.end(), pool, [] (std::atomic<int> &h) {
+			h++;
+		});
+		for (auto &h : hits)
+			ASSERT_EQUALS(1, h.load());
+	}
+	pool.stop();
+}
+
+TEST(spatialOrder, benchmark) {
+	b2World phys(b2Vec2(0, 0));
+	World world;
+	world.setPhysics(&phys);
+	world.setBounds(-worldSize/2, worldSize/2, worldSize/2, -worldSize/2);
+	world.getFoodParticles().setEnabled(true);
+
+	// probes and food chunks at random positions, in random order:
+	std::mt19937 rng(1234);
+	std::uniform_real_distribution<float> dist(-worldSize/2, worldSize/2);
+	std::vector<bool> isProbe(nProbes + nFoodChunks, false);
+	std::fill(isProbe.begin(), isProbe.begin() + nProbes, true);
+	std::shuffle(isProbe.begin(), isProbe.end(), rng);
+	std::vector<probe*> probes;
+	for (bool p : isProbe) {
+		glm::vec2 pos(dist(rng), dist(rng));
+		if (p) {
+			probes.push_back(new probe(pos));
+			world.takeOwnershipOf(std::unique_ptr<Entity>(probes.back()));
+		} else
+			world.takeOwnershipOf(std::unique_ptr<Entity>(new FoodChunk(&world, pos, 0, glm::vec2(0), 0, 15.e-3f)));
+	}
+
+	// frame 1 takes the entities over and turns the chunks into particles, which are queryable from frame 2 on:
+	world.update(0.02f);
+	uint64_t foundBefore = totalFound(probes);
+	// frames 2 .. 29 run in insertion order:
+	const int nFrames = spatialSortPeriod - 2;
+	float msInsertion = timeUpdates(world, nFrames);
+	uint64_t foundInsertion = totalFound(probes) - foundBefore;
+	// frame 30 sorts the update list; time the frames after it:
+	world.update(0.02f);
+	foundBefore = totalFound(probes);
+	float msZOrder = timeUpdates(world, nFrames);
+	uint64_t foundZOrder = totalFound(probes) - foundBefore;
+
+	std::cout << "\n[spatialOrder] World::update with " << nProbes << " probes and " << nFoodChunks << " food chunks:\n"
+			<< "\tinsertion order:\t" << msInsertion << " ms/frame\n"
+			<< "\tZ-order:\t\t" << msZOrder << " ms/frame\n";
+
+	// the order must not change the results:
+	ASSERT_TRUE(foundInsertion > 0);
+	ASSERT_TRUE(foundInsertion == foundZOrder);
+}
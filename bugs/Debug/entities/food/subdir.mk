@@ -5,15 +5,21 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../entities/food/FoodChunk.cpp \
-../entities/food/FoodDispenser.cpp 
+../entities/food/FoodChunkPool.cpp \
+../entities/food/FoodDispenser.cpp \
+../entities/food/FoodParticles.cpp 
 
 OBJS += \
 ./entities/food/FoodChunk.o \
-./entities/food/FoodDispenser.o 
+./entities/food/FoodChunkPool.o \
+./entities/food/FoodDispenser.o \
+./entities/food/FoodParticles.o 
 
 CPP_DEPS += \
 ./entities/food/FoodChunk.d \
-./entities/food/FoodDispenser.d 
+./entities/food/FoodChunkPool.d \
+./entities/food/FoodDispenser.d \
+./entities/food/FoodParticles.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
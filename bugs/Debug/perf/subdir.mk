@@ -6,16 +6,19 @@
 CPP_SRCS += \
 ../perf/callGraph.cpp \
 ../perf/frameCapture.cpp \
+../perf/mallocCounter.cpp \
 ../perf/results.cpp 
 
 OBJS += \
 ./perf/callGraph.o \
 ./perf/frameCapture.o \
+./perf/mallocCounter.o \
 ./perf/results.o 
 
 CPP_DEPS += \
 ./perf/callGraph.d \
 ./perf/frameCapture.d \
+./perf/mallocCounter.d \
 ./perf/results.d 
 
 
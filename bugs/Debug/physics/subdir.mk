@@ -7,19 +7,22 @@ CPP_SRCS += \
 ../physics/PhysContactListener.cpp \
 ../physics/PhysDestroyListener.cpp \
 ../physics/PhysicsBody.cpp \
-../physics/PhysicsDebugDraw.cpp 
+../physics/PhysicsDebugDraw.cpp \
+../physics/SleepManager.cpp 
 
 OBJS += \
 ./physics/PhysContactListener.o \
 ./physics/PhysDestroyListener.o \
 ./physics/PhysicsBody.o \
-./physics/PhysicsDebugDraw.o 
+./physics/PhysicsDebugDraw.o \
+./physics/SleepManager.o 
 
 CPP_DEPS += \
 ./physics/PhysContactListener.d \
 ./physics/PhysDestroyListener.d \
 ./physics/PhysicsBody.d \
-./physics/PhysicsDebugDraw.d 
+./physics/PhysicsDebugDraw.d \
+./physics/SleepManager.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
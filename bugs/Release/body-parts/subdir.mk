@@ -5,9 +5,11 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../body-parts/BodyPart.cpp \
+../body-parts/BodyPartArena.cpp \
 ../body-parts/Bone.cpp \
 ../body-parts/EggLayer.cpp \
 ../body-parts/Gripper.cpp \
+../body-parts/GrowthCommitBatcher.cpp \
 ../body-parts/Joint.cpp \
 ../body-parts/Mouth.cpp \
 ../body-parts/Muscle.cpp \
@@ -16,9 +18,11 @@ CPP_SRCS += \
 
 OBJS += \
 ./body-parts/BodyPart.o \
+./body-parts/BodyPartArena.o \
 ./body-parts/Bone.o \
 ./body-parts/EggLayer.o \
 ./body-parts/Gripper.o \
+./body-parts/GrowthCommitBatcher.o \
 ./body-parts/Joint.o \
 ./body-parts/Mouth.o \
 ./body-parts/Muscle.o \
@@ -27,9 +31,11 @@ OBJS += \
 
 CPP_DEPS += \
 ./body-parts/BodyPart.d \
+./body-parts/BodyPartArena.d \
 ./body-parts/Bone.d \
 ./body-parts/EggLayer.d \
 ./body-parts/Gripper.d \
+./body-parts/GrowthCommitBatcher.d \
 ./body-parts/Joint.d \
 ./body-parts/Mouth.d \
 ./body-parts/Muscle.d \
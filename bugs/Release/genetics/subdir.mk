@@ -5,17 +5,32 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../genetics/Gene.cpp \
+../genetics/GeneSequence.cpp \
 ../genetics/Genome.cpp \
+../genetics/MutationEngine.cpp \
+../genetics/PhenotypeCache.cpp \
+../genetics/PhenotypeDecoder.cpp \
+../genetics/PopulationStatistics.cpp \
 ../genetics/Ribosome.cpp 
 
 OBJS += \
 ./genetics/Gene.o \
+./genetics/GeneSequence.o \
 ./genetics/Genome.o \
+./genetics/MutationEngine.o \
+./genetics/PhenotypeCache.o \
+./genetics/PhenotypeDecoder.o \
+./genetics/PopulationStatistics.o \
 ./genetics/Ribosome.o 
 
 CPP_DEPS += \
 ./genetics/Gene.d \
+./genetics/GeneSequence.d \
 ./genetics/Genome.d \
+./genetics/MutationEngine.d \
+./genetics/PhenotypeCache.d \
+./genetics/PhenotypeDecoder.d \
+./genetics/PopulationStatistics.d \
 ./genetics/Ribosome.d 
 
 
@@ -8,6 +8,7 @@ CPP_SRCS += \
 ../serialization/BinaryStream.cpp \
 ../serialization/ChromosomeSerialization.cpp \
 ../serialization/GeneSerialization.cpp \
+../serialization/GenomeCodec.cpp \
 ../serialization/GenomeSerialization.cpp \
 ../serialization/Serializer.cpp 
 
@@ -16,6 +17,7 @@ OBJS += \
 ./serialization/BinaryStream.o \
 ./serialization/ChromosomeSerialization.o \
 ./serialization/GeneSerialization.o \
+./serialization/GenomeCodec.o \
 ./serialization/GenomeSerialization.o \
 ./serialization/Serializer.o 
 
@@ -24,6 +26,7 @@ CPP_DEPS += \
 ./serialization/BinaryStream.d \
 ./serialization/ChromosomeSerialization.d \
 ./serialization/GeneSerialization.d \
+./serialization/GenomeCodec.d \
 ./serialization/GenomeSerialization.d \
 ./serialization/Serializer.d 
 
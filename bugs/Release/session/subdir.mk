@@ -4,14 +4,26 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../session/IslandMigration.cpp \
+../session/LineageLog.cpp \
+../session/LineageReader.cpp \
+../session/PopulationAnalytics.cpp \
 ../session/PopulationManager.cpp \
 ../session/SessionManager.cpp 
 
 OBJS += \
+./session/IslandMigration.o \
+./session/LineageLog.o \
+./session/LineageReader.o \
+./session/PopulationAnalytics.o \
 ./session/PopulationManager.o \
 ./session/SessionManager.o 
 
 CPP_DEPS += \
+./session/IslandMigration.d \
+./session/LineageLog.d \
+./session/LineageReader.d \
+./session/PopulationAnalytics.d \
 ./session/PopulationManager.d \
 ./session/SessionManager.d 
 
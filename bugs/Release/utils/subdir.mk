@@ -4,18 +4,24 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../utils/FrameArena.cpp \
+../utils/ObjectPool.cpp \
 ../utils/ThreadPool.cpp \
 ../utils/UpdateList.cpp \
 ../utils/log.cpp \
 ../utils/rand.cpp 
 
 OBJS += \
+./utils/FrameArena.o \
+./utils/ObjectPool.o \
 ./utils/ThreadPool.o \
 ./utils/UpdateList.o \
 ./utils/log.o \
 ./utils/rand.o 
 
 CPP_DEPS += \
+./utils/FrameArena.d \
+./utils/ObjectPool.d \
 ./utils/ThreadPool.d \
 ./utils/UpdateList.d \
 ./utils/log.d \
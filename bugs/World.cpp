@@ -8,8 +8,11 @@
 #include "World.h"
 #include "entities/Entity.h"
 #include "physics/PhysicsBody.h"
+#include "entities/Bug.h"
+#include "entities/food/FoodChunk.h"
 #include "math/math3D.h"
 #include "math/box2glm.h"
+#include "math/morton.h"
 #include "Infrastructure.h"
 #include "renderOpenGL/Shape3D.h"
 
@@ -19,6 +22,8 @@
 #include "utils/log.h"
 
 #include "../perf/marker.h"
+#include "../perf/counters.h"
+#include "../perf/mallocCounter.h"
 
 #include <glm/glm.hpp>
 #include <Box2D/Box2D.h>
@@ -30,7 +35,11 @@
 
 #define MT_UPDATE	// enables parallel update on entities, using the thread pool
 
-static World *instance = nullptr;
+// every this many frames the update list is sorted along a Z-order curve, so that each parallel job
+// works on a compact region of the world (fewer cache misses, less contention on SpatialCache cells)
+static constexpr int spatialSortPeriod = 30;
+// every this many frames the idle bodies far from the bugs are put to sleep (and woken when the bugs come close)
+static constexpr int sleepUpdatePeriod = 10;
 
 World::World()
 	: physWld(nullptr)
@@ -39,8 +48,6 @@ World::World()
 	, entsToTakeOver(1024)
 	, deferredActions_(4096)
 {
-	assert(instance == nullptr && "attempting to initialize multiple instances of World!!!");
-	instance = this;
 #ifdef DEBUG
 	ownerThreadId_ = std::this_thread::get_id();
 #endif
@@ -53,11 +60,6 @@ void World::setPhysics(b2World* phys) {
 	groundBody = physWld->CreateBody(&gdef);
 }
 
-World* World::getInstance() {
-	assert(instance && "No existing World instance!!!");
-	return instance;
-}
-
 World::~World() {
 	reset();
 }
@@ -69,6 +71,8 @@ void World::setBounds(float left, float right, float top, float bottom) {
 	extentYn_ = bottom;
 	// reconfigure cache:
 	spatialCache_ = SpatialCache(left, right, top, bottom);
+	foodParticles_.setBounds(aabb({left, bottom}, {right, top}));
+	sleepManager_.setBounds(aabb({left, bottom}, {right, top}));
 }
 
 void World::reset() {
@@ -87,11 +91,11 @@ void World::reset() {
 	entsToUpdate.clear();
 }
 
-void World::getFixtures(std::vector<b2Fixture*> &out, const b2AABB& aabb) {
+void World::getFixtures(FrameVector<b2Fixture*> &out, const b2AABB& aabb) {
 	PERF_MARKER_FUNC;
 	class cbWrap : public b2QueryCallback {
 	public:
-		cbWrap(std::vector<b2Fixture*> &fixtures) : fixtures_(fixtures) {}
+		cbWrap(FrameVector<b2Fixture*> &fixtures) : fixtures_(fixtures) {}
 		/// b2QueryCallback::
 		/// Called for each fixture found in the query AABB.
 		/// @return false to terminate the query.
@@ -100,7 +104,7 @@ void World::getFixtures(std::vector<b2Fixture*> &out, const b2AABB& aabb) {
 			return true;
 		}
 
-		std::vector<b2Fixture*> &fixtures_;
+		FrameVector<b2Fixture*> &fixtures_;
 	} wrap(out);
 	physWld->QueryAABB(&wrap, aabb);
 }
@@ -110,8 +114,7 @@ b2Body* World::getBodyAtPos(glm::vec2 const& pos) {
 	b2AABB aabb;
 	aabb.lowerBound = g2b(pos) - b2Vec2(0.005f, 0.005f);
 	aabb.upperBound = g2b(pos) + b2Vec2(0.005f, 0.005f);
-	static thread_local std::vector<b2Fixture*> b2QueryResult;
-	b2QueryResult.clear();
+	FrameVector<b2Fixture*> b2QueryResult;
 	getFixtures(b2QueryResult, aabb);
 	if (b2QueryResult.empty())
 		return nullptr;
@@ -126,13 +129,12 @@ b2Body* World::getBodyAtPos(glm::vec2 const& pos) {
 	return ret;
 }
 
-void World::getBodiesInArea(glm::vec2 const& pos, float radius, bool clipToCircle, std::vector<b2Body*> &outBodies) {
+void World::getBodiesInArea(glm::vec2 const& pos, float radius, bool clipToCircle, FrameVector<b2Body*> &outBodies) {
 	PERF_MARKER_FUNC;
 	b2AABB aabb;
 	aabb.lowerBound = g2b(pos) - b2Vec2(radius, radius);
 	aabb.upperBound = g2b(pos) + b2Vec2(radius, radius);
-	static thread_local std::vector<b2Fixture*> b2QueryResult;
-	b2QueryResult.clear();
+	FrameVector<b2Fixture*> b2QueryResult;
 	getFixtures(b2QueryResult, aabb);
 	for (b2Fixture* f : b2QueryResult) {
 		if (clipToCircle) {
@@ -146,6 +148,8 @@ void World::getBodiesInArea(glm::vec2 const& pos, float radius, bool clipToCircl
 
 void World::takeOwnershipOf(std::unique_ptr<Entity> &&e) {
 	assertDbg(e != nullptr);
+	assertDbg((e->world_ == nullptr || e->world_ == this) && "entity belongs to another world");
+	e->world_ = this;
 	e->managed_ = true;
 	entsToTakeOver.push_back(std::move(e));
 }
@@ -213,6 +217,9 @@ void World::takeOverPending() {
 
 void World::update(float dt) {
 	PERF_MARKER_FUNC;
+	static auto &updateMallocs = perf::Counters::get("world-update-mallocs");
+	static auto &updates = perf::Counters::get("world-updates");
+	int64_t mallocsBefore = perf::getMallocCount();
 	++frameNumber_;
 
 	// delete pending entities:
@@ -221,11 +228,20 @@ void World::update(float dt) {
 	// take over pending entities:
 	takeOverPending();
 
+	if (frameNumber_ % spatialSortPeriod == 0)
+		sortUpdateListSpatially();
+
+	if (frameNumber_ % sleepUpdatePeriod == 0 && physWld)
+		updateSleep();
+
+	// move the food particles before anyone looks for them:
+	foodParticles_.update(dt);
+
 	// do the actual update on entities:
 	do {
 	PERF_MARKER("entities-update");
 #ifdef MT_UPDATE
-	parallel_for(
+	parallel_for_coherent(
 #else
 	std::for_each(
 #endif
@@ -245,11 +261,44 @@ void World::update(float dt) {
 		for (auto &a : deferredActions_)
 			a();
 		deferredActions_.clear();
+		growthCommitBatcher_.flush();
 		executingDeferredActions_.store(false, std::memory_order_release);
 	}
+
+	// everything transient from this frame (query results, deferred actions) is gone now:
+	FrameArena::nextFrame();
+
+	// heap allocations made by all the threads during the update:
+	updateMallocs += perf::getMallocCount() - mallocsBefore;
+	updates++;
+}
+
+void World::sortUpdateListSpatially() {
+	PERF_MARKER_FUNC;
+	spatialSortBuffer_.clear();
+	spatialSortBuffer_.reserve(entsToUpdate.size());
+	for (Entity* e : entsToUpdate) {
+		glm::vec2 pos = e->getPosition();
+		spatialSortBuffer_.push_back(std::make_pair(mortonEncode(pos.x, pos.y, extentXn_, extentXp_, extentYn_, extentYp_), e));
+	}
+	// stable sort keeps the insertion order for entities that fall in the same spot
+	std::stable_sort(spatialSortBuffer_.begin(), spatialSortBuffer_.end(), [] (auto const& a, auto const& b) {
+		return a.first < b.first;
+	});
+	for (unsigned i=0; i<spatialSortBuffer_.size(); i++)
+		entsToUpdate[i] = spatialSortBuffer_[i].second;
 }
 
-void World::queueDeferredAction(std::function<void()> &&fun) {
+void World::updateSleep() {
+	PERF_MARKER_FUNC;
+	sleepManager_.clearActiveAreas();
+	for (Entity* e : entsToUpdate)
+		if (e->getEntityType() == EntityType::BUG && static_cast<Bug*>(e)->isAlive())
+			sleepManager_.addActiveArea(e->getAABB());
+	sleepManager_.update(physWld);
+}
+
+void World::queueDeferredAction(DeferredAction &&fun) {
 	if (executingDeferredActions_)
 		fun();
 	else
@@ -294,8 +343,7 @@ void World::getEntitiesInBox(std::vector<Entity*> &out, EntityType filterTypes,
 	spatialCache_.getCachedEntities(out, pos, radius, clipToCircle, frameNumber_,
 		[this, filterTypes, filterFlags] (glm::vec2 const& pos, float radius, std::vector<Entity*> &out)
 	{
-		static thread_local std::vector<b2Body*> bodies;
-		bodies.clear();
+		FrameVector<b2Body*> bodies;
 		getBodiesInArea(pos, radius, false, bodies);
 		for (b2Body* b : bodies) {
 			PhysicsBody* pb = PhysicsBody::getForB2Body(b);
@@ -305,6 +353,12 @@ void World::getEntitiesInBox(std::vector<Entity*> &out, EntityType filterTypes,
 			if (ent && !ent->isZombie())
 				out.push_back(ent);
 		}
+		// the food chunks without a body:
+		foodParticles_.query(pos, radius, [this, &out] (unsigned i) {
+			FoodChunk* chunk = foodParticles_.getChunk(i);
+			if (!chunk->isZombie())
+				out.push_back(chunk);
+		});
 	}, [this, filterTypes, filterFlags] (Entity *e) {
 		return testEntity(*e, filterTypes, filterFlags);
 	});
@@ -12,7 +12,14 @@
 #include "SpatialCache.h"
 #include "input/operations/IOperationSpatialLocator.h"
 #include "utils/MTVector.h"
+#include "utils/Delegate.h"
+#include "utils/FrameArena.h"
 #include "renderOpenGL/RenderContext.h"
+#include "math/aabb.h"
+#include "body-parts/GrowthCommitBatcher.h"
+#include "entities/food/FoodChunkPool.h"
+#include "entities/food/FoodParticles.h"
+#include "physics/SleepManager.h"
 
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 
@@ -24,13 +31,25 @@ class b2World;
 class b2Body;
 struct b2AABB;
 class PhysDestroyListener;
+class LineageLog;
 
+/*
+ * The World owns all the entities and links them with the physics world (b2World) and the spatial cache.
+ * Multiple independent worlds may exist in the same process (sharing the thread pool); entities and body parts
+ * receive the world they belong to when they are constructed and must use that instead of any global.
+ */
 class World : public IOperationSpatialLocator {
 public:
-	static World* getInstance();
 	World();
 	virtual ~World();
 
+	// population statistics for this world, maintained by the bugs that live in it
+	struct PopulationStats {
+		std::atomic<int> population {0};
+		std::atomic<int> freeZygotes {0};
+		std::atomic<int> maxGeneration {0};
+	};
+
 	/**
 	 * delete all entities and reset state.
 	 * set new world spatial extents
@@ -38,9 +57,10 @@ public:
 	void reset();
 
 	void setBounds(float left, float right, float top, float bottom);
+	aabb getBounds() const { return aabb({extentXn_, extentYn_}, {extentXp_, extentYp_}); }
 
 	b2Body* getBodyAtPos(glm::vec2 const& pos) override;
-	void getBodiesInArea(glm::vec2 const& pos, float radius, bool clipToCircle, std::vector<b2Body*> &outBodies);
+	void getBodiesInArea(glm::vec2 const& pos, float radius, bool clipToCircle, FrameVector<b2Body*> &outBodies);
 
 	void setPhysics(b2World* physWld);
 	void setDestroyListener(PhysDestroyListener *listener) { destroyListener_ = listener; }
@@ -60,12 +80,30 @@ public:
 	void update(float dt);
 	void draw(RenderContext const& ctx);
 
+	// the captures of deferred actions that don't fit in the delegate go into the frame arena, since they're all executed in this frame
+	typedef Delegate<void(), FrameAllocator<char>> DeferredAction;
 	// this is thread safe by design; if called from the synchronous loop that executes deferred actions, it's executed immediately, else added to the queue
-	void queueDeferredAction(std::function<void()> &&fun);
+	void queueDeferredAction(DeferredAction &&fun);
+
+	PopulationStats& getPopulationStats() { return populationStats_; }
+
+	// the log where the births, deaths and eggs of this world's bugs are recorded; may be null (not recording)
+	void setLineageLog(LineageLog* log) { lineageLog_ = log; }
+	LineageLog* getLineageLog() { return lineageLog_; }
+
+	// the body parts that must rebuild their fixtures after growing are committed through this, at the end of the frame
+	GrowthCommitBatcher& getGrowthCommitBatcher() { return growthCommitBatcher_; }
+	// the recycled bodies of the destroyed food chunks
+	FoodChunkPool& getFoodChunkPool() { return foodChunkPool_; }
+	// the food chunks that are simulated as particles instead of rigid bodies (when enabled)
+	FoodParticles& getFoodParticles() { return foodParticles_; }
+	// puts the idle food bodies far from the bugs to sleep
+	SleepManager& getSleepManager() { return sleepManager_; }
 
 #ifdef DEBUG
-	static void assertOnMainThread() {
-		assert(std::this_thread::get_id() == getInstance()->ownerThreadId_);
+	// asserts that the caller runs on the thread that owns (created) this world
+	void assertOnMainThread() const {
+		assert(std::this_thread::get_id() == ownerThreadId_);
 	}
 #endif
 
@@ -79,20 +117,31 @@ protected:
 	MTVector<std::unique_ptr<Entity>> entsToTakeOver;
 	PhysDestroyListener *destroyListener_ = nullptr;
 	int frameNumber_ = 0;
-	float extentXn_, extentXp_, extentYn_, extentYp_;
+	float extentXn_ = 0, extentXp_ = 0, extentYn_ = 0, extentYp_ = 0;
 	SpatialCache spatialCache_;
+	PopulationStats populationStats_;
+	LineageLog* lineageLog_ = nullptr;
+	GrowthCommitBatcher growthCommitBatcher_;
+	FoodChunkPool foodChunkPool_;
+	FoodParticles foodParticles_;
+	SleepManager sleepManager_;
 #ifdef DEBUG
 	std::thread::id ownerThreadId_;
 #endif
 
 	// this holds actions deferred from the multi-threaded update which will be executed synchronously at the end on a single thread
-	MTVector<std::function<void()>> deferredActions_;
+	MTVector<DeferredAction> deferredActions_;
 	std::atomic<bool> executingDeferredActions_ { false };
 
+	// (Z-order key, entity) pairs used when sorting entsToUpdate by spatial position
+	std::vector<std::pair<uint32_t, Entity*>> spatialSortBuffer_;
+
 	void destroyPending();
 	void takeOverPending();
+	void sortUpdateListSpatially();
+	void updateSleep();
 
-	void getFixtures(std::vector<b2Fixture*> &out, b2AABB const& aabb);
+	void getFixtures(FrameVector<b2Fixture*> &out, b2AABB const& aabb);
 	bool testEntity(Entity &e, EntityType filterTypes, Entity::FunctionalityFlags filterFlags);
 };
 
@@ -15,6 +15,7 @@ public:
 	// optimization values:
 	static constexpr float SizeThresholdToCommit			= 1.1f;			// [*]
 	static constexpr float SizeThresholdToCommit_inv = 1.f / SizeThresholdToCommit;
+	static constexpr unsigned MaxGrowthCommitsPerFrame		= 64;			// [*] body parts re-committed per frame, the rest wait
 
 	// fixed values:
 	static constexpr float MinBodyPartSize					= 1.e-4f;		// [m^2]
@@ -15,10 +15,11 @@
 #include "../renderOpenGL/Shape3D.h"
 #include "../utils/log.h"
 #include "../utils/assert.h"
+#include "../utils/ObjectPool.h"
 #include "../genetics/GeneDefinitions.h"
 #include "../World.h"
 #include <glm/gtx/rotate_vector.hpp>
-#include <Box2D/Dynamics/b2Body.h>
+#include <Box2D/Box2D.h>
 #include <cassert>
 #include <sstream>
 
@@ -34,8 +35,21 @@ BodyPartInitializationData::BodyPartInitializationData()
 {
 }
 
-BodyPart::BodyPart(BodyPartType type, std::shared_ptr<BodyPartInitializationData> initialData)
-	: type_(type)
+bool BodyPart::compoundBodies_ = false;
+
+void* BodyPart::operator new(size_t size) {
+	static ObjectPool::Context sharedContext(ObjectPool::Policy::ReuseSlots);
+	ObjectPool::Context* ctx = ObjectPool::getCurrentContext();
+	return ObjectPool::allocate(size, ctx ? *ctx : sharedContext);
+}
+
+void BodyPart::operator delete(void* p, size_t size) {
+	ObjectPool::free(p, size);
+}
+
+BodyPart::BodyPart(World* world, BodyPartType type, std::shared_ptr<BodyPartInitializationData> initialData)
+	: world_(world)
+	, type_(type)
 	, parent_(nullptr)
 	, children_{nullptr}
 	, nChildren_(0)
@@ -53,6 +67,7 @@ BodyPart::BodyPart(BodyPartType type, std::shared_ptr<BodyPartInitializationData
 	, destroyCalled_(false)
 	, dead_(false)
 {
+	assertDbg (world != nullptr);
 	assertDbg (initialData != nullptr);
 
 	registerAttribute(GENE_ATTRIB_LOCAL_ROTATION, initialData_->localRotation);
@@ -61,10 +76,16 @@ BodyPart::BodyPart(BodyPartType type, std::shared_ptr<BodyPartInitializationData
 
 	physBody_.categoryFlags_ = EventCategoryFlags::BODYPART;
 	physBody_.getEntityFunc_ = &getEntityFromBodyPartPhysBody;
+	physBody_.onHostDestroyed.add([this] (PhysicsBody*) {
+		splitFromHost();
+	});
 }
 
 BodyPart::~BodyPart() {
 	assertDbg(destroyCalled_);
+	assertDbg(!arena_);	// parts leave the arena when they are detached
+	if (commitQueued_)
+		world_->getGrowthCommitBatcher().remove(this);
 }
 
 void BodyPart::destroy() {
@@ -76,15 +97,6 @@ void BodyPart::destroy() {
 	delete this;
 }
 
-bool BodyPart::applyRecursive(std::function<bool(BodyPart* pCurrent)> pred) {
-	if (pred(this))
-		return true;
-	for (int i=0; i<nChildren_; i++)
-		if (children_[i]->applyRecursive(pred))
-			return true;
-	return false;
-}
-
 void BodyPart::addMotorLine(int lineId) {
 	motorLines_.push_back(lineId);
 	if (parent_)
@@ -107,12 +119,14 @@ float BodyPart::add(BodyPart* part, float angle) {
 	part->parent_ = this;
 	part->setAttachmentDirection(angle);
 	part->onAddedToParent();
+	if (arena_)
+		arena_->rebuild();
 	return children_[bufferPos]->attachmentDirectionParent_;
 }
 
 void BodyPart::detach(bool die) {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (parent_) {
 		// first must detach all neural connections
@@ -122,13 +136,15 @@ void BodyPart::detach(bool die) {
 		parent_->hierarchyMassChanged();
 	}
 	parent_ = nullptr;
+	if (physBody_.getHost() && !destroyCalled_)
+		splitFromHost();
 	if (die && !dead_)
 		die_tree();
 }
 
 void BodyPart::detachMotorLines(std::vector<unsigned> const& lines) {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (parent_)
 		parent_->detachMotorLines(lines);
@@ -136,13 +152,15 @@ void BodyPart::detachMotorLines(std::vector<unsigned> const& lines) {
 
 void BodyPart::remove(BodyPart* part) {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	for (int i=0; i<nChildren_; i++)
 		if (children_[i] == part) {
 			children_[i] = children_[--nChildren_];
 			break;
 		}
+	if (arena_)
+		arena_->rebuild();
 }
 
 glm::vec2 BodyPart::getUpstreamAttachmentPoint() {
@@ -166,11 +184,11 @@ void BodyPart::commit_tree(float initialScale) {
 		reverseUpdateCachedProps();
 	lastCommitSize_inv_ = 1.f / size_;
 
-	World::getInstance()->queueDeferredAction([this, initialScale] () {
+	world_->queueDeferredAction([this, initialScale] () {
 		// perform commit on local node:
 		if (type_ != BodyPartType::JOINT) {
-			if (!physBody_.b2Body_ && !dontCreateBody_)
-				physBody_.create(cachedProps_);
+			if (!physBody_.b2Body_ && !dontCreateBody_ && !joinsParentBody())
+				physBody_.create(world_, cachedProps_);
 			commit();
 		}
 		// perform recursive commit on all non-muscle children:
@@ -198,7 +216,7 @@ void BodyPart::purge_initializationData() {
 glm::vec2 BodyPart::getParentSpacePosition() {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -248,7 +266,11 @@ void BodyPart::computeBodyPhysProps() {
 }
 
 glm::vec3 BodyPart::getWorldTransformation() {
-	if (physBody_.b2Body_ && !noFixtures_) {
+	if (physBody_.getHost()) {
+		// we're a fixed part of a compound body:
+		glm::vec3 hostTransform(b2g(physBody_.b2Body_->GetPosition()), physBody_.b2Body_->GetAngle());
+		return hostTransform + glm::vec3(glm::rotate(vec3xy(hostOffset_), hostTransform.z), hostOffset_.z);
+	} else if (physBody_.b2Body_ && !noFixtures_) {
 		return glm::vec3(b2g(physBody_.b2Body_->GetPosition()), physBody_.b2Body_->GetAngle());
 	} else {
 		// if not committed yet, must compute these values on the fly
@@ -292,47 +314,54 @@ UpdateList* BodyPart::getUpdateList() {
 }
 
 float BodyPart::getMass_tree() {
-	float mass = size_ * density_;
-
-	for (int i=0; i<nChildren_; i++)
-		mass += children_[i]->getMass_tree();
+	if (arena_) {
+		float mass = 0;
+		for (unsigned i=arenaIndex_, end=(*arena_)[arenaIndex_].subtreeEnd; i<end; ) {
+			BodyPart* part = (*arena_)[i].part;
+			mass += part->getOwnMass();
+			i = part->ownMassIncludesChildren_ ? (*arena_)[i].subtreeEnd : i+1;
+		}
+		return mass;
+	}
+	float mass = getOwnMass();
+	if (!ownMassIncludesChildren_)
+		for (int i=0; i<nChildren_; i++)
+			mass += children_[i]->getMass_tree();
 	return mass;
 }
 
 void BodyPart::applyScale_tree(float scale) {
-	applyScale_treeImpl(scale, false);
+	if (arena_)
+		applyScale_treeFlat(scale);
+	else
+		applyScale_treeImpl(scale);
+}
+
+/*
+ * Same as applyScale_treeImpl, in the same order, but walking the arena
+ */
+void BodyPart::applyScale_treeFlat(float scale) {
+	for (unsigned i=arenaIndex_, end=(*arena_)[arenaIndex_].subtreeEnd; i<end; i++)
+		(*arena_)[i].part->applyScale(scale);
+}
+
+void BodyPart::applyScale_treeImpl(float scale) {
+	applyScale(scale);
+	for (int i=0; i<nChildren_; i++)
+		children_[i]->applyScale_treeImpl(scale);
 }
 
-bool BodyPart::applyScale_treeImpl(float scale, bool parentChanged) {
+void BodyPart::applyScale(float scale) {
 	size_ *= scale;
-	bool committed_now = false, should_commit_joint = false;
 	if (committed_) {
 		if (size_ * lastCommitSize_inv_ > BodyConst::SizeThresholdToCommit
 				|| size_ * lastCommitSize_inv_ < BodyConst::SizeThresholdToCommit_inv)
 		{
+			// the fixtures are rebuilt in batch at the end of the frame; the joints next to this part follow
 			lastCommitSize_inv_ = 1.f / size_;
-			if (type_ != BodyPartType::JOINT) {
-				World::getInstance()->queueDeferredAction([this] {
-					commit();
-				});
-				committed_now = true;
-			} else
-				should_commit_joint = true;
+			world_->getGrowthCommitBatcher().add(this);
 		}
 	}
-	bool child_changed = false;
-	for (int i=0; i<nChildren_; i++) {
-		child_changed |= children_[i]->applyScale_treeImpl(scale, committed_now);
-	}
-	if (type_ == BodyPartType::JOINT && committed_ && (should_commit_joint || parentChanged || child_changed)) {
-		// must commit a joint whenever the threshold is reached, or parent or child has committed
-		World::getInstance()->queueDeferredAction([this] {
-			commit();
-		});
-		committed_now = true;
-	}
-
-	return committed_now;
 }
 
 void BodyPart::consumeEnergy(float amount) {
@@ -342,7 +371,7 @@ void BodyPart::consumeEnergy(float amount) {
 
 void BodyPart::die_tree() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (!dead_) {
 		die();
@@ -357,21 +386,38 @@ void BodyPart::die_tree() {
 
 void BodyPart::consumeFoodValue(float amount) {
 	if (dead_) {
-		foodValueLeft_ -= amount;
+		float prev = foodValueLeft_.load(std::memory_order_relaxed);
+		while (!foodValueLeft_.compare_exchange_weak(prev, prev-amount, std::memory_order_acq_rel, std::memory_order_relaxed))
+			; // loop
 	}
 }
 
+float BodyPart::takeFoodValue(float maxAmount) {
+	if (!dead_)
+		return 0;
+	float prev = foodValueLeft_.load(std::memory_order_relaxed);
+	float taken;
+	do {
+		taken = max(0.f, min(maxAmount, prev));
+		if (taken == 0)
+			return 0;
+	} while (!foodValueLeft_.compare_exchange_weak(prev, prev-taken, std::memory_order_acq_rel, std::memory_order_relaxed));
+	return taken;
+}
+
 void BodyPart::removeAllLinks() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	parent_ = nullptr;
 	nChildren_ = 0;
+	if (arena_)
+		arena_->rebuild();
 }
 
 void BodyPart::reattachChildren() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (committed_) {
 		for (int i=0; i<nChildren_; i++) {
@@ -380,7 +426,75 @@ void BodyPart::reattachChildren() {
 	}
 }
 
+bool BodyPart::joinsParentBody() const {
+	return weldedToParent_ && compoundBodies_ && parent_ && parent_->physBody_.b2Body_ && !parent_->physBody_.getHost();
+}
+
+void BodyPart::createWeldedFixture(b2FixtureDef const& def) {
+#ifdef DEBUG
+	world_->assertOnMainThread();
+#endif
+	assertDbg(weldedToParent_ && !weldedFixture_);
+	if (!physBody_.b2Body_ && joinsParentBody())
+		physBody_.shareBody(&parent_->physBody_);
+	if (physBody_.getHost()) {
+		// the fixture goes on the parent's body, in the rest position relative to the parent:
+		if (parent_)
+			hostOffset_ = glm::vec3(getParentSpacePosition(), attachmentDirectionParent_ + localRotation_);
+		weldedFixture_ = physBody_.createFixture(def, hostOffset_);
+		return;
+	}
+	weldedFixture_ = physBody_.createFixture(def);
+	if (!parent_ || !parent_->physBody_.b2Body_)
+		return;
+	b2WeldJointDef jdef;
+	jdef.bodyA = parent_->physBody_.b2Body_;
+	jdef.bodyB = physBody_.b2Body_;
+	glm::vec2 parentAnchor = parent_->getChildAttachmentPoint(attachmentDirectionParent_);
+	jdef.localAnchorA = g2b(parentAnchor);
+	glm::vec2 childAnchor = getChildAttachmentPoint(PI - localRotation_);
+	jdef.localAnchorB = g2b(childAnchor);
+	weldJoint_ = (b2WeldJoint*) physBody_.b2Body_->GetWorld()->CreateJoint(&jdef);
+}
+
+void BodyPart::destroyWeldedFixture() {
+#ifdef DEBUG
+	world_->assertOnMainThread();
+#endif
+	if (weldedFixture_) {
+		physBody_.b2Body_->DestroyFixture(weldedFixture_);
+		weldedFixture_ = nullptr;
+	}
+	if (weldJoint_) {
+		physBody_.b2Body_->GetWorld()->DestroyJoint(weldJoint_);
+		weldJoint_ = nullptr;
+	}
+}
+
+void BodyPart::splitFromHost() {
+#ifdef DEBUG
+	world_->assertOnMainThread();
+#endif
+	// the compound body is being split (the part was detached or the part that owns the body is going away);
+	// carry on with a body of our own, where we were and moving the same way:
+	b2Body* shared = physBody_.b2Body_;
+	glm::vec3 transform = getWorldTransformation();
+	cachedProps_.position = vec3xy(transform);
+	cachedProps_.angle = transform.z;
+	cachedProps_.velocity = b2g(shared->GetLinearVelocityFromWorldPoint(g2b(cachedProps_.position)));
+	cachedProps_.angularVelocity = shared->GetAngularVelocity();
+	physBody_.unshareBody();
+	weldedFixture_ = nullptr;
+	physBody_.createNow(world_, cachedProps_);
+	commit();
+}
+
 void BodyPart::draw_tree(RenderContext const& ctx) {
+	if (arena_) {
+		for (unsigned i=arenaIndex_, end=(*arena_)[arenaIndex_].subtreeEnd; i<end; i++)
+			(*arena_)[i].part->draw(ctx);
+		return;
+	}
 	draw(ctx);
 	for (int i=0; i<nChildren_; i++)
 		children_[i]->draw_tree(ctx);
@@ -474,6 +588,11 @@ Entity* BodyPart::getEntityFromBodyPartPhysBody(PhysicsBody const& body) {
 
 aabb BodyPart::getAABBRecursive() {
 	aabb X = physBody_.getAABB();
+	if (arena_) {
+		for (unsigned i=arenaIndex_+1, end=(*arena_)[arenaIndex_].subtreeEnd; i<end; i++)
+			X = X.reunion((*arena_)[i].part->physBody_.getAABB());
+		return X;
+	}
 	for (int i=0; i<nChildren_; i++)
 		X = X.reunion(children_[i]->getAABBRecursive());
 	return X;
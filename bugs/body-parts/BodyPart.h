@@ -8,6 +8,8 @@
 #ifndef OBJECTS_BODY_PARTS_BODYPART_H_
 #define OBJECTS_BODY_PARTS_BODYPART_H_
 
+#include "BodyPartType.h"
+#include "BodyPartArena.h"
 #include "../genetics/GeneDefinitions.h"
 #include "../genetics/CummulativeValue.h"
 #include "../physics/PhysicsBody.h"
@@ -15,46 +17,36 @@
 #include <map>
 #include <memory>
 #include <ostream>
-
-enum class BodyPartType {
-	INVALID = 0,
-
-	TORSO,
-	BONE,
-	JOINT,
-	MUSCLE,
-	GRIPPER,
-	ZYGOTE_SHELL,
-	SENSOR_PROXIMITY,		// many outputs for multiple types of entities
-	SENSOR_COMPASS,			// 1 output - absolute orientation in world
-	SENSOR_SIGHT,			// array of outputs for pixels (multiple channels maybe?)
-	MOUTH,
-	EGGLAYER,
-};
-
-inline std::ostream& operator << (std::ostream& str, BodyPartType const& type) {
-	return str << (unsigned)type;
-}
+#include <atomic>
 
 class UpdateList;
 class RenderContext;
+class b2Fixture;
+class b2WeldJoint;
+struct b2FixtureDef;
 class Bug;
 struct BodyPartInitializationData;
 class Entity;
+class World;
 
 class BodyPart {
 public:
 	static constexpr unsigned MAX_CHILDREN = 16;
 
-	BodyPart(BodyPartType type, std::shared_ptr<BodyPartInitializationData> initialData);
+	BodyPart(World* world, BodyPartType type, std::shared_ptr<BodyPartInitializationData> initialData);
 	virtual ~BodyPart();
 
 	// call this to destroy and delete the object. Never delete directly
 	void destroy();
 
+	// the parts are pooled: they go into the current ObjectPool context (their bug's) or the one shared by all parts
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+
 	virtual void draw(RenderContext const& ctx);
 
 	inline BodyPartType getType() const { return type_; }
+	inline World* getWorld() const { return world_; }
 	inline BodyPart* getParent() const { return parent_; }
 	std::string getDebugName() const;
 
@@ -93,6 +85,12 @@ public:
 			return attrVec[0];
 	}
 
+	// returns the number of values registered for the given attribute (zero if the part doesn't have the attribute)
+	inline unsigned getAttributeCount(gene_part_attribute_type attrib) const {
+		auto it = mapAttributes_.find(attrib);
+		return it == mapAttributes_.end() ? 0 : it->second.size();
+	}
+
 	/*
 	 * this will commit recursively in the entire body tree
 	 */
@@ -123,7 +121,8 @@ public:
 	inline float getAttachmentAngle() const { return attachmentDirectionParent_; }
 
 	// return false from the predicate to continue or true to break out; the ORed return value is passed back to the caller as method return
-	bool applyRecursive(std::function<bool(BodyPart* pCurrent)> pred);
+	template<class F>
+	bool applyRecursive(F &&pred);
 
 	// adds the motor line id into this node and all nodes above it recursively
 	// this id is the index of the nerve line from the neural network down to one of this motor's inputs
@@ -143,18 +142,31 @@ public:
 
 	inline bool isDead() { return dead_; }
 
-	float getFoodValue() { return foodValueLeft_; }
+	float getFoodValue() { return foodValueLeft_.load(std::memory_order_relaxed); }
+	// thread safe - several mouths may be eating the same dead part
 	void consumeFoodValue(float amount);
+	// atomically takes up to [maxAmount] of food value from a dead part and returns the amount actually taken
+	float takeFoodValue(float maxAmount);
 
 	Event<void(BodyPart* part)> onDied;
 
 	static Entity* getEntityFromBodyPartPhysBody(PhysicsBody const& body);
 
+	/*
+	 * In compound mode the parts that are rigidly attached to their parent (mouth, egg-layer, nose) don't get a body
+	 * of their own welded to the parent's; instead their fixtures are added to the parent's body, so every rigid group
+	 * of parts between two joints is simulated as a single b2Body.
+	 * This only affects parts committed after the call.
+	 */
+	static void setCompoundBodies(bool enable) { compoundBodies_ = enable; }
+	static bool getCompoundBodies() { return compoundBodies_; }
+
 protected:
 	// these are used when initializing the body and whenever a new commit is called.
 	// they contain world-space values that are updated only prior to committing
 	PhysicsProperties cachedProps_;
 	PhysicsBody physBody_;
+	World* world_;
 	BodyPartType type_;
 	BodyPart* parent_;
 
@@ -163,6 +175,7 @@ protected:
 
 	bool committed_;
 	bool noFixtures_ = false;
+	bool weldedToParent_ = false;	// set this if the part is rigidly attached to its parent (see createWeldedFixture())
 	// bool keepInitializationData_;	// set to true to not delete the initialData_ after commit()
 	bool dontCreateBody_;			// set to true to prevent creating an actual physics body
 	/* this indicates if the values that come from genes (such as angleOffset_, size_ etc) have been cached
@@ -214,6 +227,13 @@ protected:
 	UpdateList* getUpdateList();
 	// call this if the fixture changed for any reason:
 	void reattachChildren();
+	/*
+	 * parts that are rigidly attached to their parent create their fixture through this: it goes either on the part's
+	 * own body, welded to the parent's, or (compound mode) directly on the parent's body.
+	 */
+	void createWeldedFixture(b2FixtureDef const& def);
+	// destroys the fixture (and weld joint) created by createWeldedFixture(), before a recommit
+	void destroyWeldedFixture();
 	void computeBodyPhysProps();
 
 	friend class Joint;
@@ -221,27 +241,65 @@ protected:
 	virtual void detachMotorLines(std::vector<unsigned> const& lines);
 	virtual void hierarchyMassChanged();
 
+	// the mass of this part alone; getMass_tree() adds these up over the subtree
+	virtual float getOwnMass() { return size_ * density_; }
+	bool ownMassIncludesChildren_ = false;	// set this if getOwnMass() accounts for the whole subtree
+
 	void buildDebugName(std::stringstream &out_stream) const;
 
 private:
 	void reverseUpdateCachedProps();
 	glm::vec2 getParentSpacePosition();
-	bool applyScale_treeImpl(float scale, bool parentChanged);
+	void applyScale_treeImpl(float scale);
+	void applyScale_treeFlat(float scale);
+	// scales this part alone, queueing it for commit if it crossed the threshold
+	void applyScale(float scale);
 	void purge_initializationData();
 	/** changes the attachment direction of this part to its parent. This doesn't take effect until commit is called */
 	inline void setAttachmentDirection(float angle) { attachmentDirectionParent_ = angle; }
 	void remove(BodyPart* part);
+	// true if the part's fixture will be added to its parent's body instead of creating one of its own
+	bool joinsParentBody() const;
+	// moves the part from the parent's compound body to a body of its own, in the same place
+	void splitFromHost();
+
+	friend class BodyPartArena;
+	friend class GrowthCommitBatcher;
+	BodyPartArena* arena_ = nullptr;	// the arena of the body this part is in, if any
+	unsigned arenaIndex_ = 0;			// this part's node in the arena
+
+	static bool compoundBodies_;
+	b2Fixture* weldedFixture_ = nullptr;
+	b2WeldJoint* weldJoint_ = nullptr;
+	glm::vec3 hostOffset_ {0};			// (x, y, angle) of the part within the compound body it shares
 
 	std::map<gene_part_attribute_type, std::vector<CummulativeValue*>> mapAttributes_;
 	std::shared_ptr<BodyPartInitializationData> initialData_;
 	UpdateList* updateList_;
 	float lastCommitSize_inv_ = 0;
+	bool commitQueued_ = false;			// the part is waiting in the world's GrowthCommitBatcher
 	bool destroyCalled_ = false;
 	bool dead_ = false;
-	float foodValueLeft_ = 0;
+	std::atomic<float> foodValueLeft_ {0};
 };
 
 
+template<class F>
+bool BodyPart::applyRecursive(F &&pred) {
+	if (arena_) {
+		for (unsigned i=arenaIndex_, end=(*arena_)[arenaIndex_].subtreeEnd; i<end; i++)
+			if (pred((*arena_)[i].part))
+				return true;
+		return false;
+	}
+	if (pred(this))
+		return true;
+	for (int i=0; i<nChildren_; i++)
+		if (children_[i]->applyRecursive(pred))
+			return true;
+	return false;
+}
+
 // inherit this struct and put in it all the CummulativeValues that are changed by the genes.
 // after the genome is completely decoded, this data will be cached into real floats and this struct will be destroyed.
 struct BodyPartInitializationData {
@@ -0,0 +1,53 @@
+/*
+ * BodyPartArena.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "BodyPartArena.h"
+#include "BodyPart.h"
+
+#include "../perf/marker.h"
+
+#include <algorithm>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+void BodyPartArena::build(BodyPart* root) {
+	PERF_MARKER_FUNC;
+	for (auto &n : nodes_)
+		n.part->arena_ = nullptr;
+	nodes_.clear();
+	root_ = root;
+	if (!root)
+		return;
+	// the children are pushed in reverse order so they come out in their natural order (same as the recursive walks)
+	buildStack_.clear();
+	buildStack_.push_back(std::make_pair(root, -1));
+	while (!buildStack_.empty()) {
+		BodyPart* part = buildStack_.back().first;
+		int parent = buildStack_.back().second;
+		buildStack_.pop_back();
+		unsigned index = nodes_.size();
+		nodes_.push_back(Node{part, parent, index + 1});
+		part->arena_ = this;
+		part->arenaIndex_ = index;
+		for (int i=part->nChildren_-1; i>=0; i--)
+			buildStack_.push_back(std::make_pair(part->children_[i], (int)index));
+	}
+	// children come after their parents, so walking backwards extends each parent's range over its children's:
+	for (unsigned i=nodes_.size()-1; i>0; i--) {
+		Node &parent = nodes_[nodes_[i].parent];
+		parent.subtreeEnd = std::max(parent.subtreeEnd, nodes_[i].subtreeEnd);
+	}
+}
+
+void BodyPartArena::clear() {
+	for (auto &n : nodes_)
+		n.part->arena_ = nullptr;
+	nodes_.clear();
+	root_ = nullptr;
+}
@@ -0,0 +1,58 @@
+/*
+ * BodyPartArena.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef BODY_PARTS_BODYPARTARENA_H_
+#define BODY_PARTS_BODYPARTARENA_H_
+
+#include <vector>
+
+class BodyPart;
+
+/*
+ * The body parts of a bug laid out contiguously in depth-first (pre-order) order, with index links between them,
+ * so that walks over the body tree are linear loops instead of recursion through the scattered parts.
+ * The subtree of the node at index i occupies the range [i, subtreeEnd).
+ *
+ * The arena is built once the body is fully developed and is rebuilt whenever the topology changes (a part is
+ * added, removed or detached); parts that leave the tree also leave the arena. Topology changes only happen on the
+ * main thread (deferred actions), while the parts are not being updated.
+ * The parts keep their own links, so everything works (recursively) on parts that are not in an arena.
+ */
+class BodyPartArena {
+public:
+	struct Node {
+		BodyPart* part;
+		int parent;				// index of the parent node; -1 for the root
+		unsigned subtreeEnd;	// index past the last descendant
+	};
+
+	BodyPartArena() = default;
+	BodyPartArena(BodyPartArena const&) = delete;
+	~BodyPartArena() { clear(); }
+
+	// lays out the tree under [root]; parts that were in the arena before and are not under [root] anymore leave it
+	void build(BodyPart* root);
+	void rebuild() { build(root_); }
+	// all the parts leave the arena
+	void clear();
+
+	BodyPart* getRoot() const { return root_; }
+	bool empty() const { return nodes_.empty(); }
+	unsigned size() const { return nodes_.size(); }
+	Node const& operator[](unsigned i) const { return nodes_[i]; }
+
+private:
+	friend class BodyPart;
+
+	std::vector<Node> nodes_;
+	BodyPart* root_ = nullptr;
+
+	// scratch memory for build(), reused to avoid allocations:
+	std::vector<std::pair<BodyPart*, int>> buildStack_;
+};
+
+#endif /* BODY_PARTS_BODYPARTARENA_H_ */
@@ -0,0 +1,33 @@
+/*
+ * BodyPartType.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef OBJECTS_BODY_PARTS_BODYPARTTYPE_H_
+#define OBJECTS_BODY_PARTS_BODYPARTTYPE_H_
+
+#include <ostream>
+
+enum class BodyPartType {
+	INVALID = 0,
+
+	TORSO,
+	BONE,
+	JOINT,
+	MUSCLE,
+	GRIPPER,
+	ZYGOTE_SHELL,
+	SENSOR_PROXIMITY,		// many outputs for multiple types of entities
+	SENSOR_COMPASS,			// 1 output - absolute orientation in world
+	SENSOR_SIGHT,			// array of outputs for pixels (multiple channels maybe?)
+	MOUTH,
+	EGGLAYER,
+};
+
+inline std::ostream& operator << (std::ostream& str, BodyPartType const& type) {
+	return str << (unsigned)type;
+}
+
+#endif /* OBJECTS_BODY_PARTS_BODYPARTTYPE_H_ */
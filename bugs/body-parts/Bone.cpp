@@ -38,8 +38,8 @@ void Bone::cacheInitializationData() {
 	width_ = length_ / aspectRatio;			// w = l/a
 }
 
-Bone::Bone()
-	: BodyPart(BodyPartType::BONE, std::make_shared<BoneInitializationData>())
+Bone::Bone(World* world)
+	: BodyPart(world, BodyPartType::BONE, std::make_shared<BoneInitializationData>())
 	, length_(0)
 	, width_(0)
 {
@@ -53,7 +53,7 @@ Bone::Bone()
 
 Bone::~Bone() {
 	if (committed_) {
-		physBody_.b2Body_->DestroyFixture(&physBody_.b2Body_->GetFixtureList()[0]);
+		physBody_.b2Body_->DestroyFixture(physBody_.getFixture());
 	}
 }
 
@@ -62,10 +62,10 @@ void Bone::die() {
 
 void Bone::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (committed_) {
-		physBody_.b2Body_->DestroyFixture(&physBody_.b2Body_->GetFixtureList()[0]);
+		physBody_.b2Body_->DestroyFixture(physBody_.getFixture());	// not the list head, the body may carry compound fixtures
 	}
 
 	// create fixture:
@@ -115,7 +115,7 @@ void Bone::draw(RenderContext const& ctx) {
 float Bone::getAspectRatio() {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -21,7 +21,7 @@ struct BoneInitializationData : public BodyPartInitializationData {
 
 class Bone: public BodyPart {
 public:
-	Bone();
+	Bone(World* world);
 	virtual ~Bone() override;
 	glm::vec2 getChildAttachmentPoint(float relativeAngle) override;
 
@@ -14,6 +14,7 @@
 #include "../renderOpenGL/RenderContext.h"
 #include "../entities/Gamete.h"
 #include "../World.h"
+#include "../session/LineageLog.h"
 #include "../neuralnet/InputSocket.h"
 
 #include "../utils/UpdateList.h"
@@ -54,8 +55,8 @@ float EggLayer::getInputVMSCoord(unsigned index) const {
 		return 0;
 }
 
-EggLayer::EggLayer()
-	: BodyPart(BodyPartType::EGGLAYER, std::make_shared<EggLayerInitializationData>())
+EggLayer::EggLayer(World* world)
+	: BodyPart(world, BodyPartType::EGGLAYER, std::make_shared<EggLayerInitializationData>())
 	, targetEggMass_(BodyConst::initialEggMass)
 	, ejectSpeed_(0)
 {
@@ -69,6 +70,8 @@ EggLayer::EggLayer()
 
 	physBody_.userObjectType_ = ObjectTypes::BPART_EGGLAYER;
 	physBody_.userPointer_ = this;
+	ownMassIncludesChildren_ = true;	// the mass of the eggs being grown is not part of the body
+	weldedToParent_ = true;
 }
 
 EggLayer::~EggLayer() {
@@ -82,7 +85,7 @@ void EggLayer::die() {
 		getUpdateList()->remove(this);
 }
 
-float EggLayer::getMass_tree() {
+float EggLayer::getOwnMass() {
 	return initialSize_ * density_;
 }
 
@@ -118,7 +121,7 @@ void EggLayer::draw(RenderContext const& ctx) {
 glm::vec2 EggLayer::getChildAttachmentPoint(float relativeAngle) {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -140,9 +143,12 @@ void EggLayer::update(float dt) {
 		Chromosome chr = GeneticOperations::meyosis(getOwner()->getGenome());
 		glm::vec3 transform = getWorldTransformation();
 		glm::vec2 speed = glm::rotate(glm::vec2(1, 0), transform.z) * ejectSpeed_;
-		std::unique_ptr<Gamete> egg(new Gamete(chr, vec3xy(transform), speed, targetEggMass_));
+		std::unique_ptr<Gamete> egg(new Gamete(world_, chr, vec3xy(transform), speed, targetEggMass_));
 		egg->generation_ = getOwner()->getGeneration() + 1;
-		World::getInstance()->takeOwnershipOf(std::move(egg));
+		egg->parentId_ = getOwner()->getId();
+		if (LineageLog* lineage = world_->getLineageLog())
+			lineage->recordEgg(getOwner()->getId(), targetEggMass_);
+		world_->takeOwnershipOf(std::move(egg));
 		eggMassBuffer_ -= targetEggMass_;
 	}
 }
@@ -164,15 +170,12 @@ void EggLayer::useFood(float food) {
 
 void EggLayer::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
-	if (committed_) {
-		physBody_.b2Body_->DestroyFixture(&physBody_.b2Body_->GetFixtureList()[0]);
-		physBody_.b2Body_->GetWorld()->DestroyJoint(pJoint);
-		pJoint = nullptr;
-	} else {
+	if (committed_)
+		destroyWeldedFixture();
+	else
 		initialSize_ = size_;
-	}
 
 	// override density with zygote density
 	density_ = BodyConst::ZygoteDensity;
@@ -184,16 +187,7 @@ void EggLayer::commit() {
 	fdef.friction = 0.3f;
 	fdef.restitution = 0.2f;
 	fdef.shape = &shape;
-	physBody_.b2Body_->CreateFixture(&fdef);
-
-	b2WeldJointDef jdef;
-	jdef.bodyA = parent_->getBody().b2Body_;
-	jdef.bodyB = physBody_.b2Body_;
-	glm::vec2 parentAnchor = parent_->getChildAttachmentPoint(attachmentDirectionParent_);
-	jdef.localAnchorA = g2b(parentAnchor);
-	glm::vec2 childAnchor = getChildAttachmentPoint(PI - localRotation_);
-	jdef.localAnchorB = g2b(childAnchor);
-	pJoint = (b2WeldJoint*) physBody_.b2Body_->GetWorld()->CreateJoint(&jdef);
+	createWeldedFixture(fdef);
 }
 
 void EggLayer::onAddedToParent() {
@@ -19,11 +19,9 @@ struct EggLayerInitializationData : public BodyPartInitializationData {
 	CummulativeValue inputVMSCoord[2];
 };
 
-class b2WeldJoint;
-
 class EggLayer: public BodyPart, public IMotor {
 public:
-	EggLayer();
+	EggLayer(World* world);
 	virtual ~EggLayer() override;
 
  	void draw(RenderContext const& ctx) override;
@@ -34,8 +32,6 @@ public:
 	void useFood(float food);
 	inline void setTargetEggMass(float mass) { targetEggMass_ = mass; }
 
-	float getMass_tree() override;
-
 	// IMotor::
 	unsigned getInputCount() const override { return 2; }
 	InputSocket* getInputSocket(unsigned index) const override { return index < 2 ? inputs_[index] : nullptr; }
@@ -50,8 +46,8 @@ protected:
 	void die() override;
 	void cacheInitializationData() override;
 	void checkScale();
+	float getOwnMass() override;
 
-	b2WeldJoint* pJoint = nullptr;
 	std::vector<InputSocket*> inputs_;
 	bool suppressGrowth_ = false;
 	bool suppressRelease_ = false;
@@ -30,8 +30,8 @@ const glm::vec3 debug_color(1.f, 0.6f, 0.f);
 
 #define DEBUG_DRAW_GRIPPER
 
-Gripper::Gripper()
-	: BodyPart(BodyPartType::GRIPPER, std::make_shared<GripperInitializationData>())
+Gripper::Gripper(World* world)
+	: BodyPart(world, BodyPartType::GRIPPER, std::make_shared<GripperInitializationData>())
 	, inputSocket_(new InputSocket(nullptr, 1.f))
 	, active_(false)
 	, groundJoint_(nullptr)
@@ -66,7 +66,7 @@ Gripper::~Gripper() {
 
 void Gripper::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (committed_) {
 		physBody_.b2Body_->DestroyFixture(&physBody_.b2Body_->GetFixtureList()[0]);
@@ -96,17 +96,17 @@ void Gripper::setActive(bool active) {
 		return;
 	active_.store(active, std::memory_order_release);
 	if (active) {
-		World::getInstance()->queueDeferredAction([this] {
+		world_->queueDeferredAction([this] {
 			if (groundJoint_)
 				return;
 			b2WeldJointDef jd;
-			jd.bodyA = World::getInstance()->getGroundBody();
+			jd.bodyA = world_->getGroundBody();
 			jd.localAnchorA = physBody_.b2Body_->GetWorldPoint(b2Vec2_zero);
 			jd.bodyB = physBody_.b2Body_;
-			groundJoint_ = (b2WeldJoint*)World::getInstance()->getPhysics()->CreateJoint(&jd);
+			groundJoint_ = (b2WeldJoint*)world_->getPhysics()->CreateJoint(&jd);
 		});
 	} else {
-		World::getInstance()->queueDeferredAction([this] {
+		world_->queueDeferredAction([this] {
 			if (!groundJoint_)
 				return;
 			physBody_.b2Body_->GetWorld()->DestroyJoint(groundJoint_);
@@ -140,7 +140,7 @@ glm::vec2 Gripper::getChildAttachmentPoint(float relativeAngle)
 {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
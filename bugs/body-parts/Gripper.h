@@ -26,7 +26,7 @@ struct GripperInitializationData : public BodyPartInitializationData {
 
 class Gripper : public BodyPart, public IMotor {
 public:
-	Gripper();
+	Gripper(World* world);
 	~Gripper() override;
 
 	void draw(RenderContext const& ctx) override;
@@ -0,0 +1,69 @@
+/*
+ * GrowthCommitBatcher.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "GrowthCommitBatcher.h"
+#include "BodyPart.h"
+#include "BodyConst.h"
+
+#include "../perf/marker.h"
+
+#include <algorithm>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+void GrowthCommitBatcher::add(BodyPart* part) {
+	// each part is only touched by its bug's update, so the flag needs no locking
+	if (part->commitQueued_)
+		return;
+	part->commitQueued_ = true;
+	std::lock_guard<std::mutex> lk(mutex_);
+	pending_.push_back(part);
+}
+
+void GrowthCommitBatcher::remove(BodyPart* part) {
+	std::replace(pending_.begin(), pending_.end(), part, (BodyPart*)nullptr);
+	part->commitQueued_ = false;
+}
+
+void GrowthCommitBatcher::flush() {
+	PERF_MARKER_FUNC;
+	commitsLastFrame_ = 0;
+	if (pending_.empty())
+		return;
+	joints_.clear();
+	auto addJoint = [this] (BodyPart* part) {
+		if (part && part->type_ == BodyPartType::JOINT && part->committed_
+				&& std::find(joints_.begin(), joints_.end(), part) == joints_.end())
+			joints_.push_back(part);
+	};
+	unsigned i = 0;
+	for (; i<pending_.size() && commitsLastFrame_ < BodyConst::MaxGrowthCommitsPerFrame; i++) {
+		BodyPart* part = pending_[i];
+		if (!part)
+			continue;
+		part->commitQueued_ = false;
+		if (part->isDead())
+			continue;	// dead parts may have lost their links; there's no point in resizing them anyway
+		if (part->type_ == BodyPartType::JOINT) {
+			addJoint(part);
+			continue;
+		}
+		part->commit();
+		commitsLastFrame_++;
+		addJoint(part->parent_);
+		for (int c=0; c<part->nChildren_; c++)
+			addJoint(part->children_[c]);
+	}
+	pending_.erase(pending_.begin(), pending_.begin() + i);
+
+	// the joints go after the parts on both of their sides:
+	for (BodyPart* joint : joints_)
+		if (!joint->isDead())
+			joint->commit();
+}
@@ -0,0 +1,47 @@
+/*
+ * GrowthCommitBatcher.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef BODY_PARTS_GROWTHCOMMITBATCHER_H_
+#define BODY_PARTS_GROWTHCOMMITBATCHER_H_
+
+#include <vector>
+#include <mutex>
+
+class BodyPart;
+
+/*
+ * Collects the body parts of all the bugs in a world that have grown (or shrunk) past the commit threshold and must
+ * rebuild their fixtures, and commits them on the main thread in a single pass at the end of the frame's deferred
+ * actions.
+ * At most BodyConst::MaxGrowthCommitsPerFrame parts are committed per frame; the rest carry over to the next frames (in the order they
+ * were queued), so when many bugs grow at once the rebuilds are spread out instead of piling up in one frame.
+ * A part is queued only once no matter how many times it crosses the threshold before being committed.
+ * The joints next to a committed part are recommitted after it in the same pass, since their anchors depend on it.
+ */
+class GrowthCommitBatcher {
+public:
+	GrowthCommitBatcher() = default;
+	GrowthCommitBatcher(GrowthCommitBatcher const&) = delete;
+
+	// queues the part for commit; thread safe (called from the parallel update)
+	void add(BodyPart* part);
+	// drops the part from the queue (the part is being destroyed); main thread only
+	void remove(BodyPart* part);
+	// commits the queued parts, up to the per-frame budget; main thread only, while executing the deferred actions
+	void flush();
+
+	size_t getPendingCount() const { return pending_.size(); }
+	unsigned getCommitsLastFrame() const { return commitsLastFrame_; }
+
+private:
+	std::mutex mutex_;
+	std::vector<BodyPart*> pending_;	// in the order they were queued; removed parts are set to nullptr
+	std::vector<BodyPart*> joints_;		// scratch list of the joints to recommit after the parts
+	unsigned commitsLastFrame_ = 0;
+};
+
+#endif /* BODY_PARTS_GROWTHCOMMITBATCHER_H_ */
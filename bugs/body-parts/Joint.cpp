@@ -44,8 +44,8 @@ void Joint::cacheInitializationData() {
 	resetTorque_ = initData->resetTorque.clamp(0, 1.e3f);
 }
 
-Joint::Joint()
-	: BodyPart(BodyPartType::JOINT, std::make_shared<JointInitializationData>())
+Joint::Joint(World* world)
+	: BodyPart(world, BodyPartType::JOINT, std::make_shared<JointInitializationData>())
 	, physJoint_(nullptr)
 	, phiMin_(0)
 	, phiMax_(0)
@@ -72,7 +72,7 @@ void Joint::onAddedToParent() {
 
 void Joint::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	assertDbg(nChildren_ <= 1);
 
@@ -108,16 +108,16 @@ void Joint::commit() {
 
 	//def.collideConnected = true;
 
-	physJoint_ = (b2RevoluteJoint*)World::getInstance()->getPhysics()->CreateJoint(&def);
-	jointListenerHandle_ = World::getInstance()->getDestroyListener()->addCallback(physJoint_,
+	physJoint_ = (b2RevoluteJoint*)world_->getPhysics()->CreateJoint(&def);
+	jointListenerHandle_ = world_->getDestroyListener()->addCallback(physJoint_,
 			std::bind(&Joint::onPhysJointDestroyed, this, std::placeholders::_1));
 }
 
 void Joint::destroyPhysJoint() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
-	World::getInstance()->getDestroyListener()->removeCallback(physJoint_, jointListenerHandle_);
+	world_->getDestroyListener()->removeCallback(physJoint_, jointListenerHandle_);
 	physJoint_->GetBodyA()->GetWorld()->DestroyJoint(physJoint_);
 	physJoint_ = nullptr;
 }
@@ -159,7 +159,7 @@ glm::vec2 Joint::getChildAttachmentPoint(float relativeAngle)
 {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -222,7 +222,7 @@ void Joint::update(float dt) {
 		LOGNP(reason.str() << ")\n");
 
 #endif
-		World::getInstance()->queueDeferredAction([this] () {
+		world_->queueDeferredAction([this] () {
 			BodyPart* downStream = children_[0];
 			downStream->detach(true); // this will be taken over by bug entity
 			detach(true);
@@ -273,7 +273,7 @@ void Joint::die() {
 
 void Joint::onDetachedFromParent() {
 	/*if (physJoint_) {
-		World::getInstance()->getPhysics()->DestroyJoint(physJoint_);
+		world_->getPhysics()->DestroyJoint(physJoint_);
 		physJoint_ = nullptr;
 	}*/
 }
@@ -44,14 +44,14 @@ void Mouth::cacheInitializationData() {
 	width_ = length_ / aspectRatio;			// w = l/a
 }
 
-Mouth::Mouth()
-	: BodyPart(BodyPartType::MOUTH, std::make_shared<MouthInitializationData>())
+Mouth::Mouth(World* world)
+	: BodyPart(world, BodyPartType::MOUTH, std::make_shared<MouthInitializationData>())
 	, length_(0)
 	, width_(0)
 	, bufferSize_(0)
 	, usedBuffer_(0)
-	, pJoint(nullptr)
 {
+	weldedToParent_ = true;
 	onCollisionEventHandle = physBody_.onCollision.add(std::bind(&Mouth::onCollision, this, std::placeholders::_1, std::placeholders::_2));
 	physBody_.userObjectType_ = ObjectTypes::BPART_MOUTH;
 	physBody_.userPointer_ = this;
@@ -76,7 +76,7 @@ void Mouth::onAddedToParent() {
 glm::vec2 Mouth::getChildAttachmentPoint(float relativeAngle) {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::getInstance()->assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -87,14 +87,9 @@ glm::vec2 Mouth::getChildAttachmentPoint(float relativeAngle) {
 
 void Mouth::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
-	if (committed_) {
-		physBody_.b2Body_->DestroyFixture(
-				&physBody_.b2Body_->GetFixtureList()[0]);
-		physBody_.b2Body_->GetWorld()->DestroyJoint(pJoint);
-		pJoint = nullptr;
-	}
+	destroyWeldedFixture();
 
 	bufferSize_ = size_ * BodyConst::MouthBufferDensity;
 
@@ -107,16 +102,7 @@ void Mouth::commit() {
 	fixDef.restitution = 0.3f;
 	fixDef.shape = &shape;
 
-	physBody_.b2Body_->CreateFixture(&fixDef);
-
-	b2WeldJointDef jdef;
-	jdef.bodyA = parent_->getBody().b2Body_;
-	jdef.bodyB = physBody_.b2Body_;
-	glm::vec2 parentAnchor = parent_->getChildAttachmentPoint(attachmentDirectionParent_);
-	jdef.localAnchorA = g2b(parentAnchor);
-	glm::vec2 childAnchor = getChildAttachmentPoint(PI - localRotation_);
-	jdef.localAnchorB = g2b(childAnchor);
-	pJoint = (b2WeldJoint*) physBody_.b2Body_->GetWorld()->CreateJoint(&jdef);
+	createWeldedFixture(fixDef);
 }
 
 void Mouth::draw(RenderContext const& ctx) {
@@ -143,68 +129,78 @@ void Mouth::onCollision(PhysicsBody* pOther, float impulseMagnitude) {
 //TODO implement hurt
 		return;
 	}
+	// the other's own fixture (its b2Body may be a compound one):
+	b2Fixture* otherFixture = pOther->getFixture();
+	if (!otherFixture)
+		return;
 	b2AABB otherAABB;
-	pOther->b2Body_->GetFixtureList()[0].GetShape()->ComputeAABB(
+	otherFixture->GetShape()->ComputeAABB(
 			&otherAABB,
 			pOther->b2Body_->GetTransform(),
 			0);
 	b2Vec2 otherSize = 2.f * otherAABB.GetExtents();
-	float maxSwallowRatio = min(1.f, width_ / max(max(width_, otherSize.x), otherSize.y));
-	float maxFoodAvailable = 0;
+	glm::vec2 size = b2g(otherSize);
 
-	// check how much food there is:
+	// take the food; the amount available is read again by the atomic take, another mouth may be eating it too:
 	switch (pOther->userObjectType_) {
 	case ObjectTypes::FOOD_CHUNK: {
 		auto pFoodChunk = static_cast<FoodChunk*>(pOther->userPointer_);
 		if (pFoodChunk->isZombie())
 			return;
-		maxFoodAvailable = pFoodChunk->getMassLeft();
+		usedBuffer_ += pFoodChunk->takeMass(getSwallowLimit(size, pFoodChunk->getMassLeft()));
 		break;
 	}
 	case ObjectTypes::BPART_BONE:
 	case ObjectTypes::BPART_EGGLAYER:
 	case ObjectTypes::BPART_GRIPPER:
 	case ObjectTypes::BPART_MOUTH:
-	case ObjectTypes::BPART_TORSO:
-		maxFoodAvailable = static_cast<BodyPart*>(pOther->userPointer_)->getFoodValue();
+	case ObjectTypes::BPART_TORSO: {
+		auto pPart = static_cast<BodyPart*>(pOther->userPointer_);
+		usedBuffer_ += pPart->takeFoodValue(getSwallowLimit(size, pPart->getFoodValue()));
 		break;
+	}
 	case ObjectTypes::BPART_ZYGOTE:
 		ERROR("Implement zygote eating - must check it's not owner - or have smell or something");
 		break;
 	default:
 		ERROR("Mouth can't handle object type "<<(int)pOther->userObjectType_)
 	};
+}
 
-	// compute food amount that will be transfered:
-	float maxSwallow = min(maxFoodAvailable, maxSwallowRatio * maxFoodAvailable); // how much mass could we swallow if buffer allowed it?
+float Mouth::getSwallowLimit(glm::vec2 otherSize, float foodAvailable) const {
+	float maxSwallowRatio = min(1.f, width_ / max(max(width_, otherSize.x), otherSize.y));
+	float maxSwallow = min(foodAvailable, maxSwallowRatio * foodAvailable); // how much mass could we swallow if buffer allowed it?
 	float bufferAvail = bufferSize_ - usedBuffer_;
-	float actualFoodAmountTransferred = min(bufferAvail, maxSwallow);
-	usedBuffer_ += actualFoodAmountTransferred;
-
-	// LOGLN("eat " << (int)pOther->userObjectType_ << " in amount: " << actualFoodAmountTransferred);
+	return max(0.f, min(bufferAvail, maxSwallow));
+}
 
-	// consume the food:
-	switch (pOther->userObjectType_) {
-	case ObjectTypes::FOOD_CHUNK: {
-		static_cast<FoodChunk*>(pOther->userPointer_)->consume(actualFoodAmountTransferred);
-		break;
-	case ObjectTypes::BPART_BONE:
-	case ObjectTypes::BPART_EGGLAYER:
-	case ObjectTypes::BPART_GRIPPER:
-	case ObjectTypes::BPART_MOUTH:
-	case ObjectTypes::BPART_TORSO:
-		static_cast<BodyPart*>(pOther->userPointer_)->consumeFoodValue(actualFoodAmountTransferred);
-		break;
-	}
-	default:
-		ERROR("Mouth can't handle object type "<<(int)pOther->userObjectType_)
-	};
+void Mouth::eatFoodParticles() {
+	FoodParticles &particles = world_->getFoodParticles();
+	if (!particles.size())
+		return;
+	glm::vec3 transform = getWorldTransformation();
+	glm::vec2 pos = vec3xy(transform);
+	glm::vec2 halfSize(length_ * 0.5f, width_ * 0.5f);
+	particles.query(pos, glm::length(halfSize), [&] (unsigned i) {
+		// exact test against the mouth's box, in the mouth's frame:
+		glm::vec2 local = glm::rotate(particles.getPosition(i) - pos, -transform.z);
+		glm::vec2 outside = local - glm::clamp(local, -halfSize, halfSize);
+		float radius = particles.getRadius(i);
+		if (glm::dot(outside, outside) > radius * radius)
+			return;
+		FoodChunk* chunk = particles.getChunk(i);
+		if (!chunk->isZombie())
+			usedBuffer_ += chunk->takeMass(getSwallowLimit(glm::vec2(2 * radius), chunk->getMassLeft()));
+	});
 }
 
 void Mouth::update(float dt) {
 	PERF_MARKER_FUNC;
 	if (isDead())
 		return;
+	// the food particles don't collide with us, we must look for them:
+	if (committed_)
+		eatFoodParticles();
 	if (usedBuffer_ > 0)
 		usedBuffer_ -= parent_->addFood(usedBuffer_);
 }
@@ -10,8 +10,6 @@
 
 #include "BodyPart.h"
 
-class b2WeldJoint;
-
 struct MouthInitializationData : public BodyPartInitializationData {
 	virtual ~MouthInitializationData() noexcept = default;
 	MouthInitializationData();
@@ -21,7 +19,7 @@ struct MouthInitializationData : public BodyPartInitializationData {
 
 class Mouth: public BodyPart {
 public:
-	Mouth();
+	Mouth(World* world);
 	virtual ~Mouth() override;
 
 	glm::vec2 getChildAttachmentPoint(float relativeAngle) override;
@@ -33,12 +31,15 @@ protected:
 	float width_;
 	float bufferSize_;
 	float usedBuffer_;
-	b2WeldJoint* pJoint;
 	int onCollisionEventHandle;
 
 	void cacheInitializationData() override;
 	void commit() override;
 	void onCollision(PhysicsBody* pOther, float impulseMagnitude);
+	// returns how much food the mouth and its buffer allow to take out of what's available in an object of the given size;
+	// nothing is taken yet, the caller adds to usedBuffer_ what it actually gets
+	float getSwallowLimit(glm::vec2 otherSize, float foodAvailable) const;
+	void eatFoodParticles();
 	void onAddedToParent() override;
 	void die() override;
 };
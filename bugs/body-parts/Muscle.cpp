@@ -81,8 +81,8 @@ float Muscle::getInputVMSCoord(unsigned index) const {
 		return 0;
 }
 
-Muscle::Muscle()
-	: BodyPart(BodyPartType::MUSCLE, std::make_shared<MuscleInitializationData>())
+Muscle::Muscle(World* world)
+	: BodyPart(world, BodyPartType::MUSCLE, std::make_shared<MuscleInitializationData>())
 	, inputSocket_(new InputSocket(nullptr, 1.f))
 	, aspectRatio_(1.f)
 	, maxForce_(0)
@@ -132,7 +132,7 @@ void Muscle::onAddedToParent() {
 
 void Muscle::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (joint_) {
 		// here we compute the characteristics of the muscle
@@ -249,7 +249,7 @@ void Muscle::commit() {
 glm::vec2 Muscle::getChildAttachmentPoint(float relativeAngle) {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::getInstance()->assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
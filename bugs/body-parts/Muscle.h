@@ -27,7 +27,7 @@ struct MuscleInitializationData : public BodyPartInitializationData {
 class Muscle: public BodyPart, public IMotor {
 public:
 	// the position and rotation in props are relative to the parent:
-	Muscle();
+	Muscle(World* world);
 	virtual ~Muscle() override;
 
 	void setJoint(Joint* joint, int motorDirSign);
@@ -28,8 +28,8 @@
 
 static const glm::vec3 debug_color(1.f, 1.f, 0.f);
 
-Torso::Torso()
-	: BodyPart(BodyPartType::TORSO, std::make_shared<BodyPartInitializationData>())
+Torso::Torso(World* world)
+	: BodyPart(world, BodyPartType::TORSO, std::make_shared<BodyPartInitializationData>())
 	, fatMass_(0)
 	, lastCommittedTotalSizeInv_(0)
 	, frameUsedEnergy_(0)
@@ -54,10 +54,10 @@ void Torso::onAddedToParent() {
 
 void Torso::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	if (committed_) {
-		physBody_.b2Body_->DestroyFixture(&physBody_.b2Body_->GetFixtureList()[0]);
+		physBody_.b2Body_->DestroyFixture(physBody_.getFixture());
 	}
 
 	float fakeFatMass = fatMass_;
@@ -117,7 +117,7 @@ glm::vec2 Torso::getChildAttachmentPoint(float relativeAngle)
 {
 	if (!geneValuesCached_) {
 #ifdef DEBUG
-		World::getInstance()->assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 		cacheInitializationData();
 	}
@@ -154,7 +154,7 @@ void Torso::update(float dt) {
 		float crtSize = fatMass_ * BodyConst::FatDensityInv + size_;
 		if (crtSize * lastCommittedTotalSizeInv_ > BodyConst::SizeThresholdToCommit
 				|| crtSize * lastCommittedTotalSizeInv_ < BodyConst::SizeThresholdToCommit_inv) {
-			World::getInstance()->queueDeferredAction([this] {
+			world_->queueDeferredAction([this] {
 				commit();
 				reattachChildren();
 			});
@@ -171,7 +171,7 @@ void Torso::update(float dt) {
 void Torso::die() {
 	// if this was ever alive, do a final commit to update its size to the cached mass
 	if (committed_) {
-		World::getInstance()->queueDeferredAction([this] {
+		world_->queueDeferredAction([this] {
 			commit();
 		});
 	}
@@ -202,7 +202,7 @@ void Torso::detachMotorLines(std::vector<unsigned> const& lines) {
 
 void Torso::detach(bool die) {
 #ifdef DEBUG
-		World::getInstance()->assertOnMainThread();
+		world_->assertOnMainThread();
 #endif
 	motorLines_.clear(); // because we don't want any line detached. And we don't need to track them either
 	BodyPart::detach(die);
@@ -16,7 +16,7 @@ class Mouth;
 
 class Torso : public BodyPart {
 public:
-	Torso();
+	Torso(World* world);
 	~Torso() override;
 
 	void draw(RenderContext const& ctx) override;
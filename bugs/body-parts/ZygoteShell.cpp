@@ -24,8 +24,8 @@
 
 const glm::vec3 debug_color(0.5f, 0.5f, 0.5f);
 
-ZygoteShell::ZygoteShell(glm::vec2 position, glm::vec2 velocity, float mass)
-	: BodyPart(BodyPartType::ZYGOTE_SHELL, std::make_shared<BodyPartInitializationData>())
+ZygoteShell::ZygoteShell(World* world, glm::vec2 position, glm::vec2 velocity, float mass)
+	: BodyPart(world, BodyPartType::ZYGOTE_SHELL, std::make_shared<BodyPartInitializationData>())
 	, mass_(mass)
 	, dead_(false)
 {
@@ -41,8 +41,8 @@ ZygoteShell::ZygoteShell(glm::vec2 position, glm::vec2 velocity, float mass)
 	cachedProps_.position = position;
 	cachedProps_.velocity = velocity;
 
-	World::getInstance()->queueDeferredAction([this]() {
-		physBody_.create(cachedProps_);
+	world_->queueDeferredAction([this]() {
+		physBody_.create(world_, cachedProps_);
 		commit();
 		committed_ = true;
 	});
@@ -53,7 +53,7 @@ ZygoteShell::~ZygoteShell() {
 
 void ZygoteShell::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
 	b2CircleShape shape;
 	shape.m_p.Set(0, 0);
@@ -31,8 +31,8 @@ const glm::vec3 debug_color(1.f, 0.8f, 0.f);
 
 #define DEBUG_DRAW_NOSE
 
-Nose::Nose()
-	: BodyPart(BodyPartType::SENSOR_PROXIMITY, std::make_shared<NoseInitializationData>())
+Nose::Nose(World* world)
+	: BodyPart(world, BodyPartType::SENSOR_PROXIMITY, std::make_shared<NoseInitializationData>())
 {
 	for (uint i=0; i<getOutputCount(); i++)
 		outputSocket_[i] = new OutputSocket();
@@ -43,6 +43,7 @@ Nose::Nose()
 	auto data = std::dynamic_pointer_cast<NoseInitializationData>(getInitializationData());
 	for (uint i=0; i<NoseDetectableFlavoursCount; i++)
 		registerAttribute(GENE_ATTRIB_SENSOR_OUTPUT_COORD, i, data->outputVMSCoord[i]);
+	weldedToParent_ = true;
 }
 
 Nose::~Nose() {
@@ -132,7 +133,7 @@ void Nose::update(float dt) {
 		static thread_local std::vector<Entity*> ents;
 		ents.clear();
 //TODO optimize here - restrict box to area in fron of the nose
-		World::getInstance()->getEntitiesInBox(ents, NoseDetectableFlavours[i], Entity::FunctionalityFlags::DONT_CARE, pos, maxDist * 1.1f, true);
+		world_->getEntitiesInBox(ents, NoseDetectableFlavours[i], Entity::FunctionalityFlags::DONT_CARE, pos, maxDist * 1.1f, true);
 
 		// use all entities in the visibility cone (where cos(phi)>0)
 		float cummulatedSignal = 0.f;
@@ -184,14 +185,9 @@ float Nose::getOutputVMSCoord(unsigned index) const {
 
 void Nose::commit() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	world_->assertOnMainThread();
 #endif
-	if (committed_ && !noFixtures_) {
-		physBody_.b2Body_->DestroyFixture(
-				&physBody_.b2Body_->GetFixtureList()[0]);
-		physBody_.b2Body_->GetWorld()->DestroyJoint(pJoint);
-		pJoint = nullptr;
-	}
+	destroyWeldedFixture();
 
 	// create fixture:
 	b2PolygonShape shape;
@@ -217,16 +213,7 @@ void Nose::commit() {
 	fixDef.restitution = 0.3f;
 	fixDef.shape = &shape;
 
-	physBody_.b2Body_->CreateFixture(&fixDef);
-
-	b2WeldJointDef jdef;
-	jdef.bodyA = parent_->getBody().b2Body_;
-	jdef.bodyB = physBody_.b2Body_;
-	glm::vec2 parentAnchor = parent_->getChildAttachmentPoint(attachmentDirectionParent_);
-	jdef.localAnchorA = g2b(parentAnchor);
-	glm::vec2 childAnchor = getChildAttachmentPoint(PI - localRotation_);
-	jdef.localAnchorB = g2b(childAnchor);
-	pJoint = (b2WeldJoint*) physBody_.b2Body_->GetWorld()->CreateJoint(&jdef);
+	createWeldedFixture(fixDef);
 }
 
 
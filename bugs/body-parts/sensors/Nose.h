@@ -26,11 +26,9 @@ struct NoseInitializationData : public BodyPartInitializationData {
 	CummulativeValue outputVMSCoord[NoseDetectableFlavoursCount]; // output nerve VMS coordinate
 };
 
-class b2WeldJoint;
-
 class Nose : public BodyPart, public ISensor {
 public:
-	Nose();
+	Nose(World* world);
 	~Nose() override;
 
 	void draw(RenderContext const& ctx) override;
@@ -45,7 +43,6 @@ public:
 
 protected:
 	OutputSocket* outputSocket_[NoseDetectableFlavoursCount];
-	b2WeldJoint* pJoint = nullptr;
 
 	void commit() override;
 	void die() override;
@@ -11,6 +11,7 @@
 #include "../genetics/GeneDefinitions.h"
 #include "../genetics/constants.h"
 #include "../genetics/Ribosome.h"
+#include "../genetics/PhenotypeCache.h"
 #include "../neuralnet/functions.h"
 #include "../math/math3D.h"
 #include "../math/aabb.h"
@@ -21,6 +22,7 @@
 #include "../body-parts/BodyPart.h"
 #include "../body-parts/Joint.h"
 #include "../World.h"
+#include "../session/LineageLog.h"
 #include "../serialization/BinaryStream.h"
 #include "../serialization/GenomeSerialization.h"
 #include "../renderOpenGL/Viewport.h"
@@ -45,13 +47,21 @@
 const float DECODE_FREQUENCY = 5.f; // genes per second
 const float DECODE_PERIOD = 1.f / DECODE_FREQUENCY; // seconds
 
-std::atomic<int> Bug::population {0};
-std::atomic<int> Bug::maxGeneration {0};
-std::atomic<int> Bug::freeZygotes {0};
 std::atomic<uint64_t> Bug::nextId {1};
 
-Bug::Bug(Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 velocity, unsigned generation)
-	: genome_(genome)
+void* Bug::operator new(size_t size) {
+	static ObjectPool::Context context(ObjectPool::Policy::ReuseSlots);
+	return ObjectPool::allocate(size, context);
+}
+
+void Bug::operator delete(void* p, size_t size) {
+	ObjectPool::free(p, size);
+}
+
+Bug::Bug(World* world, Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 velocity, unsigned generation,
+		uint64_t parent1, uint64_t parent2)
+	: Entity(world)
+	, genome_(genome)
 	, neuralNet_(new NeuralNet())
 	, ribosome_(nullptr)
 	, isAlive_(true)
@@ -75,12 +85,13 @@ Bug::Bug(Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 v
 	LOGLN("new embryo [id="<<id<<"]; printing chromosomes:");
 	LOGLN("C1: " << genome.first.stringify());
 	LOGLN("C2: " << genome.second.stringify());
+	ObjectPool::Scope poolScope(partsPool_);
 	// create embryo shell:
-	zygoteShell_ = new ZygoteShell(position, velocity, zygoteMass);
+	zygoteShell_ = new ZygoteShell(world, position, velocity, zygoteMass);
 	// zygote mass determines the overall bug size after decoding -> must have equal overal mass
 	zygoteShell_->setUpdateList(bodyPartsUpdateList_);
 
-	body_ = new Torso();
+	body_ = new Torso(world);
 	zygoteShell_->add(body_, 0);
 	body_->onFoodProcessed.add(std::bind(&Bug::onFoodProcessed, this, std::placeholders::_1));
 	body_->onMotorLinesDetached.add(std::bind(&Bug::onMotorLinesDetached, this, std::placeholders::_1));
@@ -97,12 +108,17 @@ Bug::Bug(Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 v
 
 	ribosome_->addDefaultSensor(&lifeTimeSensor_);
 
-	if (generation_ > maxGeneration)
-		maxGeneration = generation_;
-	freeZygotes++;
+	World::PopulationStats &stats = world->getPopulationStats();
+	if ((int)generation_ > stats.maxGeneration)
+		stats.maxGeneration = generation_;
+	stats.freeZygotes++;
+
+	if (LineageLog* lineage = world->getLineageLog())
+		lineage->recordBirth(id, parent1, parent2, generation_, PhenotypeCache::hashKey(PhenotypeCache::makeKey(genome_)));
 }
 
 Bug::~Bug() {
+	bodyArena_.clear();
 	if (zygoteShell_) {
 		zygoteShell_->destroy();
 		zygoteShell_ = nullptr;
@@ -125,13 +141,18 @@ void Bug::updateEmbryonicDevelopment(float dt) {
 	tRibosomeStep_ += dt;
 	if (tRibosomeStep_ >= DECODE_PERIOD) {
 		tRibosomeStep_ -= DECODE_PERIOD;
-		isDeveloping_ = ribosome_->step();
+		{
+			ObjectPool::Scope poolScope(partsPool_);	// for the new body parts
+			isDeveloping_ = ribosome_->step();
+		}
 		if (!isDeveloping_) {	// finished development
-			freeZygotes--;
+			getWorld()->getPopulationStats().freeZygotes--;
 			if (!isAlive_) {
 				// embryo not viable, discarded.
 				LOGLN("Embryo not viable. DISCARDED.");
-				World::getInstance()->queueDeferredAction([this] {
+				if (LineageLog* lineage = getWorld()->getLineageLog())
+					lineage->recordDeath(id, LineageLog::DeathCause::NOT_VIABLE, 0, zygoteShell_->getMass());
+				getWorld()->queueDeferredAction([this] {
 					zygoteShell_->die_tree();
 					body_->detach(false);
 					body_->destroy();
@@ -141,7 +162,7 @@ void Bug::updateEmbryonicDevelopment(float dt) {
 #warning "this will live forever"
 			}
 
-			population++; // new member of the bug population
+			getWorld()->getPopulationStats().population++; // new member of the bug population
 
 			float currentMass = body_->getMass_tree();
 			float zygMass = zygoteShell_->getMass();
@@ -158,10 +179,11 @@ void Bug::updateEmbryonicDevelopment(float dt) {
 			body_->commit_tree(cachedLeanMass_/currentMass);
 
 			// delete embryo shell
-			World::getInstance()->queueDeferredAction([this] {
+			getWorld()->queueDeferredAction([this] {
 				body_->detach(false);
 				zygoteShell_->destroy();
 				zygoteShell_ = nullptr;
+				bodyArena_.build(body_);
 			});
 
 			delete ribosome_;
@@ -169,7 +191,7 @@ void Bug::updateEmbryonicDevelopment(float dt) {
 
 			body_->applyRecursive([this](BodyPart* part) {
 				part->onDied.add([this](BodyPart *dying) {
-					World::getInstance()->queueDeferredAction([this, dying] {
+					getWorld()->queueDeferredAction([this, dying] {
 						dying->removeAllLinks();
 					});
 					deadBodyParts_.push_back(dying);
@@ -201,7 +223,7 @@ void Bug::updateDeadDecaying(float dt) {
 			continue;
 		deadBodyParts_[i]->consumeFoodValue(dt * WorldConst::BodyDecaySpeed);
 		if (deadBodyParts_[i]->getFoodValue() <= 0) {
-			World::getInstance()->queueDeferredAction([this, i] {
+			getWorld()->queueDeferredAction([this, i] {
 				deadBodyParts_[i]->destroy();
 				bodyPartsUpdateList_.remove(deadBodyParts_[i]);
 				deadBodyParts_[i] = nullptr;
@@ -211,11 +233,14 @@ void Bug::updateDeadDecaying(float dt) {
 }
 
 void Bug::kill() {
-	World::getInstance()->queueDeferredAction([this] {
+	getWorld()->queueDeferredAction([this] {
 		if (isAlive_) {
 			LOGLN("bug DIED");
-			--population; // one less bug
+			--getWorld()->getPopulationStats().population; // one less bug
+			if (LineageLog* lineage = getWorld()->getLineageLog())	// starvation is the only way to die for now
+				lineage->recordDeath(id, LineageLog::DeathCause::STARVATION, lifeTimeSensor_.getTime(), getMass());
 			isAlive_ = false;
+			bodyArena_.clear();
 			body_->die_tree();
 			body_ = nullptr;
 		}
@@ -365,20 +390,24 @@ void Bug::onMotorLinesDetached(std::vector<unsigned> const& lines) {
 #endif
 }
 
-Bug* Bug::newBasicBug(glm::vec2 position) {
-	Genome g;
-	g.first = g.second = createBasicChromosome(); // make a duplicate of all genes into the second chromosome
-	return new Bug(g, 2*BodyConst::initialEggMass, position, glm::vec2(0), 1);
+Bug* Bug::newBasicBug(World* world, glm::vec2 position) {
+	PERF_MARKER_FUNC;
+	return new Bug(world, createBasicGenome(), 2*BodyConst::initialEggMass, position, glm::vec2(0), 1);
 }
 
-Bug* Bug::newBasicMutantBug(glm::vec2 position) {
+Bug* Bug::newBasicMutantBug(World* world, glm::vec2 position) {
+	PERF_MARKER_FUNC;
 	LOGPREFIX("newBasicMutantBug");
-	Genome g;
-	g.first = g.second = createBasicChromosome();
+	return new Bug(world, createBasicMutantGenome(), 2*BodyConst::initialEggMass, position, glm::vec2(0), 1);
+}
+
+Genome Bug::createBasicMutantGenome() {
+	PERF_MARKER_FUNC;
+	Genome g = createBasicGenome();
 	GeneticOperations::alterChromosome(g.first);
 	GeneticOperations::alterChromosome(g.second);
 	GeneticOperations::fixGenesSynchro(g);
-	return new Bug(g, 2*BodyConst::initialEggMass, position, glm::vec2(0), 1);
+	return g;
 }
 
 glm::vec2 Bug::getVelocity() {
@@ -407,7 +436,7 @@ void Bug::serialize(BinaryStream &stream) {
 	stream << genome_;
 }
 
-void Bug::deserialize(BinaryStream &stream) {
+void Bug::deserialize(BinaryStream &stream, World &world) {
 	if (stream.getSize() == 0)
 		return; // this was a dead bug
 	float posx, posy, velx, vely, mass;
@@ -416,8 +445,8 @@ void Bug::deserialize(BinaryStream &stream) {
 	stream >> generation;
 	Genome genome;
 	stream >> genome;
-	std::unique_ptr<Bug> ptr(new Bug(genome, mass, glm::vec2(posx, posy), glm::vec2(velx, vely), generation));
-	World::getInstance()->takeOwnershipOf(std::move(ptr));
+	std::unique_ptr<Bug> ptr(new Bug(&world, genome, mass, glm::vec2(posx, posy), glm::vec2(velx, vely), generation));
+	world.takeOwnershipOf(std::move(ptr));
 }
 
 float Bug::getNeuronData(int neuronIndex) {
@@ -14,9 +14,11 @@
 #include "../genetics/Genome.h"
 #include "../genetics/GeneDefinitions.h"
 #include "../genetics/CummulativeValue.h"
+#include "../body-parts/BodyPartArena.h"
 #include "../serialization/objectTypes.h"
 #include "../utils/UpdateList.h"
 #include "../utils/bitFlags.h"
+#include "../utils/ObjectPool.h"
 #include "../math/aabb.h"
 
 #include <glm/fwd.hpp>
@@ -41,8 +43,14 @@ public:
 		static constexpr float lifetimeSensor_vmsCoord = 500;
 	};
 
-	explicit Bug(Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 velocity, unsigned generation);
+	// [parent1] and [parent2] are the ids of the bugs that spawned the two gametes (zero for bugs created otherwise)
+	explicit Bug(World* world, Genome const &genome, float zygoteMass, glm::vec2 position, glm::vec2 velocity, unsigned generation,
+			uint64_t parent1 = 0, uint64_t parent2 = 0);
 	virtual ~Bug();
+
+	// pooled, in a context of their own
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
 	FunctionalityFlags getFunctionalityFlags() const override { return
 			FunctionalityFlags::UPDATABLE |
 			FunctionalityFlags::DRAWABLE |
@@ -54,7 +62,7 @@ public:
 	aabb getAABB() const override;
 
 	// deserialize a Bug from the stream and add it to the world
-	static void deserialize(BinaryStream &stream);
+	static void deserialize(BinaryStream &stream, World &world);
 	void serialize(BinaryStream &stream) override;
 
 	void update(float dt) override;
@@ -74,15 +82,21 @@ public:
 	/**
 	 * creates a new basic bug out of a default genome
 	 */
-	static Bug* newBasicBug(glm::vec2 position);
+	static Bug* newBasicBug(World* world, glm::vec2 position);
 	/**
 	 * creates a mutant descendant from the default bug genome
 	 */
-	static Bug* newBasicMutantBug(glm::vec2 position);
+	static Bug* newBasicMutantBug(World* world, glm::vec2 position);
+	/**
+	 * the genomes used by the two functions above (no World needed)
+	 */
+	static Genome createBasicGenome();
+	static Genome createBasicMutantGenome();
+	/**
+	 * the immutable default chromosome, built once; basic genomes share its genes copy-on-write
+	 */
+	static Chromosome const& getBasicChromosome();
 
-	static int getPopulationCount() { return population.load(std::memory_order_relaxed); }
-	static int getZygotesCount() { return freeZygotes.load(std::memory_order_relaxed); }
-	static int getMaxGeneration() { return maxGeneration.load(std::memory_order_relaxed); }
 	uint64_t getId() { return id; }
 
 protected:
@@ -102,7 +116,9 @@ protected:
 	bool isAlive_;
 	bool isDeveloping_;
 	float tRibosomeStep_; // time since last ribosome step
+	ObjectPool::Context partsPool_;	// the bug's body parts are allocated here, to keep them together
 	Torso* body_;
+	BodyPartArena bodyArena_;	// the parts of the developed body_, laid out for linear walks
 	ZygoteShell* zygoteShell_;
 	UpdateList bodyPartsUpdateList_;
 	float growthMassBuffer_;	// stores processed food to be used for growth (at the speed dictated by genes)
@@ -121,9 +137,6 @@ protected:
 	CummulativeValue eggMass_;
 
 	unsigned generation_=0;  // the generation this bug represents
-	static std::atomic<int> population;
-	static std::atomic<int> freeZygotes;
-	static std::atomic<int> maxGeneration;
 
 	friend class Ribosome;
 
@@ -16,6 +16,7 @@ public:
 	virtual ~LifetimeSensor();
 
 	void update(float dt);
+	float getTime() const { return time_; }
 
 	// ISensor::
 	unsigned getOutputCount() const override { return 1; }
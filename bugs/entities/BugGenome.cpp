@@ -15,6 +15,22 @@
 
 #include <map>
 
+Genome Bug::createBasicGenome() {
+	Genome g;
+	g.first = g.second = getBasicChromosome(); // both chromosomes share the template's gene segments until they're altered
+	return g;
+}
+
+/*
+ * The default chromosome is built only once (createBasicChromosome() is quite expensive) and is never modified
+ * afterwards; all the basic genomes share its gene segments, which are copied only when a genome is altered.
+ * Thread-safe, the template is built by the first caller.
+ */
+Chromosome const& Bug::getBasicChromosome() {
+	static const Chromosome basicChromosome = createBasicChromosome();
+	return basicChromosome;
+}
+
 Chromosome Bug::createBasicChromosome() {
 	Chromosome c;
 
@@ -1519,7 +1535,7 @@ Chromosome Bug::createBasicChromosome() {
 		int padding = 2;
 		for (uint i=0; i<c.genes.size(); i+=padding+1) {
 			for (int k=0; k<padding; k++)
-				c.genes.insert(c.genes.begin()+i+1, GeneNoOp());
+				c.genes.insert(i+1, GeneNoOp());
 			if (c.genes[i].type == gene_type::SKIP) {
 				c.genes[i].data.gene_skip.count.set(c.genes[i].data.gene_skip.count * (padding+1));
 			}
@@ -24,7 +24,7 @@ void Entity::destroy() {
 		return;
 	}
 	if (managed_)
-		World::getInstance()->destroyEntity(this);
+		world_->destroyEntity(this);
 	else
 		delete this;
 }
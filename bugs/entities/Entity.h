@@ -16,6 +16,7 @@
 
 class RenderContext;
 class BinaryStream;
+class World;
 enum class SerializationObjectTypes;
 struct aabb;
 
@@ -46,10 +47,15 @@ public:
 	void destroy();
 	bool isZombie() const { return markedForDeletion_.load(std::memory_order_acquire); }
 
+	// the world this entity lives in (may be null for entities that were never added to a world)
+	World* getWorld() const { return world_; }
+
 protected:
 	Entity() = default;
+	explicit Entity(World* world) : world_(world) {}
 
 private:
+	World* world_ = nullptr;
 	std::atomic<bool> markedForDeletion_ {false};
 	bool managed_ = false;
 	friend class World;
@@ -17,6 +17,7 @@
 #include "Bug.h"
 
 #include "../utils/log.h"
+#include "../utils/ObjectPool.h"
 #include "../perf/marker.h"
 
 #include <Box2D/Box2D.h>
@@ -29,15 +30,26 @@
 static const glm::vec3 debug_color(0.1f, 0.4f, 1.f);
 static const int UPDATE_PERIOD = 10; // [frames]
 
-Gamete::Gamete(Chromosome &ch, glm::vec2 pos, glm::vec2 speed, float mass)
-	: chromosome_(ch)
+void* Gamete::operator new(size_t size) {
+	static ObjectPool::Context context(ObjectPool::Policy::ReuseSlots);
+	return ObjectPool::allocate(size, context);
+}
+
+void Gamete::operator delete(void* p, size_t size) {
+	ObjectPool::free(p, size);
+}
+
+Gamete::Gamete(World* world, Chromosome &ch, glm::vec2 pos, glm::vec2 speed, float mass)
+	: Entity(world)
+	, chromosome_(ch)
 	, body_(ObjectTypes::GAMETE, this,
 			EventCategoryFlags::GAMETE | EventCategoryFlags::FOOD,	// TODO handle mouth collision properly (from Mouth)
 			EventCategoryFlags::GAMETE)
+	, mass_(mass)
 {
-	World::getInstance()->queueDeferredAction([this, pos, speed, mass]() {
+	world->queueDeferredAction([this, world, pos, speed, mass]() {
 		PhysicsProperties props(pos, 0, true, speed, 0);
-		body_.create(props);
+		body_.create(world, props);
 		body_.getEntityFunc_ = &getEntityFromGametePhysBody;
 
 		float size = mass * BodyConst::ZygoteDensityInv;
@@ -66,6 +78,14 @@ void Gamete::onCollision(PhysicsBody* pOther, float impulse) {
 		return;
 	if ((uint)abs((int)other->getChromosome().genes.size() - (int)chromosome_.genes.size()) > WorldConst::MaxGenomeLengthDifference)
 		return;
+	// both gametes get this event, on different threads; the lower one does the fusion, and only if it can claim both
+	// (each of them may be touching other gametes too):
+	if (other < this || !claimForFusion())
+		return;
+	if (!other->claimForFusion()) {
+		fusionClaimed_.store(false, std::memory_order_release);
+		return;
+	}
 	LOGLN("gametes fused -> new bug embryo !!!");
 	Genome g;
 	// combine the two chromosomes into a single genome
@@ -78,16 +98,21 @@ void Gamete::onCollision(PhysicsBody* pOther, float impulse) {
 			+ other->body_.b2Body_->GetMass() * other->body_.b2Body_->GetLinearVelocity());
 	velocity *= 1.f / (body_.b2Body_->GetMass() + other->body_.b2Body_->GetMass());
 	// now create the zygote:
-	std::unique_ptr<Bug> newlySpawnedBug(new Bug(g,
+	std::unique_ptr<Bug> newlySpawnedBug(new Bug(getWorld(), g,
 			body_.b2Body_->GetMass() + other->body_.b2Body_->GetMass(),
 			(body_.getPosition() + other->body_.getPosition()) * 0.5f, b2g(velocity),
-			std::max(generation_, other->generation_)));
-	World::getInstance()->takeOwnershipOf(std::move(newlySpawnedBug));
+			std::max(generation_, other->generation_), parentId_, other->parentId_));
+	getWorld()->takeOwnershipOf(std::move(newlySpawnedBug));
 	// destroy these gamettes:
 	destroy();
 	other->destroy();
 }
 
+bool Gamete::claimForFusion() {
+	bool expect = false;
+	return fusionClaimed_.compare_exchange_strong(expect, true, std::memory_order_acq_rel, std::memory_order_relaxed);
+}
+
 void Gamete::update(float dt) {
 	PERF_MARKER_FUNC;
 	if (isZombie())
@@ -96,8 +121,8 @@ void Gamete::update(float dt) {
 		return;
 	updateSkipCounter_ = 0;
 	// attract other gamettes
-	std::vector<b2Body*> bodies;
-	World::getInstance()->getBodiesInArea(body_.getPosition(), WorldConst::GameteAttractRadius, true, bodies);
+	FrameVector<b2Body*> bodies;
+	getWorld()->getBodiesInArea(body_.getPosition(), WorldConst::GameteAttractRadius, true, bodies);
 	for (auto b : bodies) {
 		if (!b->GetUserData() || b->GetType() != b2_dynamicBody)
 			continue;
@@ -143,7 +168,7 @@ void Gamete::serialize(BinaryStream &stream) {
 	//TODO...
 }
 
-void Gamete::deserialize(BinaryStream &stream) {
+void Gamete::deserialize(BinaryStream &stream, World &world) {
 	//TODO...
 }
 
@@ -15,20 +15,26 @@
 #include "../serialization/objectTypes.h"
 #include "../utils/bitFlags.h"
 
+#include <atomic>
+
 #define DEBUG_DRAW_GAMETE
 
 class Gamete: public Entity {
 public:
-	Gamete(Chromosome &ch, glm::vec2 pos, glm::vec2 speed, float mass);
+	Gamete(World* world, Chromosome &ch, glm::vec2 pos, glm::vec2 speed, float mass);
 	virtual ~Gamete();
 
+	// pooled, in a context of their own
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+
 	static constexpr EntityType entityType = EntityType::GAMETE;
 	EntityType getEntityType() const override { return entityType; }
 	glm::vec3 getWorldTransform() const override;
 	aabb getAABB() const override;
 
 	// deserialize a Gamete from the stream and add it to the world
-	static void deserialize(BinaryStream &stream);
+	static void deserialize(BinaryStream &stream, World &world);
 
 #ifdef DEBUG_DRAW_GAMETE
 	FunctionalityFlags getFunctionalityFlags() const override { return
@@ -46,15 +52,20 @@ public:
 	SerializationObjectTypes getSerializationType() override { return SerializationObjectTypes::GAMETE; }
 
 	const Chromosome& getChromosome() const { return chromosome_; }
+	float getMass() const { return mass_; }
 
 	unsigned generation_=0;  // the generation of the bug who spawned this gamete
+	uint64_t parentId_=0;	// the id of the bug who spawned this gamete (zero if unknown)
 
 protected:
 	Chromosome chromosome_;
 	PhysicsBody body_;
+	float mass_;
 	int updateSkipCounter_ = 0;
+	std::atomic<bool> fusionClaimed_ {false};	// taken by the gamete that fuses this one
 
 	void onCollision(PhysicsBody* pOther, float impulse);
+	bool claimForFusion();
 
 private:
 	static Entity* getEntityFromGametePhysBody(PhysicsBody const& body);
@@ -16,8 +16,9 @@
 #include <dmalloc.h>
 #endif
 
-Wall::Wall(glm::vec2 const &from, glm::vec2 const &to, float width)
-	: body_(ObjectTypes::WALL, this, EventCategoryFlags::STATIC, 0)
+Wall::Wall(World* world, glm::vec2 const &from, glm::vec2 const &to, float width)
+	: Entity(world)
+	, body_(ObjectTypes::WALL, this, EventCategoryFlags::STATIC, 0)
 	, from_(from)
 	, to_(to)
 	, width_(width)
@@ -27,8 +28,8 @@ Wall::Wall(glm::vec2 const &from, glm::vec2 const &to, float width)
 	float angle = pointDirectionNormalized(delta / length);
 	PhysicsProperties props((from + to)*0.5f, angle, false, glm::vec2(0), 0);
 
-	World::getInstance()->queueDeferredAction([this, props, length, width]() {
-		body_.create(props);
+	world->queueDeferredAction([this, world, props, length, width]() {
+		body_.create(world, props);
 		body_.getEntityFunc_ = &getEntityFromWallPhysBody;
 
 		b2PolygonShape shp;
@@ -44,11 +45,11 @@ Wall::Wall(glm::vec2 const &from, glm::vec2 const &to, float width)
 Wall::~Wall() {
 }
 
-void Wall::deserialize(BinaryStream &stream) {
+void Wall::deserialize(BinaryStream &stream, World &world) {
 	glm::vec2 from, to;
 	float width;
 	stream >> from.x >> from.y >> to.x >> to.y >> width;
-	World::getInstance()->takeOwnershipOf(std::unique_ptr<Wall>(new Wall(from, to, width)));
+	world.takeOwnershipOf(std::unique_ptr<Wall>(new Wall(&world, from, to, width)));
 }
 
 void Wall::serialize(BinaryStream &stream) {
@@ -16,7 +16,7 @@
 
 class Wall : public Entity {
 public:
-	Wall(glm::vec2 const &from, glm::vec2 const &to, float width);
+	Wall(World* world, glm::vec2 const &from, glm::vec2 const &to, float width);
 	virtual ~Wall();
 
 	FunctionalityFlags getFunctionalityFlags() const override {
@@ -30,7 +30,7 @@ public:
 
 	SerializationObjectTypes getSerializationType() override { return SerializationObjectTypes::WALL; }
 	// deserialize a Wall from the stream and add it to the world
-	static void deserialize(BinaryStream &stream);
+	static void deserialize(BinaryStream &stream, World &world);
 	void serialize(BinaryStream &stream) override;
 
 protected:
@@ -22,12 +22,20 @@ public:
 	static constexpr float FoodDispenserSpawnVelocity			= 0.3f;				// [m/s]
 	static constexpr float FoodDispenserSpawnMass				= 60.e-3f;			// [kg]
 	static constexpr float FoodDispenserSpreadAngleHalf			= PI;				// [rad]
+	static constexpr float FoodParticleMaxMass					= 20.e-3f;			// [kg] lighter chunks are particles rather than rigid bodies
+	static constexpr float FoodParticleRestSpeed				= 0.02f;			// [m/s] slower chunks are at rest and become particles
+	static constexpr float FoodParticleDamping					= 0.3f;				// [1/s] linear damping of the particles (same as the bodies')
+	static constexpr float FoodParticleRestitution				= 0.3f;				// [*] for bouncing off the world bounds
 
 	static constexpr float GameteAttractRadius					= 10;				// [m]
 	static constexpr float GameteAttractForceFactor				= 30;				// force between 2 1kg gametes [N]
 	static constexpr unsigned MaxGenomeLengthDifference			= 10;				// max length difference that is still compatible
 
 	static constexpr float BodyDecaySpeed						= 2.e-3f;			// [kg/s] speed at which mass is lost from dead bodies
+
+	static constexpr float IdleBodyRestSpeed					= 0.1f;				// [m/s] slower food bodies far from the bugs are put to sleep
+	static constexpr float IdleBodyRestAngularSpeed				= 0.2f;				// [rad/s]
+	static constexpr float IdleBodyWakeDistance					= 2.f;				// [m] from a living bug's AABB
 };
 
 #endif /* OBJECTS_WORLDCONST_H_ */
@@ -14,24 +14,63 @@
 #include "../../renderOpenGL/Shape3D.h"
 
 #include "../../perf/marker.h"
+#include "../../utils/ObjectPool.h"
 
 #include <Box2D/Box2D.h>
 
-FoodChunk::FoodChunk(glm::vec2 position, float angle, glm::vec2 velocity, float angularVelocity, float mass)
-	: physBody_(ObjectTypes::FOOD_CHUNK, this, EventCategoryFlags::FOOD, 0)
+void* FoodChunk::operator new(size_t size) {
+	static ObjectPool::Context context(ObjectPool::Policy::ReuseSlots);
+	return ObjectPool::allocate(size, context);
+}
+
+void FoodChunk::operator delete(void* p, size_t size) {
+	ObjectPool::free(p, size);
+}
+
+FoodChunk::FoodChunk(World* world, glm::vec2 position, float angle, glm::vec2 velocity, float angularVelocity, float mass)
+	: Entity(world)
+	, physBody_(ObjectTypes::FOOD_CHUNK, this, EventCategoryFlags::FOOD, 0)
 	, size_(mass * WorldConst::FoodChunkDensityInv)
 	, initialMass_(mass)
 	, amountLeft_(mass)
 {
 	PhysicsProperties props(position, angle, true, velocity, angularVelocity);
 
-	World::getInstance()->queueDeferredAction([this, props]() {
-		physBody_.create(props);
+	world->queueDeferredAction([this, world, props]() {
+		if (world->getFoodParticles().isEnabled() && initialMass_ < WorldConst::FoodParticleMaxMass) {
+			// small enough to not need a body at all
+			becomeParticle(props.position, props.velocity);
+			return;
+		}
 		physBody_.getEntityFunc_ = &getEntityFromFoodChunkPhysBody;
+		physBody_.recycleFunc_ = [world] (b2Body* body) {
+			world->getFoodChunkPool().release(body);
+		};
+		float sensorRadius = sqrtf(size_ * WorldConst::FoodChunkSensorRatio * PI_INV);
+		float kernelRadius = getRadius();
+
+		if (b2Body* body = world->getFoodChunkPool().acquire()) {
+			// a recycled body: resize the fixtures if needed (chunks from the same dispenser have the same size)
+			physBody_.adopt(world, body, props);
+			bool resized = false;
+			for (b2Fixture* fix = body->GetFixtureList(); fix; fix = fix->GetNext()) {
+				b2Shape* shp = fix->GetShape();
+				float radius = fix->IsSensor() ? sensorRadius : kernelRadius;
+				resized |= shp->m_radius != radius;
+				shp->m_radius = radius;
+			}
+			if (resized)
+				body->ResetMassData();
+			body->SetActive(true);
+			body->SetAwake(true);
+			return;
+		}
+
+		physBody_.create(world, props);
 
 		// now create the sensor fixture
 		b2CircleShape shp;
-		shp.m_radius = sqrtf(size_ * WorldConst::FoodChunkSensorRatio * PI_INV);
+		shp.m_radius = sensorRadius;
 		b2FixtureDef fdef;
 		fdef.density = 0;
 		fdef.shape = &shp;
@@ -39,7 +78,7 @@ FoodChunk::FoodChunk(glm::vec2 position, float angle, glm::vec2 velocity, float
 		physBody_.b2Body_->CreateFixture(&fdef);
 
 		// and the kernel fixture:
-		shp.m_radius = sqrtf(size_ * PI_INV);
+		shp.m_radius = kernelRadius;
 		b2FixtureDef fdefK;
 		fdefK.density = WorldConst::FoodChunkDensity;
 		fdefK.friction = 0.2f;
@@ -52,11 +91,28 @@ FoodChunk::FoodChunk(glm::vec2 position, float angle, glm::vec2 velocity, float
 
 FoodChunk::~FoodChunk() {
 	onDestroy.trigger(this);
+	if (particleIndex_ >= 0) {
+		FoodChunk* moved = getWorld()->getFoodParticles().remove(particleIndex_);
+		if (moved)
+			moved->particleIndex_ = particleIndex_;
+	}
+}
+
+float FoodChunk::getRadius() const {
+	return sqrtf(size_ * PI_INV);
+}
+
+void FoodChunk::becomeParticle(glm::vec2 position, glm::vec2 velocity) {
+#ifdef DEBUG
+	getWorld()->assertOnMainThread();
+#endif
+	physBody_.destroyBody();	// the body goes back to the pool
+	particleIndex_ = getWorld()->getFoodParticles().add(this, position, velocity, getRadius());
 }
 
 #ifdef DEBUG_DRAW_FOOD_CHUNK
 void FoodChunk::draw(RenderContext const& ctx) {
-	Shape3D::get()->drawCircleXOY(physBody_.getPosition(),
+	Shape3D::get()->drawCircleXOY(vec3xy(getWorldTransform()),
 			sqrtf(amountLeft_.load(std::memory_order_relaxed)*PI_INV*WorldConst::FoodChunkDensityInv),
 					8, glm::vec3(1.f, 0.5f, 0.f));
 }
@@ -65,6 +121,17 @@ void FoodChunk::draw(RenderContext const& ctx) {
 void FoodChunk::update(float dt) {
 	PERF_MARKER_FUNC;
 	consume(dt * WorldConst::FoodChunkDecaySpeed);
+	if (physBody_.b2Body_ && !becomingParticle_ && getWorld()->getFoodParticles().isEnabled()) {
+		b2Vec2 velocity = physBody_.b2Body_->GetLinearVelocity();
+		if (velocity.LengthSquared() < WorldConst::FoodParticleRestSpeed * WorldConst::FoodParticleRestSpeed
+				|| getMassLeft() < WorldConst::FoodParticleMaxMass) {
+			// came to rest or got small: the rigid body is not needed anymore
+			becomingParticle_ = true;
+			getWorld()->queueDeferredAction([this] {
+				becomeParticle(b2g(physBody_.b2Body_->GetPosition()), b2g(physBody_.b2Body_->GetLinearVelocity()));
+			});
+		}
+	}
 }
 
 void FoodChunk::consume(float massAmount) {
@@ -75,8 +142,23 @@ void FoodChunk::consume(float massAmount) {
 		destroy();
 }
 
+float FoodChunk::takeMass(float maxMass) {
+	float prev = amountLeft_.load(std::memory_order_relaxed);
+	float taken;
+	do {
+		taken = max(0.f, min(maxMass, prev));
+		if (taken == 0)
+			return 0;
+	} while (!amountLeft_.compare_exchange_weak(prev, prev-taken, std::memory_order_acq_rel, std::memory_order_relaxed));
+	if (taken == prev)
+		destroy();
+	return taken;
+}
+
 glm::vec3 FoodChunk::getWorldTransform() const {
-	if (physBody_.b2Body_) {
+	if (particleIndex_ >= 0)
+		return glm::vec3(getWorld()->getFoodParticles().getPosition(particleIndex_), 0);
+	else if (physBody_.b2Body_) {
 		auto pos = physBody_.b2Body_->GetPosition();
 		return glm::vec3(b2g(pos), physBody_.b2Body_->GetAngle());
 	} else
@@ -90,5 +172,10 @@ Entity* FoodChunk::getEntityFromFoodChunkPhysBody(PhysicsBody const& body) {
 }
 
 aabb FoodChunk::getAABB() const {
+	if (particleIndex_ >= 0) {
+		glm::vec2 pos = getWorld()->getFoodParticles().getPosition(particleIndex_);
+		float r = getRadius();
+		return aabb(pos - glm::vec2(r), pos + glm::vec2(r));
+	}
 	return physBody_.getAABB();
 }
@@ -20,8 +20,12 @@
 
 class FoodChunk: public Entity {
 public:
-	FoodChunk(glm::vec2 position, float angle, glm::vec2 velocity, float angularVelocity, float mass);
+	FoodChunk(World* world, glm::vec2 position, float angle, glm::vec2 velocity, float angularVelocity, float mass);
 	virtual ~FoodChunk() override;
+
+	// pooled, in a context of their own
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
 	FunctionalityFlags getFunctionalityFlags() const override { return
 			FunctionalityFlags::UPDATABLE |
 			FunctionalityFlags::DRAWABLE;
@@ -40,9 +44,17 @@ public:
 	float getInitialMass() const { return initialMass_; }
 	float getMassLeft() const { return amountLeft_.load(std::memory_order_relaxed); }
 	void consume(float massAmount);
+	// atomically takes up to [maxMass] out of the chunk and returns the amount actually taken;
+	// thread safe - several mouths may be eating the same chunk
+	float takeMass(float maxMass);
 
 	Event<void(FoodChunk*)> onDestroy;
 
+	// true if the chunk is simulated as a particle (see FoodParticles) rather than as a rigid body
+	bool isParticle() const { return particleIndex_ >= 0; }
+	// the radius of the solid part of the chunk
+	float getRadius() const;
+
 protected:
 	PhysicsBody physBody_;
 	float size_;
@@ -50,7 +62,12 @@ protected:
 	std::atomic<float> amountLeft_;
 
 private:
+	int particleIndex_ = -1;		// in the world's FoodParticles
+	bool becomingParticle_ = false;
+
 	static Entity* getEntityFromFoodChunkPhysBody(PhysicsBody const& body);
+	// moves the chunk from its rigid body into the world's food particles
+	void becomeParticle(glm::vec2 position, glm::vec2 velocity);
 };
 
 #endif /* OBJECTS_FOOD_FOODCHUNK_H_ */
@@ -0,0 +1,52 @@
+/*
+ * FoodChunkPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "FoodChunkPool.h"
+
+#include "../../perf/counters.h"
+
+#include <Box2D/Box2D.h>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+constexpr unsigned FoodChunkPool::MaxParked;
+
+// where the parked bodies are kept; inactive bodies are still drawn by the physics debug draw
+static const b2Vec2 parkingPosition(1.e6f, 1.e6f);
+
+b2Body* FoodChunkPool::acquire() {
+	static perf::Counters::counter_type &hits = perf::Counters::get("food-pool-hits");
+	static perf::Counters::counter_type &misses = perf::Counters::get("food-pool-misses");
+	if (parked_.empty()) {
+		misses.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	hits.fetch_add(1, std::memory_order_relaxed);
+	b2Body* body = parked_.back();
+	parked_.pop_back();
+	return body;
+}
+
+void FoodChunkPool::release(b2Body* body) {
+	if (parked_.size() >= MaxParked) {
+		body->GetWorld()->DestroyBody(body);
+		return;
+	}
+	// deactivating removes the body from the broadphase and destroys its contacts:
+	body->SetActive(false);
+	body->SetUserData(nullptr);
+	body->SetTransform(parkingPosition, 0);
+	parked_.push_back(body);
+}
+
+void FoodChunkPool::clear() {
+	for (b2Body* body : parked_)
+		body->GetWorld()->DestroyBody(body);
+	parked_.clear();
+}
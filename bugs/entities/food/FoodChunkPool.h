@@ -0,0 +1,44 @@
+/*
+ * FoodChunkPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef ENTITIES_FOOD_FOODCHUNKPOOL_H_
+#define ENTITIES_FOOD_FOODCHUNKPOOL_H_
+
+#include <vector>
+#include <cstddef>
+
+class b2Body;
+
+/*
+ * Recycles the Box2D bodies of a world's food chunks: when a chunk is destroyed its b2Body (with its fixtures) is
+ * deactivated and parked here instead of being destroyed, and the next chunk created takes it over instead of creating
+ * a new body and fixtures.
+ * At most MaxParked bodies are kept; beyond that they are destroyed as usual.
+ * Main thread only (the chunks take and return their bodies in deferred actions and destructors).
+ */
+class FoodChunkPool {
+public:
+	static constexpr unsigned MaxParked = 256;
+
+	FoodChunkPool() = default;
+	FoodChunkPool(FoodChunkPool const&) = delete;
+	~FoodChunkPool() { clear(); }
+
+	// returns a parked (inactive) body, or nullptr if there's none; counts the pool hits and misses
+	b2Body* acquire();
+	// deactivates the body and parks it for reuse
+	void release(b2Body* body);
+	// destroys all the parked bodies
+	void clear();
+
+	size_t getParkedCount() const { return parked_.size(); }
+
+private:
+	std::vector<b2Body*> parked_;
+};
+
+#endif /* ENTITIES_FOOD_FOODCHUNKPOOL_H_ */
@@ -18,8 +18,9 @@
 #include <glm/gtx/rotate_vector.hpp>
 #include <Box2D/Box2D.h>
 
-FoodDispenser::FoodDispenser(glm::vec2 const &position, float direction)
-	: radius_(sqrtf(WorldConst::FoodDispenserSize * PI_INV))
+FoodDispenser::FoodDispenser(World* world, glm::vec2 const &position, float direction)
+	: Entity(world)
+	, radius_(sqrtf(WorldConst::FoodDispenserSize * PI_INV))
 	, position_(position)
 	, direction_(direction)
 	, period_(WorldConst::FoodDispenserPeriod)
@@ -34,8 +35,8 @@ FoodDispenser::FoodDispenser(glm::vec2 const &position, float direction)
 
 	PhysicsProperties props(position, direction, false, glm::vec2(0), 0);
 
-	World::getInstance()->queueDeferredAction([this, props]() {
-		physBody_.create(props);
+	world->queueDeferredAction([this, world, props]() {
+		physBody_.create(world, props);
 		// create fixture
 		b2CircleShape shp;
 		shp.m_radius = radius_;
@@ -62,8 +63,8 @@ void FoodDispenser::update(float dt) {
 		float randomAngle = srandf() * WorldConst::FoodDispenserSpreadAngleHalf;
 		offset = glm::rotate(offset, direction_ + randomAngle);
 		glm::vec2 velocity = glm::normalize(offset) * spawnVelocity_;
-		std::unique_ptr<FoodChunk> chunk(new FoodChunk(position_ + offset, direction_+randomAngle, velocity, 0, spawnMass_));
-		World::getInstance()->takeOwnershipOf(std::move(chunk));
+		std::unique_ptr<FoodChunk> chunk(new FoodChunk(getWorld(), position_ + offset, direction_+randomAngle, velocity, 0, spawnMass_));
+		getWorld()->takeOwnershipOf(std::move(chunk));
 	}
 }
 
@@ -72,11 +73,11 @@ void FoodDispenser::serialize(BinaryStream &stream) {
 	stream << pos.x << pos.y << direction_;
 }
 
-void FoodDispenser::deserialize(BinaryStream &stream) {
+void FoodDispenser::deserialize(BinaryStream &stream, World &world) {
 	glm::vec2 pos;
 	float dir;
 	stream >> pos.x >> pos.y >> dir;
-	World::getInstance()->takeOwnershipOf(std::unique_ptr<FoodDispenser>(new FoodDispenser(pos, dir)));
+	world.takeOwnershipOf(std::unique_ptr<FoodDispenser>(new FoodDispenser(&world, pos, dir)));
 }
 
 glm::vec3 FoodDispenser::getWorldTransform() const {
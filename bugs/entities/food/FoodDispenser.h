@@ -16,7 +16,7 @@
 
 class FoodDispenser: public Entity {
 public:
-	FoodDispenser(glm::vec2 const &position, float direction);
+	FoodDispenser(World* world, glm::vec2 const &position, float direction);
 	virtual ~FoodDispenser();
 
 	static constexpr EntityType entityType = EntityType::FOOD_DISPENSER;
@@ -31,7 +31,7 @@ public:
 
 	SerializationObjectTypes getSerializationType() override { return SerializationObjectTypes::FOOD_DISPENSER; }
 	// deserialize a dispenser from the stream and add it to the world
-	static void deserialize(BinaryStream &stream);
+	static void deserialize(BinaryStream &stream, World &world);
 	void serialize(BinaryStream &stream) override;
 
 
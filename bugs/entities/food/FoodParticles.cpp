@@ -0,0 +1,139 @@
+/*
+ * FoodParticles.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "FoodParticles.h"
+#include "../WorldConst.h"
+
+#include "../../perf/marker.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+constexpr float FoodParticles::CellSize;
+constexpr unsigned FoodParticles::MaxGridCells;
+
+void FoodParticles::setBounds(aabb const& bounds) {
+	bounds_ = bounds;
+	glm::vec2 size = bounds.vMax - bounds.vMin;
+	cellSize_ = CellSize;
+	while ((size.x / cellSize_ + 1) * (size.y / cellSize_ + 1) > MaxGridCells)
+		cellSize_ *= 2;
+	gridW_ = std::max(1, (int)std::ceil(size.x / cellSize_));
+	gridH_ = std::max(1, (int)std::ceil(size.y / cellSize_));
+	gridValid_ = false;
+}
+
+unsigned FoodParticles::add(FoodChunk* chunk, glm::vec2 pos, glm::vec2 velocity, float radius) {
+	posX_.push_back(pos.x);
+	posY_.push_back(pos.y);
+	velX_.push_back(velocity.x);
+	velY_.push_back(velocity.y);
+	radius_.push_back(radius);
+	chunks_.push_back(chunk);
+	return chunks_.size() - 1;
+}
+
+FoodChunk* FoodParticles::remove(unsigned index) {
+	unsigned last = chunks_.size() - 1;
+	FoodChunk* moved = nullptr;
+	if (index != last) {
+		posX_[index] = posX_[last];
+		posY_[index] = posY_[last];
+		velX_[index] = velX_[last];
+		velY_[index] = velY_[last];
+		radius_[index] = radius_[last];
+		chunks_[index] = moved = chunks_[last];
+	}
+	posX_.pop_back();
+	posY_.pop_back();
+	velX_.pop_back();
+	velY_.pop_back();
+	radius_.pop_back();
+	chunks_.pop_back();
+	gridValid_ = false;	// the indices have changed
+	return moved;
+}
+
+void FoodParticles::clear() {
+	posX_.clear();
+	posY_.clear();
+	velX_.clear();
+	velY_.clear();
+	radius_.clear();
+	chunks_.clear();
+	cellItems_.clear();
+	gridValid_ = false;
+}
+
+void FoodParticles::update(float dt) {
+	PERF_MARKER_FUNC;
+	unsigned n = chunks_.size();
+	// same damping as the rigid bodies get from Box2D:
+	float damping = 1.f / (1.f + dt * WorldConst::FoodParticleDamping);
+	float* px = posX_.data(), *py = posY_.data();
+	float* vx = velX_.data(), *vy = velY_.data();
+	const float* r = radius_.data();
+	for (unsigned i=0; i<n; i++) {
+		vx[i] *= damping;
+		vy[i] *= damping;
+		px[i] += vx[i] * dt;
+		py[i] += vy[i] * dt;
+	}
+	// bounce off the bounds:
+	const float bounce = -WorldConst::FoodParticleRestitution;
+	for (unsigned i=0; i<n; i++) {
+		if (px[i] - r[i] < bounds_.vMin.x) {
+			px[i] = bounds_.vMin.x + r[i];
+			vx[i] *= bounce;
+		} else if (px[i] + r[i] > bounds_.vMax.x) {
+			px[i] = bounds_.vMax.x - r[i];
+			vx[i] *= bounce;
+		}
+		if (py[i] - r[i] < bounds_.vMin.y) {
+			py[i] = bounds_.vMin.y + r[i];
+			vy[i] *= bounce;
+		} else if (py[i] + r[i] > bounds_.vMax.y) {
+			py[i] = bounds_.vMax.y - r[i];
+			vy[i] *= bounce;
+		}
+	}
+	rebuildGrid();
+}
+
+int FoodParticles::cellX(float x) const {
+	return std::min(gridW_ - 1, std::max(0, (int)std::floor((x - bounds_.vMin.x) / cellSize_)));
+}
+
+int FoodParticles::cellY(float y) const {
+	return std::min(gridH_ - 1, std::max(0, (int)std::floor((y - bounds_.vMin.y) / cellSize_)));
+}
+
+void FoodParticles::rebuildGrid() {
+	// counting sort of the particles by cell:
+	unsigned n = chunks_.size();
+	unsigned nCells = gridW_ * gridH_;
+	cellStart_.assign(nCells + 1, 0);
+	particleCell_.resize(n);
+	maxRadius_ = 0;
+	for (unsigned i=0; i<n; i++) {
+		unsigned c = cellY(posY_[i]) * gridW_ + cellX(posX_[i]);
+		particleCell_[i] = c;
+		cellStart_[c+1]++;
+		maxRadius_ = std::max(maxRadius_, radius_[i]);
+	}
+	for (unsigned c=0; c<nCells; c++)
+		cellStart_[c+1] += cellStart_[c];
+	cellItems_.resize(n);
+	cellCursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+	for (unsigned i=0; i<n; i++)
+		cellItems_[cellCursor_[particleCell_[i]]++] = i;
+	gridValid_ = nCells > 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * FoodParticles.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef ENTITIES_FOOD_FOODPARTICLES_H_
+#define ENTITIES_FOOD_FOODPARTICLES_H_
+
+#include "../../math/aabb.h"
+
+#include <glm/vec2.hpp>
+#include <vector>
+
+class FoodChunk;
+
+/*
+ * Food chunks that don't need to be rigid bodies - the small ones and the ones that have come to rest - are kept here
+ * as particles, in flat arrays (one per attribute), and moved with simple integration and drag, bouncing off the
+ * world bounds; they don't collide with anything, which leaves Box2D with the bugs, the walls and the few chunks still
+ * rolling around.
+ * Mouths find the particles they overlap through a uniform grid that's rebuilt on every update.
+ *
+ * Adding, removing and updating are main-thread only; queries are read-only and may run from the parallel update.
+ * Particles added after the last update are not found by queries until the next one; removing a particle
+ * invalidates the grid until the next update.
+ */
+class FoodParticles {
+public:
+	static constexpr float CellSize = 0.5f;				// [m] size of a grid cell
+	static constexpr unsigned MaxGridCells = 1 << 20;	// the cells get bigger if the bounds are too large for this
+
+	FoodParticles() = default;
+	FoodParticles(FoodParticles const&) = delete;
+
+	void setEnabled(bool enabled) { enabled_ = enabled; }
+	bool isEnabled() const { return enabled_; }
+	// the particles are kept within these
+	void setBounds(aabb const& bounds);
+
+	// returns the index of the new particle
+	unsigned add(FoodChunk* chunk, glm::vec2 pos, glm::vec2 velocity, float radius);
+	// removes the particle by moving the last one in its place; returns the chunk of the moved particle (which now
+	// has this index), or nullptr if the removed particle was the last
+	FoodChunk* remove(unsigned index);
+	void clear();
+
+	// moves the particles and rebuilds the grid
+	void update(float dt);
+
+	unsigned size() const { return chunks_.size(); }
+	glm::vec2 getPosition(unsigned index) const { return glm::vec2(posX_[index], posY_[index]); }
+	glm::vec2 getVelocity(unsigned index) const { return glm::vec2(velX_[index], velY_[index]); }
+	float getRadius(unsigned index) const { return radius_[index]; }
+	FoodChunk* getChunk(unsigned index) const { return chunks_[index]; }
+
+	// calls f(index) for each particle that overlaps the circle
+	template<class F>
+	void query(glm::vec2 center, float radius, F &&f) const;
+
+private:
+	bool enabled_ = false;
+	aabb bounds_ {glm::vec2(0), glm::vec2(0)};
+
+	std::vector<float> posX_, posY_;
+	std::vector<float> velX_, velY_;
+	std::vector<float> radius_;
+	std::vector<FoodChunk*> chunks_;
+
+	// grid: the particles of cell c are cellItems_[cellStart_[c] .. cellStart_[c+1])
+	float cellSize_ = CellSize;
+	int gridW_ = 0, gridH_ = 0;
+	std::vector<unsigned> cellStart_;
+	std::vector<unsigned> cellItems_;
+	std::vector<unsigned> particleCell_;	// scratch, the cell of each particle
+	std::vector<unsigned> cellCursor_;		// scratch, where the next particle of each cell goes
+	float maxRadius_ = 0;					// of the particles in the grid
+	bool gridValid_ = false;
+
+	int cellX(float x) const;
+	int cellY(float y) const;
+	void rebuildGrid();
+};
+
+template<class F>
+void FoodParticles::query(glm::vec2 center, float radius, F &&f) const {
+	if (!gridValid_ || cellItems_.empty())
+		return;
+	// a particle is in the cell of its center, so look as far as the biggest particle reaches:
+	float reach = radius + maxRadius_;
+	int x0 = cellX(center.x - reach), x1 = cellX(center.x + reach);
+	int y0 = cellY(center.y - reach), y1 = cellY(center.y + reach);
+	for (int y=y0; y<=y1; y++)
+		for (int x=x0; x<=x1; x++) {
+			unsigned c = y * gridW_ + x;
+			for (unsigned k=cellStart_[c]; k<cellStart_[c+1]; k++) {
+				unsigned i = cellItems_[k];
+				float dx = posX_[i] - center.x, dy = posY_[i] - center.y;
+				float r = radius + radius_[i];
+				if (dx*dx + dy*dy <= r*r)
+					f(i);
+			}
+		}
+}
+
+#endif /* ENTITIES_FOOD_FOODPARTICLES_H_ */
@@ -35,6 +35,13 @@ struct CummulativeValue {
 		factor_ *= factor;
 		cacheUpdated_ = false;
 	}
+	// adds all the changes accumulated into [other] to this value
+	inline void merge(CummulativeValue const& other) {
+		value_ += other.value_;
+		n_ += other.n_;
+		factor_ *= other.factor_;
+		cacheUpdated_ = false;
+	}
 	inline void reset(float initialValue) {
 		*this = CummulativeValue(initialValue);
 	}
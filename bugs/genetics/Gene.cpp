@@ -1,5 +1,6 @@
 #include "Gene.h"
 #include "../utils/log.h"
+#include "../utils/assert.h"
 #include "../body-parts/BodyConst.h"
 #include "../body-parts/BodyPart.h"
 #include "../neuralnet/functions.h"
@@ -9,96 +10,98 @@
 #include <dmalloc.h>
 #endif
 
-void Gene::update_meta_genes_vec() {
-	metaGenes.clear();
-	// add meta-genes to this vector to enable their mutation:
-	metaGenes.push_back(&chance_to_delete);
-	metaGenes.push_back(&chance_to_swap);
+unsigned Gene::getMetaGenes(MetaGene* (&out)[MaxMetaGenes]) {
+	unsigned n = 0;
+	// add meta-genes here to enable their mutation:
+	out[n++] = &chance_to_delete;
+	out[n++] = &chance_to_swap;
 
 	switch (type) {
 	case gene_type::PROTEIN:
-		metaGenes.push_back(&data.gene_protein.maxDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_protein.maxDepth.changeAmount);
-		metaGenes.push_back(&data.gene_protein.minDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_protein.minDepth.changeAmount);
-		metaGenes.push_back(&data.gene_protein.protein.chanceToMutate);
-		metaGenes.push_back(&data.gene_protein.protein.changeAmount);
-		metaGenes.push_back(&data.gene_protein.targetSegment.chanceToMutate);
-		metaGenes.push_back(&data.gene_protein.targetSegment.changeAmount);
+		out[n++] = &data.gene_protein.maxDepth.chanceToMutate;
+		out[n++] = &data.gene_protein.maxDepth.changeAmount;
+		out[n++] = &data.gene_protein.minDepth.chanceToMutate;
+		out[n++] = &data.gene_protein.minDepth.changeAmount;
+		out[n++] = &data.gene_protein.protein.chanceToMutate;
+		out[n++] = &data.gene_protein.protein.changeAmount;
+		out[n++] = &data.gene_protein.targetSegment.chanceToMutate;
+		out[n++] = &data.gene_protein.targetSegment.changeAmount;
 		break;
 	case gene_type::OFFSET:
-		metaGenes.push_back(&data.gene_offset.maxDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_offset.maxDepth.changeAmount);
-		metaGenes.push_back(&data.gene_offset.minDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_offset.minDepth.changeAmount);
-		metaGenes.push_back(&data.gene_offset.offset.chanceToMutate);
-		metaGenes.push_back(&data.gene_offset.offset.changeAmount);
-		metaGenes.push_back(&data.gene_offset.targetSegment.chanceToMutate);
-		metaGenes.push_back(&data.gene_offset.targetSegment.changeAmount);
+		out[n++] = &data.gene_offset.maxDepth.chanceToMutate;
+		out[n++] = &data.gene_offset.maxDepth.changeAmount;
+		out[n++] = &data.gene_offset.minDepth.chanceToMutate;
+		out[n++] = &data.gene_offset.minDepth.changeAmount;
+		out[n++] = &data.gene_offset.offset.chanceToMutate;
+		out[n++] = &data.gene_offset.offset.changeAmount;
+		out[n++] = &data.gene_offset.targetSegment.chanceToMutate;
+		out[n++] = &data.gene_offset.targetSegment.changeAmount;
 		break;
 	case gene_type::JOINT_OFFSET:
-		metaGenes.push_back(&data.gene_joint_offset.maxDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_joint_offset.maxDepth.changeAmount);
-		metaGenes.push_back(&data.gene_joint_offset.minDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_joint_offset.minDepth.changeAmount);
-		metaGenes.push_back(&data.gene_joint_offset.offset.chanceToMutate);
-		metaGenes.push_back(&data.gene_joint_offset.offset.changeAmount);
+		out[n++] = &data.gene_joint_offset.maxDepth.chanceToMutate;
+		out[n++] = &data.gene_joint_offset.maxDepth.changeAmount;
+		out[n++] = &data.gene_joint_offset.minDepth.chanceToMutate;
+		out[n++] = &data.gene_joint_offset.minDepth.changeAmount;
+		out[n++] = &data.gene_joint_offset.offset.chanceToMutate;
+		out[n++] = &data.gene_joint_offset.offset.changeAmount;
 		break;
 	case gene_type::PART_ATTRIBUTE:
-		metaGenes.push_back(&data.gene_attribute.maxDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_attribute.maxDepth.changeAmount);
-		metaGenes.push_back(&data.gene_attribute.minDepth.chanceToMutate);
-		metaGenes.push_back(&data.gene_attribute.minDepth.changeAmount);
-		metaGenes.push_back(&data.gene_attribute.value.chanceToMutate);
-		metaGenes.push_back(&data.gene_attribute.value.changeAmount);
+		out[n++] = &data.gene_attribute.maxDepth.chanceToMutate;
+		out[n++] = &data.gene_attribute.maxDepth.changeAmount;
+		out[n++] = &data.gene_attribute.minDepth.chanceToMutate;
+		out[n++] = &data.gene_attribute.minDepth.changeAmount;
+		out[n++] = &data.gene_attribute.value.chanceToMutate;
+		out[n++] = &data.gene_attribute.value.changeAmount;
 		break;
 	case gene_type::SYNAPSE:
-		metaGenes.push_back(&data.gene_synapse.from.chanceToMutate);
-		metaGenes.push_back(&data.gene_synapse.from.changeAmount);
-		metaGenes.push_back(&data.gene_synapse.to.chanceToMutate);
-		metaGenes.push_back(&data.gene_synapse.to.changeAmount);
-		metaGenes.push_back(&data.gene_synapse.weight.chanceToMutate);
-		metaGenes.push_back(&data.gene_synapse.weight.changeAmount);
-		metaGenes.push_back(&data.gene_synapse.priority.chanceToMutate);
-		metaGenes.push_back(&data.gene_synapse.priority.changeAmount);
+		out[n++] = &data.gene_synapse.from.chanceToMutate;
+		out[n++] = &data.gene_synapse.from.changeAmount;
+		out[n++] = &data.gene_synapse.to.chanceToMutate;
+		out[n++] = &data.gene_synapse.to.changeAmount;
+		out[n++] = &data.gene_synapse.weight.chanceToMutate;
+		out[n++] = &data.gene_synapse.weight.changeAmount;
+		out[n++] = &data.gene_synapse.priority.chanceToMutate;
+		out[n++] = &data.gene_synapse.priority.changeAmount;
 		break;
 	case gene_type::NEURON_INPUT_COORD:
-		metaGenes.push_back(&data.gene_neuron_input.destNeuronVirtIndex.chanceToMutate);
-		metaGenes.push_back(&data.gene_neuron_input.destNeuronVirtIndex.changeAmount);
-		metaGenes.push_back(&data.gene_neuron_input.inCoord.chanceToMutate);
-		metaGenes.push_back(&data.gene_neuron_input.inCoord.changeAmount);
+		out[n++] = &data.gene_neuron_input.destNeuronVirtIndex.chanceToMutate;
+		out[n++] = &data.gene_neuron_input.destNeuronVirtIndex.changeAmount;
+		out[n++] = &data.gene_neuron_input.inCoord.chanceToMutate;
+		out[n++] = &data.gene_neuron_input.inCoord.changeAmount;
 		break;
 	case gene_type::NEURON_OUTPUT_COORD:
-		metaGenes.push_back(&data.gene_neuron_output.srcNeuronVirtIndex.chanceToMutate);
-		metaGenes.push_back(&data.gene_neuron_output.srcNeuronVirtIndex.changeAmount);
-		metaGenes.push_back(&data.gene_neuron_output.outCoord.chanceToMutate);
-		metaGenes.push_back(&data.gene_neuron_output.outCoord.changeAmount);
+		out[n++] = &data.gene_neuron_output.srcNeuronVirtIndex.chanceToMutate;
+		out[n++] = &data.gene_neuron_output.srcNeuronVirtIndex.changeAmount;
+		out[n++] = &data.gene_neuron_output.outCoord.chanceToMutate;
+		out[n++] = &data.gene_neuron_output.outCoord.changeAmount;
 		break;
 	case gene_type::TRANSFER_FUNC:
-		metaGenes.push_back(&data.gene_transfer_function.targetNeuron.chanceToMutate);
-		metaGenes.push_back(&data.gene_transfer_function.targetNeuron.changeAmount);
-		metaGenes.push_back(&data.gene_transfer_function.functionID.chanceToMutate);
-		metaGenes.push_back(&data.gene_transfer_function.functionID.changeAmount);
+		out[n++] = &data.gene_transfer_function.targetNeuron.chanceToMutate;
+		out[n++] = &data.gene_transfer_function.targetNeuron.changeAmount;
+		out[n++] = &data.gene_transfer_function.functionID.chanceToMutate;
+		out[n++] = &data.gene_transfer_function.functionID.changeAmount;
 		break;
 	case gene_type::NEURAL_BIAS:
-		metaGenes.push_back(&data.gene_neural_constant.targetNeuron.chanceToMutate);
-		metaGenes.push_back(&data.gene_neural_constant.targetNeuron.changeAmount);
-		metaGenes.push_back(&data.gene_neural_constant.value.chanceToMutate);
-		metaGenes.push_back(&data.gene_neural_constant.value.changeAmount);
+		out[n++] = &data.gene_neural_constant.targetNeuron.chanceToMutate;
+		out[n++] = &data.gene_neural_constant.targetNeuron.changeAmount;
+		out[n++] = &data.gene_neural_constant.value.chanceToMutate;
+		out[n++] = &data.gene_neural_constant.value.changeAmount;
 		break;
 	case gene_type::NEURAL_PARAM:
-		metaGenes.push_back(&data.gene_neural_param.targetNeuron.chanceToMutate);
-		metaGenes.push_back(&data.gene_neural_param.targetNeuron.changeAmount);
-		metaGenes.push_back(&data.gene_neural_param.value.chanceToMutate);
-		metaGenes.push_back(&data.gene_neural_param.value.changeAmount);
+		out[n++] = &data.gene_neural_param.targetNeuron.chanceToMutate;
+		out[n++] = &data.gene_neural_param.targetNeuron.changeAmount;
+		out[n++] = &data.gene_neural_param.value.chanceToMutate;
+		out[n++] = &data.gene_neural_param.value.changeAmount;
 		break;
 	case gene_type::BODY_ATTRIBUTE:
-		metaGenes.push_back(&data.gene_body_attribute.value.chanceToMutate);
-		metaGenes.push_back(&data.gene_body_attribute.value.changeAmount);
+		out[n++] = &data.gene_body_attribute.value.chanceToMutate;
+		out[n++] = &data.gene_body_attribute.value.changeAmount;
 		break;
 	default:
 		break;
 	}
+	assertDbg(n <= MaxMetaGenes);
+	return n;
 }
 
 Gene Gene::createRandomBodyAttribGene() {
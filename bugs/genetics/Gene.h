@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <map>
 #include <vector>
+#include <type_traits>
 
 class MetaGene {
 public:
@@ -186,7 +187,6 @@ public:
 		, chance_to_delete(constants::initial_gene_delete, constants::change_gene_delete)
 		, chance_to_swap(constants::initial_gene_swap, constants::change_gene_swap)
 	{
-		update_meta_genes_vec();
 	}
 
 #ifdef ENABLE_START_MARKER_GENES
@@ -209,23 +209,9 @@ public:
 
 	Gene() : Gene(GeneNoOp()) {}
 
-	Gene(const Gene& original)
-		: type(original.type)
-		, data(original.data)
-		, chance_to_delete(original.chance_to_delete)
-		, chance_to_swap(original.chance_to_swap)
-	{
-		update_meta_genes_vec();
-	}
-
-	Gene& operator=(Gene const& right) {
-		type = right.type;
-		data = right.data;
-		chance_to_delete = right.chance_to_delete;
-		chance_to_swap = right.chance_to_swap;
-		update_meta_genes_vec();
-		return *this;
-	}
+	// genes are plain data, copying a chromosome is a single block copy without any allocations per gene
+	Gene(const Gene& original) = default;
+	Gene& operator=(Gene const& right) = default;
 
 	char getSymbol() const;
 
@@ -233,13 +219,18 @@ public:
 	// @nNeurons tells how many neurons the genome creates
 	static Gene createRandom(int spaceLeftAfter, int nNeurons);
 
-	std::vector<MetaGene*> metaGenes;
+	static constexpr unsigned MaxMetaGenes = 10;
+	/**
+	 * fills [out] with pointers to all the meta-genes of this gene that are subject to alteration and returns their count.
+	 * The meta-genes are located from the gene type each time (instead of keeping a vector of pointers in each gene),
+	 * so that genes stay trivially copyable.
+	 */
+	unsigned getMetaGenes(MetaGene* (&out)[MaxMetaGenes]);
 
 	MetaGene chance_to_delete;		// [0..1] represents the likelihood that this gene will disappear completely
 	MetaGene chance_to_swap;		// likelihood that this gene will swap places with an adjacent one
 
 private:
-	void update_meta_genes_vec();
 
 	static Gene createRandomSkipGene(int spaceLeftAfter);
 	static Gene createRandomProteinGene();
@@ -255,4 +246,6 @@ private:
 	static Gene createRandomBodyAttribGene();
 };
 
+static_assert(std::is_trivially_copyable<Gene>::value, "Gene must be trivially copyable");
+
 #endif //__gene_h__
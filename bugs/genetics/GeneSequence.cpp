@@ -0,0 +1,144 @@
+/*
+ * GeneSequence.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "GeneSequence.h"
+#include "../utils/assert.h"
+#include "../perf/counters.h"
+
+#include <algorithm>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+static perf::Counters::counter_type& residentBytes() {
+	static perf::Counters::counter_type &c = perf::Counters::get("genome-bytes-resident");
+	return c;
+}
+
+static perf::Counters::counter_type& logicalBytes() {
+	static perf::Counters::counter_type &c = perf::Counters::get("genome-bytes-logical");
+	return c;
+}
+
+static constexpr int64_t segmentBytes = sizeof(Gene) * GeneSequence::SegmentLength;
+
+GeneSequence::Segment::Segment() {
+	genes.reserve(SegmentLength);
+	residentBytes() += segmentBytes;
+}
+
+GeneSequence::Segment::Segment(Segment const& other) {
+	genes.reserve(SegmentLength);
+	genes = other.genes;
+	residentBytes() += segmentBytes;
+}
+
+GeneSequence::Segment::~Segment() {
+	residentBytes() -= segmentBytes;
+}
+
+GeneSequence::GeneSequence(GeneSequence const& other)
+	: segments_(other.segments_)
+	, size_(other.size_)
+{
+	logicalBytes() += size_ * sizeof(Gene);
+}
+
+GeneSequence::GeneSequence(GeneSequence &&other)
+	: segments_(std::move(other.segments_))
+	, size_(other.size_)
+{
+	other.segments_.clear();
+	other.size_ = 0;
+}
+
+GeneSequence& GeneSequence::operator = (GeneSequence const& other) {
+	if (this != &other) {
+		logicalBytes() += ((int64_t)other.size_ - (int64_t)size_) * (int64_t)sizeof(Gene);
+		segments_ = other.segments_;
+		size_ = other.size_;
+	}
+	return *this;
+}
+
+GeneSequence& GeneSequence::operator = (GeneSequence &&other) {
+	if (this != &other) {
+		logicalBytes() -= size_ * sizeof(Gene);
+		segments_ = std::move(other.segments_);
+		size_ = other.size_;
+		other.segments_.clear();
+		other.size_ = 0;
+	}
+	return *this;
+}
+
+GeneSequence::~GeneSequence() {
+	logicalBytes() -= size_ * sizeof(Gene);
+}
+
+void GeneSequence::clear() {
+	logicalBytes() -= size_ * sizeof(Gene);
+	segments_.clear();
+	size_ = 0;
+}
+
+GeneSequence::Segment& GeneSequence::getMutableSegment(size_t segmentIndex) {
+	assertDbg(segmentIndex < segments_.size());
+	auto &seg = segments_[segmentIndex];
+	if (seg.use_count() > 1)
+		seg = std::make_shared<Segment>(*seg);
+	return *seg;
+}
+
+void GeneSequence::push_back(Gene const& g) {
+	if (size_ % SegmentLength == 0)
+		segments_.push_back(std::make_shared<Segment>());
+	getMutableSegment(segments_.size() - 1).genes.push_back(g);
+	size_++;
+	logicalBytes() += sizeof(Gene);
+}
+
+void GeneSequence::assign(Gene const* genes, size_t count) {
+	clear();
+	segments_.reserve((count + SegmentLength - 1) / SegmentLength);
+	for (size_t i=0; i<count; i+=SegmentLength) {
+		auto seg = std::make_shared<Segment>();
+		seg->genes.assign(genes + i, genes + std::min<size_t>(count, i + SegmentLength));
+		segments_.push_back(std::move(seg));
+	}
+	size_ = count;
+	logicalBytes() += size_ * sizeof(Gene);
+}
+
+void GeneSequence::insert(size_t index, Gene const& g) {
+	assertDbg(index <= size_);
+	if (index == size_) {
+		push_back(g);
+		return;
+	}
+	// grow by one and shift the tail to the right:
+	Gene last = static_cast<GeneSequence const&>(*this)[size_ - 1];
+	push_back(last);
+	for (size_t i = size_ - 2; i > index; i--)
+		(*this)[i] = static_cast<GeneSequence const&>(*this)[i - 1];
+	(*this)[index] = g;
+}
+
+void GeneSequence::appendSegment(GeneSequence const& src, size_t segmentIndex) {
+	assertDbg(size_ % SegmentLength == 0);
+	assertDbg(segmentIndex < src.segments_.size());
+	segments_.push_back(src.segments_[segmentIndex]);
+	size_t count = segments_.back()->genes.size();
+	size_ += count;
+	logicalBytes() += count * sizeof(Gene);
+}
+
+bool GeneSequence::sharesSegment(GeneSequence const& other, size_t segmentIndex) const {
+	return segmentIndex < segments_.size() && segmentIndex < other.segments_.size()
+			&& segments_[segmentIndex] == other.segments_[segmentIndex];
+}
@@ -0,0 +1,96 @@
+/*
+ * GeneSequence.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_GENESEQUENCE_H_
+#define GENETICS_GENESEQUENCE_H_
+
+#include "Gene.h"
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+/*
+ * The sequence of genes of a chromosome.
+ * Genes are stored in fixed-length segments which are reference counted and shared between copies of the sequence;
+ * a segment is copied (materialized) only when one of the sequences that share it needs to modify it (copy-on-write).
+ * Copying a chromosome (bug <- genome <- gametes) is thus cheap, and so are the chromosomes that differ from their
+ * parent only in a few segments.
+ *
+ * Only the non-const accessors materialize segments, so code that only reads genes must access them through a const
+ * reference. The const accessors may be used concurrently from several threads, as long as no thread modifies the
+ * same sequence object.
+ *
+ * The memory used by genes is reported by the perf module in these counters:
+ * 		"genome-bytes-resident" - bytes actually allocated for gene segments
+ * 		"genome-bytes-logical" - bytes that all the sequences would use if nothing were shared
+ */
+class GeneSequence {
+public:
+	static constexpr unsigned SegmentLength = 32;	// number of genes in a segment
+
+	class const_iterator {
+	public:
+		const_iterator(GeneSequence const* seq, size_t index) : seq_(seq), index_(index) {}
+		Gene const& operator * () const { return (*seq_)[index_]; }
+		Gene const* operator -> () const { return &(*seq_)[index_]; }
+		const_iterator& operator ++ () { ++index_; return *this; }
+		bool operator == (const_iterator const& x) const { return index_ == x.index_; }
+		bool operator != (const_iterator const& x) const { return index_ != x.index_; }
+	private:
+		GeneSequence const* seq_;
+		size_t index_;
+	};
+
+	GeneSequence() = default;
+	GeneSequence(GeneSequence const& other);
+	GeneSequence(GeneSequence &&other);
+	GeneSequence& operator = (GeneSequence const& other);
+	GeneSequence& operator = (GeneSequence &&other);
+	~GeneSequence();
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	void reserve(size_t n) { segments_.reserve((n + SegmentLength - 1) / SegmentLength); }
+	void clear();
+
+	Gene const& operator [] (size_t i) const { return segments_[i / SegmentLength]->genes[i % SegmentLength]; }
+	// materializes the segment that contains the gene if it's shared
+	Gene& operator [] (size_t i) { return getMutableSegment(i / SegmentLength).genes[i % SegmentLength]; }
+
+	const_iterator begin() const { return const_iterator(this, 0); }
+	const_iterator end() const { return const_iterator(this, size_); }
+
+	void push_back(Gene const& g);
+	// replaces the contents of the sequence with [count] genes copied from [genes], filling whole segments at once
+	void assign(Gene const* genes, size_t count);
+	// inserts a gene before the one at [index]; all the segments after [index] are materialized
+	void insert(size_t index, Gene const& g);
+
+	// appends the segment [segmentIndex] of [src], sharing it instead of copying the genes.
+	// this sequence's size must be a multiple of SegmentLength.
+	void appendSegment(GeneSequence const& src, size_t segmentIndex);
+
+	size_t getSegmentCount() const { return segments_.size(); }
+	// returns true if both sequences point to the same segment at [segmentIndex]
+	bool sharesSegment(GeneSequence const& other, size_t segmentIndex) const;
+
+private:
+	struct Segment {
+		std::vector<Gene> genes;
+
+		Segment();
+		Segment(Segment const& other);
+		~Segment();
+	};
+
+	std::vector<std::shared_ptr<Segment>> segments_;
+	size_t size_ = 0;
+
+	Segment& getMutableSegment(size_t segmentIndex);
+};
+
+#endif /* GENETICS_GENESEQUENCE_H_ */
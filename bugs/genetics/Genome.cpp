@@ -6,10 +6,12 @@
  */
 
 #include "Genome.h"
+#include "MutationEngine.h"
 #include "../utils/rand.h"
 #include "../utils/log.h"
 #include "../math/math3D.h"
 #include <set>
+#include <algorithm>
 
 #ifdef DEBUG_DMALLOC
 #include <dmalloc.h>
@@ -33,8 +35,18 @@ std::string Chromosome::stringify() const {
 
 Chromosome GeneticOperations::meyosis(const Genome& gen) {
 	Chromosome c;
+	c.genes.reserve(std::max(gen.first.genes.size(), gen.second.genes.size()));
 	unsigned i=0;
 	while (i<gen.first.genes.size() || i<gen.second.genes.size()) {
+		if (i % GeneSequence::SegmentLength == 0) {
+			unsigned segIndex = i / GeneSequence::SegmentLength;
+			if (gen.first.genes.sharesSegment(gen.second.genes, segIndex)) {
+				// both parents have the same genes here, whichever we choose, the result is the same:
+				c.genes.appendSegment(gen.first.genes, segIndex);
+				i = c.genes.size();
+				continue;
+			}
+		}
 		const Gene *g = nullptr;
 		if (i<gen.first.genes.size()) {
 			g = &gen.first.genes[i];
@@ -77,7 +89,11 @@ void GeneticOperations::pullBackInsertions(Chromosome &c, int amount) {
  */
 int GeneticOperations::insertNewGene(Chromosome &c, Chromosome::insertion ins, Gene const& g) {
 	assertDbg(ins.index <= (int)c.genes.size());
-	c.genes.insert(c.genes.begin() + ins.index, g);
+	c.genes.insert(ins.index, g);
+	return recordInsertion(c, ins);
+}
+
+int GeneticOperations::recordInsertion(Chromosome &c, Chromosome::insertion ins) {
 	// determine where in insertions we must add this new index
 	uint d=0;
 	while (d<c.insertions.size() && c.insertions[d].index < ins.index) d++;
@@ -172,208 +188,14 @@ void GeneticOperations::fixGenesSynchro(Genome& gen) {
 void GeneticOperations::alterChromosome(Chromosome &c) {
 	LOGPREFIX("GeneticOperations");
 #define ENABLE_STATS 1
+	MutationEngine::Stats stats = MutationEngine::alterChromosome(c);
 #if(ENABLE_STATS)
-	int stat_mutations = 0;
-	int stat_swaps = 0;
-	int stat_delete = 0;
-	int stat_new = 0;
-#endif
-
-	std::map<int, bool> mapNeuronsExist;
-
-	static constexpr float numberMutationsPerChromosome = 0.125f;	// how many mutations we desire for a chromosome at most, on average
-	static constexpr float numberSwapsPerChromosome = 0.0625f;
-	static constexpr float numberDeletionsPerChromosome = 0.025f;
-
-	// compute the total chance for mutations in the current chromosome:
-	// also count the number of neurons, we need these in order to create new random genes
-	float totalChanceToMutate = 0.f;
-	float totalChanceToSwap = 0.f;
-	float totalChanceToDelete = 0.f;
-	for (unsigned i=0; i<c.genes.size(); i++) {
-		float mutateCh, swapCh, deleteCh;
-		getAlterationChances(c.genes[i], mutateCh, swapCh, deleteCh);
-		totalChanceToMutate += mutateCh;
-		totalChanceToSwap += swapCh;
-		totalChanceToDelete += deleteCh;
-
-		// count
-		switch (c.genes[i].type) {
-		case gene_type::SYNAPSE:
-			if (c.genes[i].data.gene_synapse.from >= 0)
-				mapNeuronsExist[c.genes[i].data.gene_synapse.from] = true;
-			if (c.genes[i].data.gene_synapse.to >= 0)
-				mapNeuronsExist[c.genes[i].data.gene_synapse.to] = true;
-			break;
-		default:
-			break;
-		}
-	}
-	int nNeurons = mapNeuronsExist.size();
-
-	// now we compute a factor to multiply the mutation chances to bring them into the desired range
-	float mutationChanceFactor = std::min(1.f, numberMutationsPerChromosome / totalChanceToMutate);
-	float swapChanceFactor = std::min(1.f, numberSwapsPerChromosome / totalChanceToSwap);
-	float deleteChanceFactor = std::min(1.f, numberDeletionsPerChromosome / totalChanceToDelete);
-
-	// now we go ahead with alterations:
-	for (unsigned i=0; i<c.genes.size(); i++) {
-		bool delGene = randf() < c.genes[i].chance_to_delete.value * deleteChanceFactor;
-		if (delGene) {
-			c.genes[i].type = gene_type::NO_OP;
-#if(ENABLE_STATS)
-			stat_delete++;
-#endif
-			continue;
-		}
-		bool swap = randf() < c.genes[i].chance_to_swap.value * swapChanceFactor;
-		bool swapReverse = false;
-		if (swap) {
-			if (i < c.genes.size()-1) { // swap ahead
-				xchg(c.genes[i], c.genes[i+1]);
-#if(ENABLE_STATS)
-				stat_swaps++;
-#endif
-			} else if (i > 0) { // swap behind
-				xchg(c.genes[i], c.genes[i-1]);
-				swapReverse = true;
-#if(ENABLE_STATS)
-				stat_swaps++;
-#endif
-			}
-		}
-		if (swapReverse) {
-#if(ENABLE_STATS)
-			stat_mutations +=
-#endif
-			alterGene(c.genes[i-1], mutationChanceFactor);
-		} else {
-#if(ENABLE_STATS)
-			stat_mutations +=
-#endif
-			alterGene(c.genes[i], mutationChanceFactor);
-		}
-
-		if (swap && !swapReverse) {
-			// swapped gene has been altered partially (by swapping), so must not go through a complete step again, do the rest here:
-#if(ENABLE_STATS)
-			stat_mutations +=
-#endif
-			alterGene(c.genes[i+1], mutationChanceFactor);
-			i++; // skip the next gene that has already been altered
-		}
-	}
-
-	// now there's a chance to spawn a new gene
-	if (//false && // DEBUG: disable adding new genes
-			randf() < constants::global_chance_to_spawn_gene * c.genes.size()) {
-		int position = randi(c.genes.size()-1);
-		Gene newGene(Gene::createRandom(c.genes.size()-position, nNeurons));
-		if (c.genes[position].type == gene_type::NO_OP)
-			c.genes[position] = newGene;
-		else {
-			// must keep a record of last genes inserted (at most N, and if gametes have a difference of more than N genes, they don't fuse)
-			// when combining two gametes we must insert dummy genes at correspondent positions in the other chromosome, in order to realign the alelles.
-			insertNewGene(c, Chromosome::insertion(position, 0), newGene);
-		}
-#if(ENABLE_STATS)
-		stat_new++;
-#endif
-	}
-
-#if(ENABLE_STATS)
-		LOGLN("alter chromosome: [mutations: "<<stat_mutations<<"] [swaps: "<<stat_swaps<<"] [new: "<<stat_new<<"] [del: "<<stat_delete<<"]");
+		LOGLN("alter chromosome: [mutations: "<<stats.mutations<<"] [swaps: "<<stats.swaps<<"] [new: "<<stats.newGenes<<"] [del: "<<stats.deletions<<"]");
+#else
+	(void)stats;
 #endif
 }
 
-template<typename T>
-bool alterAtom(Atom<T> &a, float mutationChanceFactor) {
-	float chance = a.chanceToMutate.value * mutationChanceFactor;
-	if (chance < constants::global_alteration_override_chance)
-		chance = constants::global_alteration_override_chance;
-	if (randf() < chance) {
-		if (std::is_integral<T>::value) {
-			a.value += (randf()<0.5f) ? +1 : -1;
-		} else {
-			a.value += srandf() * a.changeAmount.value;
-		}
-		return true;
-	} else
-		return false;
-}
-
-int GeneticOperations::alterGene(Gene &g, float mutationChanceFactor) {
-	int altered = 0;
-	switch (g.type) {
-#ifdef ENABLE_START_MARKER_GENES
-	case gene_type::START_MARKER:
-#endif
-	case gene_type::STOP:
-	case gene_type::NO_OP:
-		break;
-	case gene_type::SKIP:
-		altered += alterAtom(g.data.gene_skip.count, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_skip.maxDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_skip.minDepth, mutationChanceFactor);
-		break;
-	case gene_type::BODY_ATTRIBUTE:
-		altered += alterAtom(g.data.gene_body_attribute.value, mutationChanceFactor);
-		break;
-	case gene_type::PROTEIN:
-		altered += alterAtom(g.data.gene_protein.maxDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_protein.minDepth, mutationChanceFactor);
-//		altered += alterAtom(g.data.gene_protein.protein, mutationChanceFactor);
-//		altered += alterAtom(g.data.gene_protein.targetSegment, mutationChanceFactor);
-		break;
-	case gene_type::OFFSET:
-		altered += alterAtom(g.data.gene_offset.maxDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_offset.minDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_offset.offset, mutationChanceFactor);
-//		altered += alterAtom(g.data.gene_offset.targetSegment, mutationChanceFactor);
-		break;
-	case gene_type::NEURON_INPUT_COORD:
-		altered += alterAtom(g.data.gene_neuron_input.destNeuronVirtIndex, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_neuron_input.inCoord, mutationChanceFactor);
-		break;
-	case gene_type::NEURON_OUTPUT_COORD:
-		altered += alterAtom(g.data.gene_neuron_output.srcNeuronVirtIndex, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_neuron_output.outCoord, mutationChanceFactor);
-		break;
-	case gene_type::NEURAL_BIAS:
-		altered += alterAtom(g.data.gene_neural_constant.targetNeuron, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_neural_constant.value, mutationChanceFactor);
-		break;
-	case gene_type::PART_ATTRIBUTE:
-		altered += alterAtom(g.data.gene_attribute.value, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_attribute.minDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_attribute.maxDepth, mutationChanceFactor);
-		break;
-	case gene_type::SYNAPSE:
-		altered += alterAtom(g.data.gene_synapse.from, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_synapse.to, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_synapse.weight, mutationChanceFactor);
-		break;
-	case gene_type::TRANSFER_FUNC:
-		altered += alterAtom(g.data.gene_transfer_function.functionID, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_transfer_function.targetNeuron, mutationChanceFactor);
-		break;
-	case gene_type::JOINT_OFFSET:
-		altered += alterAtom(g.data.gene_joint_offset.offset, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_joint_offset.minDepth, mutationChanceFactor);
-		altered += alterAtom(g.data.gene_joint_offset.maxDepth, mutationChanceFactor);
-		break;
-	default:
-		ERROR("unhandled gene type (alterGene): "<<(uint)g.type);
-		break;
-	}
-
-	for (auto m : g.metaGenes) {
-		alterMetaGene(*m);
-	}
-
-	return altered;
-}
-
 void GeneticOperations::getAlterationChances(Gene const& g, float& mutationCh, float& swapCh, float& deleteCh) {
 	deleteCh = g.chance_to_delete.value;
 	swapCh = g.chance_to_swap.value;
@@ -440,11 +262,3 @@ void GeneticOperations::getAlterationChances(Gene const& g, float& mutationCh, f
 	}
 }
 
-
-void GeneticOperations::alterMetaGene(MetaGene &meta)
-{
-	meta.value += srandf() * meta.dynamic_variation;
-	if (meta.value < 0)
-		meta.value = 0;
-}
-
@@ -10,6 +10,7 @@
 
 #include "../entities/WorldConst.h"
 #include "Gene.h"
+#include "GeneSequence.h"
 #include <vector>
 #include <string>
 #include <utility>
@@ -17,7 +18,7 @@
 class MetaGene;
 
 struct Chromosome {
-	std::vector<Gene> genes;
+	GeneSequence genes;
 	struct insertion {
 		int index = -1;
 		int age = 0;	// in number of generations
@@ -56,11 +57,18 @@ public:
 	 */
 	static void fixGenesSynchro(Genome& gen);
 
-private:
+	/**
+	 * returns the chances (as given by the meta-genes) of the gene's atoms to mutate (sum for all atoms),
+	 * of the gene to swap places and to be deleted.
+	 */
 	static void getAlterationChances(Gene const& g, float& mutationCh, float& swapCh, float& deleteCh);
-	// return number of mutated atoms
-	static int alterGene(Gene &g, float mutationChanceFactor);
-	static void alterMetaGene(MetaGene &m);
+	/**
+	 * records in the chromosome's insertions list that a new gene has been inserted at [ins.index]
+	 * (the gene itself must be inserted by the caller); returns the index in the insertions list.
+	 */
+	static int recordInsertion(Chromosome &c, Chromosome::insertion ins);
+
+private:
 	static void pullBackInsertions(Chromosome &c, int amount);
 	static int insertNewGene(Chromosome &c, Chromosome::insertion ins, Gene const& g);
 	static void trimInsertionList(Chromosome &c);
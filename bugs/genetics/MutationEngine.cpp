@@ -0,0 +1,293 @@
+/*
+ * MutationEngine.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "MutationEngine.h"
+#include "../utils/rand.h"
+#include "../utils/FlatMap.h"
+#include "../math/math3D.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+static constexpr float numberMutationsPerChromosome = 0.125f;	// how many mutations we desire for a chromosome at most, on average
+static constexpr float numberSwapsPerChromosome = 0.0625f;
+static constexpr float numberDeletionsPerChromosome = 0.025f;
+
+// xorshift64* - much cheaper than rand() and without its lock
+class Random {
+public:
+	explicit Random(uint64_t seed) : state_(seed ? seed : 0x9E3779B97F4A7C15ull) {}
+
+	uint64_t next() {
+		state_ ^= state_ >> 12;
+		state_ ^= state_ << 25;
+		state_ ^= state_ >> 27;
+		return state_ * 2685821657736338717ull;
+	}
+
+	// [0.0, 1.0)
+	float uniform() { return (next() >> 40) * (1.f / (1u << 24)); }
+	// [-1.0, 1.0)
+	float signedUniform() { return 2.f * uniform() - 1.f; }
+
+	// number of failed trials before the first success, in a sequence of trials with the chance [p]
+	size_t geometric(float p) {
+		static constexpr size_t never = SIZE_MAX / 4;
+		if (p >= 1)
+			return 0;
+		if (p <= 0)
+			return never;
+		double u = 1.0 - (next() >> 11) * (1.0 / (1ull << 53));	// (0.0, 1.0]
+		double k = std::floor(std::log(u) / std::log1p(-(double)p));
+		return k < never ? (size_t)k : never;
+	}
+
+private:
+	uint64_t state_;
+};
+
+/*
+ * appends to [out] (in increasing order) the indices in [0, n) that are selected, each one independently
+ * with the chance chance(i), which must not exceed [maxChance].
+ */
+template<class F>
+void sampleEvents(Random &rnd, size_t n, float maxChance, F chance, std::vector<size_t> &out) {
+	if (!(maxChance > 0))
+		return;
+	maxChance = std::min(maxChance, 1.f);
+	for (size_t i = rnd.geometric(maxChance); i < n; i += 1 + rnd.geometric(maxChance)) {
+		float p = chance(i);
+		if (p >= maxChance || rnd.uniform() * maxChance < p)
+			out.push_back(i);
+	}
+}
+
+// returns true if [i] is in [events]; [cursor] walks forward through the events and must start at 0
+bool isEvent(std::vector<size_t> const& events, size_t &cursor, size_t i) {
+	while (cursor < events.size() && events[cursor] < i)
+		cursor++;
+	return cursor < events.size() && events[cursor] == i;
+}
+
+float atomChance(float chanceToMutate, float factor) {
+	return std::max(chanceToMutate * factor, constants::global_alteration_override_chance);
+}
+
+template<typename T>
+void mutateAtom(Atom<T> &a, Random &rnd) {
+	if (std::is_integral<T>::value)
+		a.value += rnd.uniform() < 0.5f ? +1 : -1;
+	else
+		a.value += rnd.signedUniform() * a.changeAmount.value;
+}
+
+// the working memory of alterChromosome; one per thread, reused between calls
+struct Scratch {
+	std::vector<float> deleteChance;	// per gene
+	std::vector<float> swapChance;		// per gene
+	std::vector<float> mutateChance;	// per atom (atoms are numbered through the whole chromosome)
+	std::vector<unsigned> firstAtom;	// per gene, the number of its first atom; one extra entry at the end
+	std::vector<size_t> deletions;
+	std::vector<size_t> swaps;
+	std::vector<size_t> mutations;
+	FlatMap<int, bool> neurons;
+
+	void reset() {
+		deleteChance.clear();
+		swapChance.clear();
+		mutateChance.clear();
+		firstAtom.clear();
+		deletions.clear();
+		swaps.clear();
+		mutations.clear();
+		neurons.clear();
+	}
+};
+
+class Mutator {
+public:
+	Mutator(Chromosome &c, Scratch &s)
+		: c_(c), s_(s)
+		, rnd_(((uint64_t)rand() << 32) ^ ((uint64_t)rand() << 16) ^ rand()) {
+		s_.reset();
+	}
+
+	MutationEngine::Stats run();
+
+private:
+	Chromosome &c_;
+	Scratch &s_;
+	Random rnd_;
+	size_t mutationCursor_ = 0;
+	float totalChanceToMutate_ = 0.f;
+	float totalChanceToSwap_ = 0.f;
+	float totalChanceToDelete_ = 0.f;
+	float maxChanceToMutate_ = 0.f;
+	float maxChanceToSwap_ = 0.f;
+	float maxChanceToDelete_ = 0.f;
+	MutationEngine::Stats stats_;
+
+	int countNeuronsAndChances();
+	void sampleAllEvents();
+	void applyEvents();
+	void alterGene(size_t index, size_t originalIndex);
+	void spawnGene(int nNeurons);
+};
+
+MutationEngine::Stats Mutator::run() {
+	int nNeurons = countNeuronsAndChances();
+	sampleAllEvents();
+	applyEvents();
+	spawnGene(nNeurons);
+	return stats_;
+}
+
+/*
+ * records the chances of the genes and of their atoms;
+ * returns the number of neurons (we need it in order to create new random genes)
+ */
+int Mutator::countNeuronsAndChances() {
+	GeneSequence const& genes = c_.genes;	// read-only access doesn't materialize shared segments
+	size_t n = genes.size();
+	s_.deleteChance.reserve(n);
+	s_.swapChance.reserve(n);
+	s_.firstAtom.reserve(n + 1);
+	for (size_t i=0; i<n; i++) {
+		Gene const& g = genes[i];
+		float mutateCh, swapCh, deleteCh;
+		GeneticOperations::getAlterationChances(g, mutateCh, swapCh, deleteCh);
+		totalChanceToMutate_ += mutateCh;
+		totalChanceToSwap_ += swapCh;
+		totalChanceToDelete_ += deleteCh;
+		maxChanceToSwap_ = std::max(maxChanceToSwap_, swapCh);
+		maxChanceToDelete_ = std::max(maxChanceToDelete_, deleteCh);
+		s_.deleteChance.push_back(deleteCh);
+		s_.swapChance.push_back(swapCh);
+		s_.firstAtom.push_back(s_.mutateChance.size());
+		MutationEngine::forEachMutableAtom(g, [this] (auto const& atom) {
+			s_.mutateChance.push_back(atom.chanceToMutate.value);
+			maxChanceToMutate_ = std::max(maxChanceToMutate_, atom.chanceToMutate.value);
+		});
+		if (g.type == gene_type::SYNAPSE) {
+			if (g.data.gene_synapse.from >= 0)
+				s_.neurons[g.data.gene_synapse.from] = true;
+			if (g.data.gene_synapse.to >= 0)
+				s_.neurons[g.data.gene_synapse.to] = true;
+		}
+	}
+	s_.firstAtom.push_back(s_.mutateChance.size());
+	return s_.neurons.size();
+}
+
+void Mutator::sampleAllEvents() {
+	// compute a factor to multiply the chances of each kind of event with, in order to bring them into the desired range:
+	float mutationChanceFactor = std::min(1.f, numberMutationsPerChromosome / totalChanceToMutate_);
+	float swapChanceFactor = std::min(1.f, numberSwapsPerChromosome / totalChanceToSwap_);
+	float deleteChanceFactor = std::min(1.f, numberDeletionsPerChromosome / totalChanceToDelete_);
+
+	size_t n = c_.genes.size();
+	sampleEvents(rnd_, n, maxChanceToDelete_ * deleteChanceFactor, [this, deleteChanceFactor] (size_t i) {
+		return s_.deleteChance[i] * deleteChanceFactor;
+	}, s_.deletions);
+	sampleEvents(rnd_, n, maxChanceToSwap_ * swapChanceFactor, [this, swapChanceFactor] (size_t i) {
+		return s_.swapChance[i] * swapChanceFactor;
+	}, s_.swaps);
+	sampleEvents(rnd_, s_.mutateChance.size(), atomChance(maxChanceToMutate_, mutationChanceFactor), [this, mutationChanceFactor] (size_t i) {
+		return atomChance(s_.mutateChance[i], mutationChanceFactor);
+	}, s_.mutations);
+}
+
+/*
+ * mutates the selected atoms of the gene at [index] (which was at [originalIndex] before any swaps)
+ * and alters all of its meta-genes
+ */
+void Mutator::alterGene(size_t index, size_t originalIndex) {
+	Gene &g = c_.genes[index];
+	unsigned atomIndex = s_.firstAtom[originalIndex];
+	MutationEngine::forEachMutableAtom(g, [this, &atomIndex] (auto &atom) {
+		if (isEvent(s_.mutations, mutationCursor_, atomIndex++)) {
+			mutateAtom(atom, rnd_);
+			stats_.mutations++;
+		}
+	});
+	MetaGene* metaGenes[Gene::MaxMetaGenes];
+	unsigned nMeta = g.getMetaGenes(metaGenes);
+	for (unsigned i=0; i<nMeta; i++) {
+		metaGenes[i]->value += rnd_.signedUniform() * metaGenes[i]->dynamic_variation;
+		if (metaGenes[i]->value < 0)
+			metaGenes[i]->value = 0;
+	}
+}
+
+/*
+ * the events are applied directly to the chromosome's gene sequence, so only the segments that are written to get
+ * materialized; the others stay shared with the parent chromosomes
+ */
+void Mutator::applyEvents() {
+	GeneSequence &genes = c_.genes;
+	size_t n = genes.size();
+	size_t delCursor = 0, swapCursor = 0;
+	// genes are altered in the order of their original index (also when swapped), so the atoms' mutation events
+	// are consumed in order
+	for (size_t i=0; i<n; i++) {
+		if (isEvent(s_.deletions, delCursor, i)) {
+			if (static_cast<GeneSequence const&>(genes)[i].type != gene_type::NO_OP)
+				genes[i].type = gene_type::NO_OP;
+			stats_.deletions++;
+			continue;
+		}
+		if (!isEvent(s_.swaps, swapCursor, i) || n < 2) {
+			alterGene(i, i);
+			continue;
+		}
+		stats_.swaps++;
+		if (i < n-1) {
+			// swap ahead; the next gene has been altered by swapping, so it doesn't get a step of its own
+			xchg(genes[i], genes[i+1]);
+			alterGene(i+1, i);
+			alterGene(i, i+1);
+			i++;
+		} else {
+			// swap behind
+			xchg(genes[i], genes[i-1]);
+			alterGene(i-1, i);
+		}
+	}
+}
+
+void Mutator::spawnGene(int nNeurons) {
+	GeneSequence &genes = c_.genes;
+	if (genes.empty() || rnd_.uniform() >= constants::global_chance_to_spawn_gene * genes.size())
+		return;
+	int position = std::min((int)(rnd_.uniform() * genes.size()), (int)genes.size()-1);
+	Gene newGene(Gene::createRandom(genes.size()-position, nNeurons));
+	if (static_cast<GeneSequence const&>(genes)[position].type == gene_type::NO_OP)
+		genes[position] = newGene;
+	else {
+		// must keep a record of last genes inserted (at most N, and if gametes have a difference of more than N genes, they don't fuse)
+		// when combining two gametes we must insert dummy genes at correspondent positions in the other chromosome, in order to realign the alelles.
+		// (this materializes the segments from [position] to the end)
+		genes.insert(position, newGene);
+		GeneticOperations::recordInsertion(c_, Chromosome::insertion(position, 0));
+	}
+	stats_.newGenes++;
+}
+
+} // namespace
+
+MutationEngine::Stats MutationEngine::alterChromosome(Chromosome &c) {
+	static thread_local Scratch scratch;
+	return Mutator(c, scratch).run();
+}
@@ -0,0 +1,109 @@
+/*
+ * MutationEngine.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_MUTATIONENGINE_H_
+#define GENETICS_MUTATIONENGINE_H_
+
+#include "Genome.h"
+
+/*
+ * Performs the random alterations of a chromosome (see GeneticOperations::alterChromosome):
+ * 	1. deleting genes (they turn into NO_OP)
+ * 	2. swapping genes with their neighbour
+ * 	3. mutating the genes' atoms
+ * 	4. altering the meta-genes of all genes except the deleted ones
+ * 	5. spawning a new random gene
+ *
+ * Each gene and atom has its own (small) chance for each event. Instead of rolling a random number for each one,
+ * the events are drawn in bulk: the distance to the next candidate is sampled from a geometric distribution with the
+ * largest chance in the chromosome, and each candidate is then accepted with its own chance divided by the largest one.
+ * This selects each gene/atom with exactly its own chance, at the cost of a few random numbers per actual event.
+ * The events are then applied in a single pass over the genes, in the same order as the gene-by-gene algorithm
+ * (a gene that swaps forward takes its neighbour out of the roll for deletion and swapping).
+ * They are written directly into the chromosome's gene sequence instead of rebuilding it; an inserted gene materializes
+ * the segments from its position onwards. Since the meta-genes of every gene that isn't deleted drift at each
+ * meiosis, a segment only stays shared with the chromosome it came from if all its genes are already NO_OPs.
+ *
+ * Random numbers come from a private generator seeded from rand() at each call, so the results still follow randSeed().
+ */
+class MutationEngine {
+public:
+	struct Stats {
+		int mutations = 0;
+		int swaps = 0;
+		int deletions = 0;
+		int newGenes = 0;
+	};
+
+	static Stats alterChromosome(Chromosome &c);
+
+	/*
+	 * calls f(atom) for each atom of the gene that is subject to mutation.
+	 * GENE can be const or not, f must accept both Atom<int>& and Atom<float>& (with the same constness).
+	 */
+	template<class GENE, class F>
+	static void forEachMutableAtom(GENE &g, F f);
+};
+
+template<class GENE, class F>
+void MutationEngine::forEachMutableAtom(GENE &g, F f) {
+	switch (g.type) {
+	case gene_type::SKIP:
+		f(g.data.gene_skip.count);
+		f(g.data.gene_skip.maxDepth);
+		f(g.data.gene_skip.minDepth);
+		break;
+	case gene_type::BODY_ATTRIBUTE:
+		f(g.data.gene_body_attribute.value);
+		break;
+	case gene_type::PROTEIN:
+		f(g.data.gene_protein.maxDepth);
+		f(g.data.gene_protein.minDepth);
+		break;
+	case gene_type::OFFSET:
+		f(g.data.gene_offset.maxDepth);
+		f(g.data.gene_offset.minDepth);
+		f(g.data.gene_offset.offset);
+		break;
+	case gene_type::NEURON_INPUT_COORD:
+		f(g.data.gene_neuron_input.destNeuronVirtIndex);
+		f(g.data.gene_neuron_input.inCoord);
+		break;
+	case gene_type::NEURON_OUTPUT_COORD:
+		f(g.data.gene_neuron_output.srcNeuronVirtIndex);
+		f(g.data.gene_neuron_output.outCoord);
+		break;
+	case gene_type::NEURAL_BIAS:
+		f(g.data.gene_neural_constant.targetNeuron);
+		f(g.data.gene_neural_constant.value);
+		break;
+	case gene_type::PART_ATTRIBUTE:
+		f(g.data.gene_attribute.value);
+		f(g.data.gene_attribute.minDepth);
+		f(g.data.gene_attribute.maxDepth);
+		break;
+	case gene_type::SYNAPSE:
+		f(g.data.gene_synapse.from);
+		f(g.data.gene_synapse.to);
+		f(g.data.gene_synapse.weight);
+		break;
+	case gene_type::TRANSFER_FUNC:
+		f(g.data.gene_transfer_function.functionID);
+		f(g.data.gene_transfer_function.targetNeuron);
+		break;
+	case gene_type::JOINT_OFFSET:
+		f(g.data.gene_joint_offset.offset);
+		f(g.data.gene_joint_offset.minDepth);
+		f(g.data.gene_joint_offset.maxDepth);
+		break;
+	default:
+		// the other genes have nothing to mutate
+		break;
+	}
+}
+
+#endif /* GENETICS_MUTATIONENGINE_H_ */
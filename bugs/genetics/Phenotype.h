@@ -0,0 +1,83 @@
+/*
+ * Phenotype.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_PHENOTYPE_H_
+#define GENETICS_PHENOTYPE_H_
+
+#include "CummulativeValue.h"
+#include "GeneDefinitions.h"
+#include "../body-parts/BodyPartType.h"
+#include <vector>
+#include <map>
+#include <cstdint>
+
+struct NeuronInfo {
+	int virtualIndex;
+	CummulativeValue transfer;
+	CummulativeValue bias;
+	CummulativeValue param;
+	CummulativeValue inputVMSCoord;
+	CummulativeValue outputVMSCoord;
+	explicit NeuronInfo(int virtualIndex)
+		: virtualIndex(virtualIndex) {
+	}
+	NeuronInfo(NeuronInfo const& other) = default;
+	NeuronInfo() : virtualIndex(-1) {
+	}
+};
+
+struct SynapseInfo {
+	CummulativeValue weight;
+	CummulativeValue priority;
+};
+
+/*
+ * The outcome of decoding a genome, as plain data: the body plan, the gene-driven attributes and the neural network.
+ * It is produced by PhenotypeDecoder without touching the World or the physics, so it can be computed on any thread,
+ * and it is turned into actual body parts and neurons by the Ribosome of a developing bug.
+ *
+ * Attribute values only hold what the genes contributed; they are merged into the parts' own default values
+ * when the phenotype is instantiated.
+ */
+struct Phenotype {
+	struct Attribute {
+		gene_part_attribute_type attribute;
+		unsigned index;
+		CummulativeValue value;
+	};
+
+	struct Part {
+		BodyPartType type;
+		int parentIndex;		// index of the parent in [parts]; -1 for the torso
+		float angle;			// the attachment angle that is requested from the parent (BodyPart::add)
+		int depth;				// depth in the body tree (the torso is 0)
+		std::vector<Attribute> attributes;
+	};
+
+	unsigned developmentSteps = 0;	// number of ribosome steps that the development takes
+	bool viable = false;			// false if the embryo lacks critical parts and must be discarded
+	std::vector<Part> parts;		// all body parts, in creation order; parts[0] is the torso
+	std::map<gene_body_attribute_type, CummulativeValue> bodyAttributes;
+
+	struct Synapse {
+		int from;	// real neuron indices
+		int to;
+		SynapseInfo info;
+	};
+
+	// neurons are referred to by their real index (the order in which the genes first mention them):
+	unsigned neuronCount = 0;				// neurons [0, neuronCount) make up the network (they take part in synapses)
+	std::vector<NeuronInfo> neurons;		// all neurons mentioned by the genes, indexed by real index
+	std::vector<Synapse> synapses;			// ordered by the virtual indices of (from, to)
+	std::vector<int> inputNeurons;			// real indices of input neurons, ordered by virtual index
+	std::vector<int> outputNeurons;			// real indices of output neurons, ordered by virtual index
+
+	// returns the key of the synapse between two virtual neurons
+	static inline uint64_t synapseKey(uint64_t from, uint64_t to) { return ((from << 32) & 0xFFFFFFFF00000000) | (to & 0xFFFFFFFF); }
+};
+
+#endif /* GENETICS_PHENOTYPE_H_ */
@@ -0,0 +1,206 @@
+/*
+ * PhenotypeCache.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "PhenotypeCache.h"
+#include "../perf/counters.h"
+#include "../utils/assert.h"
+
+#include <cstring>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+perf::Counters::counter_type& hitsCounter() {
+	static perf::Counters::counter_type &c = perf::Counters::get("phenotype-cache-hits");
+	return c;
+}
+
+perf::Counters::counter_type& missesCounter() {
+	static perf::Counters::counter_type &c = perf::Counters::get("phenotype-cache-misses");
+	return c;
+}
+
+void put(PhenotypeCache::Key &key, int x) {
+	key.push_back((uint32_t)x);
+}
+
+void put(PhenotypeCache::Key &key, float x) {
+	// -0.f and 0.f decode identically, but keep the exact bits for everything else
+	if (x == 0)
+		x = 0;
+	uint32_t bits;
+	memcpy(&bits, &x, sizeof(bits));
+	key.push_back(bits);
+}
+
+template<typename T>
+void put(PhenotypeCache::Key &key, Atom<T> const& atom) {
+	put(key, atom.value);
+}
+
+void putGene(PhenotypeCache::Key &key, Gene const& g) {
+	key.push_back((uint32_t)g.type);
+	switch (g.type) {
+	case gene_type::SKIP:
+		put(key, g.data.gene_skip.minDepth);
+		put(key, g.data.gene_skip.maxDepth);
+		put(key, g.data.gene_skip.count);
+		break;
+	case gene_type::PROTEIN:
+		put(key, (int)g.data.gene_protein.protein.value);
+		put(key, g.data.gene_protein.targetSegment);
+		put(key, g.data.gene_protein.minDepth);
+		put(key, g.data.gene_protein.maxDepth);
+		break;
+	case gene_type::OFFSET:
+		put(key, g.data.gene_offset.minDepth);
+		put(key, g.data.gene_offset.maxDepth);
+		put(key, g.data.gene_offset.offset);
+		put(key, g.data.gene_offset.targetSegment);
+		break;
+	case gene_type::JOINT_OFFSET:
+		put(key, g.data.gene_joint_offset.minDepth);
+		put(key, g.data.gene_joint_offset.maxDepth);
+		put(key, g.data.gene_joint_offset.offset);
+		break;
+	case gene_type::PART_ATTRIBUTE:
+		put(key, (int)g.data.gene_attribute.attribute);
+		put(key, g.data.gene_attribute.value);
+		put(key, g.data.gene_attribute.minDepth);
+		put(key, g.data.gene_attribute.maxDepth);
+		put(key, g.data.gene_attribute.attribIndex);
+		break;
+	case gene_type::BODY_ATTRIBUTE:
+		put(key, (int)g.data.gene_body_attribute.attribute);
+		put(key, g.data.gene_body_attribute.value);
+		break;
+	case gene_type::SYNAPSE:
+		put(key, g.data.gene_synapse.from);
+		put(key, g.data.gene_synapse.to);
+		put(key, g.data.gene_synapse.weight);
+		put(key, g.data.gene_synapse.priority);
+		break;
+	case gene_type::NEURON_OUTPUT_COORD:
+		put(key, g.data.gene_neuron_output.srcNeuronVirtIndex);
+		put(key, g.data.gene_neuron_output.outCoord);
+		break;
+	case gene_type::NEURON_INPUT_COORD:
+		put(key, g.data.gene_neuron_input.destNeuronVirtIndex);
+		put(key, g.data.gene_neuron_input.inCoord);
+		break;
+	case gene_type::TRANSFER_FUNC:
+		put(key, g.data.gene_transfer_function.targetNeuron);
+		put(key, g.data.gene_transfer_function.functionID);
+		break;
+	case gene_type::NEURAL_BIAS:
+		put(key, g.data.gene_neural_constant.targetNeuron);
+		put(key, g.data.gene_neural_constant.value);
+		break;
+	case gene_type::NEURAL_PARAM:
+		put(key, g.data.gene_neural_param.targetNeuron);
+		put(key, g.data.gene_neural_param.value);
+		break;
+	default:
+		// the other genes carry no data
+		break;
+	}
+}
+
+} // namespace
+
+PhenotypeCache& PhenotypeCache::get() {
+	static PhenotypeCache instance;
+	return instance;
+}
+
+PhenotypeCache::Key PhenotypeCache::makeKey(Genome const& genome) {
+	Key key;
+	key.reserve((genome.first.genes.size() + genome.second.genes.size()) * 4 + 2);
+	key.push_back(genome.first.genes.size());
+	key.push_back(genome.second.genes.size());
+	for (Gene const& g : genome.first.genes)
+		putGene(key, g);
+	for (Gene const& g : genome.second.genes)
+		putGene(key, g);
+	return key;
+}
+
+void PhenotypeCache::appendGeneKey(Key &key, Gene const& gene) {
+	putGene(key, gene);
+}
+
+uint64_t PhenotypeCache::hashKey(Key const& key) {
+	// FNV-1a
+	uint64_t h = 14695981039346656037ull;
+	for (uint32_t x : key) {
+		for (unsigned i=0; i<4; i++, x >>= 8) {
+			h ^= x & 0xFF;
+			h *= 1099511628211ull;
+		}
+	}
+	return h;
+}
+
+std::shared_ptr<const Phenotype> PhenotypeCache::find(Key const& key) {
+	uint64_t hash = hashKey(key);
+	std::lock_guard<std::mutex> lk(mutex_);
+	auto range = entries_.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second.key == key) {
+			hitsCounter()++;
+			return it->second.phenotype;
+		}
+	}
+	missesCounter()++;
+	return nullptr;
+}
+
+void PhenotypeCache::insert(Key key, std::shared_ptr<const Phenotype> phenotype) {
+	uint64_t hash = hashKey(key);
+	std::lock_guard<std::mutex> lk(mutex_);
+	if (!capacity_)
+		return;
+	auto range = entries_.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (it->second.key == key)
+			return; // another bug with the same genome finished first
+	while (entries_.size() >= capacity_)
+		evictOldest();
+	entries_.emplace(hash, Entry{std::move(key), std::move(phenotype)});
+	insertionOrder_.push_back(hash);
+}
+
+void PhenotypeCache::evictOldest() {
+	assertDbg(!insertionOrder_.empty());
+	uint64_t hash = insertionOrder_.front();
+	insertionOrder_.pop_front();
+	// (on the rare hash collision this may evict a younger entry with the same hash; that's harmless)
+	auto it = entries_.find(hash);
+	if (it != entries_.end())
+		entries_.erase(it);
+}
+
+void PhenotypeCache::setCapacity(size_t capacity) {
+	std::lock_guard<std::mutex> lk(mutex_);
+	capacity_ = capacity;
+	while (entries_.size() > capacity_)
+		evictOldest();
+}
+
+size_t PhenotypeCache::size() {
+	std::lock_guard<std::mutex> lk(mutex_);
+	return entries_.size();
+}
+
+void PhenotypeCache::clear() {
+	std::lock_guard<std::mutex> lk(mutex_);
+	entries_.clear();
+	insertionOrder_.clear();
+}
@@ -0,0 +1,66 @@
+/*
+ * PhenotypeCache.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_PHENOTYPECACHE_H_
+#define GENETICS_PHENOTYPECACHE_H_
+
+#include "Phenotype.h"
+#include "Genome.h"
+#include <memory>
+#include <unordered_map>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+
+/*
+ * Process-wide cache of decoded phenotypes, addressed by the content of the genome.
+ *
+ * The key of a genome is built only from what the Ribosome reads: the gene types and the values of their atoms.
+ * Meta-genes (mutation chances etc) are left out since they don't affect the phenotype and they drift with every meyosis,
+ * so genomes that differ only in meta-genes share the same entry.
+ * Keys are compared in full on lookup, the hash is only used for addressing.
+ *
+ * The cache is safe to use from several threads.
+ * Hits and misses are reported in the perf counters "phenotype-cache-hits" and "phenotype-cache-misses".
+ */
+class PhenotypeCache {
+public:
+	typedef std::vector<uint32_t> Key;
+
+	static PhenotypeCache& get();
+
+	static Key makeKey(Genome const& genome);
+	// appends the key of a single gene (its type and the values of its atoms) - the identity of an allele
+	static void appendGeneKey(Key &key, Gene const& gene);
+	static uint64_t hashKey(Key const& key);
+
+	// returns the phenotype recorded for the given key, or nullptr if there isn't one
+	std::shared_ptr<const Phenotype> find(Key const& key);
+	void insert(Key key, std::shared_ptr<const Phenotype> phenotype);
+
+	// maximum number of phenotypes kept; the oldest ones are evicted first. Zero disables the cache.
+	void setCapacity(size_t capacity);
+	size_t size();
+	void clear();
+
+private:
+	struct Entry {
+		Key key;
+		std::shared_ptr<const Phenotype> phenotype;
+	};
+
+	std::mutex mutex_;
+	std::unordered_multimap<uint64_t, Entry> entries_;
+	std::deque<uint64_t> insertionOrder_;
+	size_t capacity_ = 4096;
+
+	PhenotypeCache() = default;
+	void evictOldest();
+};
+
+#endif /* GENETICS_PHENOTYPECACHE_H_ */
@@ -0,0 +1,594 @@
+/*
+ * PhenotypeDecoder.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "PhenotypeDecoder.h"
+#include "Gene.h"
+#include "GeneDefinitions.h"
+#include "../body-parts/BodyPart.h"
+#include "../body-parts/sensors/Nose.h"
+#include "../math/math3D.h"
+#include "../utils/log.h"
+#include "../utils/FlatMap.h"
+
+#include <glm/vec4.hpp>
+#include <utility>
+#include <algorithm>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+struct GrowthData {
+	unsigned startGenomePos; // initial genome offset for this part (children are relative to this one)
+	unsigned crtGenomePos; // current READ position in genome for this part
+	glm::vec4 hyperPositions[BodyPart::MAX_CHILDREN] { glm::vec4() };	// holds hyper-space positions for each segment in a body part
+	CummulativeValue offsets[BodyPart::MAX_CHILDREN]; // holds relative genome offsets for each segment in a body part
+
+	GrowthData(int initialOffs)
+		: startGenomePos(initialOffs), crtGenomePos(initialOffs) {
+	}
+};
+
+struct JointOffset {
+	int joint = -1;				// index of the part's upstream joint, -1 if it has none
+	CummulativeValue offset;	// relative genome offset of the joint
+};
+
+/*
+ * The working memory of a decoding. There is one per thread and it's reset (not freed) for each genome,
+ * so once the containers have grown to the size of a typical genome, decoding doesn't allocate anything
+ * except for the resulting phenotype.
+ */
+struct Scratch {
+	std::vector<std::pair<int, GrowthData>> activeSet;
+	std::vector<JointOffset> jointOffsets;		// indexed by body part index, same as the phenotype's parts
+	std::vector<const Gene*> neuralGenes;
+	FlatMap<int, int> neuronIndex;				// virtual neuron index -> real index
+	FlatMap<uint64_t, unsigned> synapseIndex;	// synapse key -> index in the phenotype's synapses
+	std::vector<std::pair<uint64_t, unsigned>> synapseOrder;
+	std::vector<int> inputNeurons;				// virtual indices (with duplicates) until the decoding is finished
+	std::vector<int> outputNeurons;
+
+	void reset() {
+		activeSet.clear();
+		jointOffsets.clear();
+		neuralGenes.clear();
+		neuronIndex.clear();
+		synapseIndex.clear();
+		synapseOrder.clear();
+		inputNeurons.clear();
+		outputNeurons.clear();
+	}
+};
+
+/*
+ * Holds the state of the decoding of one genome.
+ * Body parts are referred to by their index in the phenotype's parts vector,
+ * neurons by their real index in the phenotype's neurons vector.
+ */
+class Decoder {
+public:
+	Decoder(Genome const& genome, Phenotype &out, Scratch &scratch)
+		: genome_(genome), ph_(out), s_(scratch)
+		, activeSet_(scratch.activeSet), jointOffsets_(scratch.jointOffsets), neuralGenes_(scratch.neuralGenes) {
+		s_.reset();
+	}
+
+	void run();
+
+private:
+	Genome const& genome_;
+	Phenotype &ph_;
+	Scratch &s_;
+	std::vector<std::pair<int, GrowthData>> &activeSet_;
+	std::vector<JointOffset> &jointOffsets_;
+	std::vector<const Gene*> &neuralGenes_;
+
+	void step();
+	bool isTorso(int part) const { return part >= 0 && ph_.parts[part].type == BodyPartType::TORSO; }
+	void decodeGene(Gene const& g, int part, GrowthData *growthData, bool deferNeural);
+	void decodeProtein(GeneProtein const& g, int part, GrowthData *growthData);
+	void decodeOffset(GeneOffset const& g, int part, GrowthData *growthData);
+	void decodeJointOffset(GeneJointOffset const& g, int part);
+	void decodePartAttrib(GeneAttribute const& g, int part);
+	void decodeBodyAttrib(GeneBodyAttribute const& g);
+	void decodeSynapse(GeneSynapse const& g);
+	void decodeTransferFn(GeneTransferFunction const& g);
+	void decodeNeuralBias(GeneNeuralBias const& g);
+	void decodeNeuralParam(GeneNeuralParam const& g);
+	void decodeNeuronOutputCoord(GeneNeuronOutputCoord const& g);
+	void decodeNeuronInputCoord(GeneNeuronInputCoord const& g);
+	void growBodyPart(int parent, unsigned attachmentSegment, glm::vec4 hyperPosition, unsigned genomeOffset);
+	int addPart(BodyPartType type, int parent, float angle);
+	int checkAndAddNeuronMapping(int virtualIndex);
+	// returns the neuron with the given virtual index or nullptr if the genes didn't mention it so far
+	NeuronInfo* findNeuron(int virtualIndex) {
+		int *real = s_.neuronIndex.find(virtualIndex);
+		return real ? &ph_.neurons[*real] : nullptr;
+	}
+	void finish();
+	std::vector<int> sortedRealIndices(std::vector<int> &virtualIndices);
+};
+
+void Decoder::run() {
+	// there are no default body parts; they either get created by the genes, or the embryo
+	// is discarded at the end of development if it lacks critical parts such as mouth or egg-layer
+	addPart(BodyPartType::TORSO, -1, 0.f);
+	// start decoding with root body part at offset 0 in the genome:
+	activeSet_.push_back(std::make_pair(0, GrowthData(0)));
+	while (!activeSet_.empty()) {
+		step();
+		ph_.developmentSteps++;
+	}
+
+	// check if critical body parts exist (at least a mouth and egg-layer)
+	bool hasMouth = false, hasEggLayer = false;
+	for (auto &p : ph_.parts) {
+		hasMouth |= p.type == BodyPartType::MOUTH;
+		hasEggLayer |= p.type == BodyPartType::EGGLAYER;
+	}
+	ph_.viable = hasMouth && hasEggLayer;
+	if (!ph_.viable)
+		return;
+
+	// the neurons mapped so far by the synapses make up the network;
+	// the deferred neural genes may map some more, but those don't take part in any synapse:
+	ph_.neuronCount = ph_.neurons.size();
+	for (auto g : neuralGenes_)
+		decodeGene(*g, -1, nullptr, false);
+	finish();
+}
+
+void Decoder::finish() {
+	// put the synapses in the order of their virtual keys, so that the network is always built the same way:
+	std::sort(s_.synapseOrder.begin(), s_.synapseOrder.end());
+	std::vector<Phenotype::Synapse> synapses;
+	synapses.reserve(ph_.synapses.size());
+	for (auto &o : s_.synapseOrder)
+		synapses.push_back(ph_.synapses[o.second]);
+	ph_.synapses.swap(synapses);
+
+	ph_.inputNeurons = sortedRealIndices(s_.inputNeurons);
+	ph_.outputNeurons = sortedRealIndices(s_.outputNeurons);
+}
+
+std::vector<int> Decoder::sortedRealIndices(std::vector<int> &virtualIndices) {
+	std::sort(virtualIndices.begin(), virtualIndices.end());
+	virtualIndices.erase(std::unique(virtualIndices.begin(), virtualIndices.end()), virtualIndices.end());
+	std::vector<int> ret;
+	ret.reserve(virtualIndices.size());
+	for (int v : virtualIndices)
+		ret.push_back(*s_.neuronIndex.find(v));
+	return ret;
+}
+
+void Decoder::step() {
+	unsigned nCrtBranches = activeSet_.size();
+	for (unsigned i=0; i<nCrtBranches; i++) {
+		auto const& c1 = genome_.first.genes;
+		auto const& c2 = genome_.second.genes;
+#ifdef ENABLE_START_MARKER_GENES
+		if (activeSet_[i].second.crtGenomePos == activeSet_[i].second.startGenomePos) {
+			// move forward until we hit a start marker
+			auto &offs = activeSet_[i].second.crtGenomePos;
+			while ((c1.size() > offs && c1[offs].type != gene_type::START_MARKER)
+				|| (c2.size() > offs && c2[offs].type != gene_type::START_MARKER)) {
+				activeSet_[i].second.crtGenomePos++;
+				// did we hit a marker?
+				if ((c1.size() > offs && c1[offs].type == gene_type::START_MARKER)
+					|| (c2.size() > offs && c2[offs].type == gene_type::START_MARKER))
+					break;
+			}
+		}
+#endif
+		int p = activeSet_[i].first;
+		unsigned offset = activeSet_[i].second.crtGenomePos++;
+		const Gene *g1 = nullptr, *g2 = nullptr;
+		if (offset < c1.size())
+			g1 = &c1[offset];
+		if (offset < c2.size())
+			g2 = &c2[offset];
+		bool reachedTheEnd = !g1 && !g2;
+		if (reachedTheEnd
+				|| (g1 && g1->type == gene_type::STOP)
+				|| (g2 && g2->type == gene_type::STOP)) {
+			// so much for this development path;
+			// grow body parts from all segments now
+			for (unsigned k=0; k<BodyPart::MAX_CHILDREN; k++)
+				growBodyPart(p, k, activeSet_[i].second.hyperPositions[k],
+						activeSet_[i].second.startGenomePos + activeSet_[i].second.offsets[k]);
+			// decode joint genes if such is the case:
+			if (jointOffsets_[p].joint >= 0) {
+				int joint = jointOffsets_[p].joint;
+				int jOffset = jointOffsets_[p].offset.hasValue() ? jointOffsets_[p].offset : 0;
+				activeSet_.push_back(std::make_pair(joint, GrowthData(activeSet_[i].second.startGenomePos + jOffset)));
+			}
+			// and remove this branch:
+			activeSet_.erase(activeSet_.begin()+i);
+			i--, nCrtBranches--;
+			continue;
+		}
+
+		// now decode the genes:
+		if (g1)
+			decodeGene(*g1, p, &activeSet_[i].second, true);
+		if (g2)
+			decodeGene(*g2, p, &activeSet_[i].second, true);
+
+		int skipCount = 0;
+		int depth = ph_.parts[p].depth;
+		if (g1 && g1->type == gene_type::SKIP) {
+			if (depth <= g1->data.gene_skip.maxDepth && depth >= g1->data.gene_skip.minDepth)
+				skipCount += g1->data.gene_skip.count;
+		}
+		if (g2 && g2->type == gene_type::SKIP) {
+			if (depth <= g2->data.gene_skip.maxDepth && depth >= g2->data.gene_skip.minDepth) {
+				if (skipCount)
+					skipCount = (skipCount + g2->data.gene_skip.count) / 2;
+				else
+					skipCount = g2->data.gene_skip.count;
+			}
+		}
+		activeSet_[i].second.crtGenomePos += skipCount;
+	}
+}
+
+int Decoder::addPart(BodyPartType type, int parent, float angle) {
+	int depth = parent >= 0 ? ph_.parts[parent].depth + 1 : 0;
+	ph_.parts.push_back(Phenotype::Part{type, parent, angle, depth, {}});
+	jointOffsets_.emplace_back();
+	return ph_.parts.size() - 1;
+}
+
+void Decoder::growBodyPart(int parent, unsigned attachmentSegment, glm::vec4 hyperPosition, unsigned genomeOffset) {
+	// grow only works on bones and torso
+	if (ph_.parts[parent].type != BodyPartType::BONE && ph_.parts[parent].type != BodyPartType::TORSO)
+		return;
+	// determine the body part type to grow from the hyperPosition
+	static constexpr BodyPartType partTypes[2][2][2][2] = {
+		/* W- */ {
+			/* Z- */ {
+				/* Y- */ {
+					/* X- */ BodyPartType::BONE, /* X+ */ BodyPartType::INVALID
+				},
+				/* Y+ */ {
+					/* X- */ BodyPartType::GRIPPER, /* X+ */ BodyPartType::MOUTH
+				},
+			},
+			/* Z+ */ {
+				/* Y- */ {
+					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
+				},
+				/* Y+ */ {
+					/* X- */ BodyPartType::MUSCLE, /* X+ */ BodyPartType::EGGLAYER
+				},
+			},
+		},
+		/* W+ */ {
+			/* Z- */ {
+				/* Y- */ {
+					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
+				},
+				/* Y+ */ {
+					/* X- */ BodyPartType::SENSOR_PROXIMITY, /* X+ */ BodyPartType::INVALID
+				},
+			},
+			/* Z+ */ {
+				/* Y- */ {
+					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
+				},
+				/* Y+ */ {
+					/* X- */ BodyPartType::SENSOR_COMPASS, /* X+ */ BodyPartType::SENSOR_SIGHT
+				},
+			},
+		}
+	};
+	// if any one axis is zero, we cannot determine the part type and none is grown
+	if (hyperPosition.x * hyperPosition.y * hyperPosition.z * hyperPosition.w == 0)
+		return;
+	BodyPartType newBodyPartType = partTypes[hyperPosition.w > 0][hyperPosition.z > 0][hyperPosition.y > 0][hyperPosition.x > 0];
+	if (newBodyPartType == BodyPartType::INVALID)
+		return;
+
+	// TODO Auto-generate body-part-sensors in joints & grippers and other parts that may have useful info
+
+	float angle = attachmentSegment * 2*PI / BodyPart::MAX_CHILDREN;
+
+	// The child's attachment point relative to the parent's center is computed from the angle of the current segment,
+	// by casting a ray from the parent's origin in the specified angle (which is relative to the parent's orientation)
+	// until it touches an edge of the parent. That point is used as attachment of the new part.
+
+	int upstreamJoint = -1;
+	bool useUpstreamJoint = PhenotypeDecoder::partMustGenerateJoint(newBodyPartType);
+	if (useUpstreamJoint) {
+		// we cannot grow this part directly onto its parent, they must be connected by a joint
+		upstreamJoint = addPart(BodyPartType::JOINT, parent, angle);
+		// set part to point to the joint's node, since that's where the actual part will be attached:
+		parent = upstreamJoint;
+		// recompute coordinates in joint's space:
+		angle = 0;
+	}
+
+	switch (newBodyPartType) {
+	case BodyPartType::SENSOR_COMPASS:
+	case BodyPartType::SENSOR_SIGHT:
+		// not implemented yet
+		return;
+	default:
+		break;
+	}
+
+	int bp = addPart(newBodyPartType, parent, angle);
+	if (useUpstreamJoint) {
+		// add joint mapping to this part:
+		jointOffsets_[bp].joint = upstreamJoint;
+	}
+
+	// start a new development path from the new part:
+	activeSet_.push_back(std::make_pair(bp, GrowthData(genomeOffset)));
+}
+
+int Decoder::checkAndAddNeuronMapping(int virtualIndex) {
+	int &real = s_.neuronIndex[virtualIndex];
+	if (s_.neuronIndex.size() > ph_.neurons.size()) {
+		// first time this neuron is mentioned
+		real = ph_.neurons.size();
+		ph_.neurons.push_back(NeuronInfo(virtualIndex));
+	}
+	return real;
+}
+
+void Decoder::decodeGene(Gene const& g, int part, GrowthData *growthData, bool deferNeural) {
+	// only from depth 0 (torso) must the neural genes be taken into account
+	bool neural = part < 0 || isTorso(part);
+	switch (g.type) {
+	case gene_type::NO_OP:
+		break;
+#ifdef ENABLE_START_MARKER_GENES
+	case gene_type::START_MARKER:
+		break;
+#endif
+	case gene_type::SKIP:
+		break;
+	case gene_type::STOP:
+		break;
+	case gene_type::PROTEIN:
+		decodeProtein(g.data.gene_protein, part, growthData);
+		break;
+	case gene_type::OFFSET:
+		decodeOffset(g.data.gene_offset, part, growthData);
+		break;
+	case gene_type::JOINT_OFFSET:
+		decodeJointOffset(g.data.gene_joint_offset, part);
+		break;
+	case gene_type::PART_ATTRIBUTE:
+		decodePartAttrib(g.data.gene_attribute, part);
+		break;
+	case gene_type::BODY_ATTRIBUTE:
+		decodeBodyAttrib(g.data.gene_body_attribute);
+		break;
+	case gene_type::SYNAPSE:
+		if (neural)
+			decodeSynapse(g.data.gene_synapse);
+		break;
+	case gene_type::NEURON_OUTPUT_COORD:
+		if (neural) {
+			if (deferNeural)
+				neuralGenes_.push_back(&g);
+			else
+				decodeNeuronOutputCoord(g.data.gene_neuron_output);
+		}
+		break;
+	case gene_type::NEURON_INPUT_COORD:
+		if (neural) {
+			if (deferNeural)
+				neuralGenes_.push_back(&g);
+			else
+				decodeNeuronInputCoord(g.data.gene_neuron_input);
+		}
+		break;
+	case gene_type::TRANSFER_FUNC:
+		if (neural) {
+			if (deferNeural)
+				neuralGenes_.push_back(&g);
+			else
+				decodeTransferFn(g.data.gene_transfer_function);
+		}
+		break;
+	case gene_type::NEURAL_BIAS:
+		if (neural) {
+			if (deferNeural)
+				neuralGenes_.push_back(&g);
+			else
+				decodeNeuralBias(g.data.gene_neural_constant);
+		}
+		break;
+	case gene_type::NEURAL_PARAM:
+		if (neural) {
+			if (deferNeural)
+				neuralGenes_.push_back(&g);
+			else
+				decodeNeuralParam(g.data.gene_neural_param);
+		}
+		break;
+	default:
+		ERROR("Unhandled gene type : " << (uint)g.type);
+	}
+}
+
+void Decoder::decodeProtein(GeneProtein const& g, int part, GrowthData *growthData) {
+	int crtDepth = ph_.parts[part].depth;
+	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
+		return;
+	uint segment = clamp<int>(g.targetSegment, 0, BodyPart::MAX_CHILDREN-1);
+	glm::vec4 &pos = growthData->hyperPositions[segment];
+	switch (g.protein) {
+	case GENE_PROT_A:
+		pos.x--;
+		break;
+	case GENE_PROT_B:
+		pos.x++;
+		break;
+	case GENE_PROT_C:
+		pos.y--;
+		break;
+	case GENE_PROT_D:
+		pos.y++;
+		break;
+	case GENE_PROT_E:
+		pos.z--;
+		break;
+	case GENE_PROT_F:
+		pos.z++;
+		break;
+	case GENE_PROT_G:
+		pos.w--;
+		break;
+	case GENE_PROT_H:
+		pos.w++;
+		break;
+	}
+}
+
+void Decoder::decodeOffset(GeneOffset const& g, int part, GrowthData *growthData) {
+	int crtDepth = ph_.parts[part].depth;
+	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
+		return;
+	uint segment = clamp<int>(g.targetSegment, 0, BodyPart::MAX_CHILDREN-1);
+	growthData->offsets[segment].changeAbs(g.offset);
+}
+
+void Decoder::decodeJointOffset(GeneJointOffset const& g, int part) {
+	int crtDepth = ph_.parts[part].depth;
+	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
+		return;
+	if (jointOffsets_[part].joint >= 0)
+		jointOffsets_[part].offset.changeAbs(g.offset);
+}
+
+void Decoder::decodePartAttrib(GeneAttribute const& g, int part) {
+	Phenotype::Part &p = ph_.parts[part];
+	if (p.depth < g.minDepth || p.depth > g.maxDepth)
+		return;
+	unsigned slots = PhenotypeDecoder::getAttributeSlotCount(p.type, g.attribute);
+	if (!slots)
+		return;
+	// out of range indexes go to the first value (same as BodyPart::getAttribute)
+	unsigned index = (unsigned)(int)g.attribIndex;
+	if (index >= slots)
+		index = 0;
+	auto it = std::find_if(p.attributes.begin(), p.attributes.end(), [&g, index] (Phenotype::Attribute const& a) {
+		return a.attribute == g.attribute && a.index == index;
+	});
+	if (it == p.attributes.end())
+		it = p.attributes.insert(p.attributes.end(), Phenotype::Attribute{g.attribute, index, CummulativeValue()});
+	it->value.changeAbs(g.value);
+}
+
+void Decoder::decodeBodyAttrib(GeneBodyAttribute const& g) {
+	if (g.attribute > GENE_BODY_ATTRIB_INVALID && g.attribute < GENE_BODY_ATTRIB_END)
+		ph_.bodyAttributes[g.attribute].changeAbs(g.value);
+}
+
+void Decoder::decodeSynapse(GeneSynapse const& g) {
+	// the number of neurons is derived from the synapse values
+	int from = checkAndAddNeuronMapping(g.from);
+	int to = checkAndAddNeuronMapping(g.to);
+	uint64_t key = Phenotype::synapseKey(g.from, g.to);
+	assert(!std::isnan(g.weight.value));
+	unsigned &index = s_.synapseIndex[key];
+	if (s_.synapseIndex.size() > ph_.synapses.size()) {
+		index = ph_.synapses.size();
+		ph_.synapses.push_back(Phenotype::Synapse{from, to, SynapseInfo()});
+		s_.synapseOrder.push_back(std::make_pair(key, index));
+	}
+	ph_.synapses[index].info.weight.changeAbs(g.weight);
+	ph_.synapses[index].info.priority.changeAbs(g.priority);
+}
+
+void Decoder::decodeTransferFn(GeneTransferFunction const& g) {
+	if (NeuronInfo *n = findNeuron(g.targetNeuron))
+		n->transfer.changeAbs(g.functionID);
+}
+
+void Decoder::decodeNeuralBias(GeneNeuralBias const& g) {
+	assert(!std::isnan(g.value.value));
+	if (NeuronInfo *n = findNeuron(g.targetNeuron))
+		n->bias.changeAbs(g.value);
+}
+
+void Decoder::decodeNeuralParam(GeneNeuralParam const& g) {
+	assert(!std::isnan(g.value.value));
+	if (NeuronInfo *n = findNeuron(g.targetNeuron))
+		n->param.changeAbs(g.value);
+}
+
+void Decoder::decodeNeuronOutputCoord(GeneNeuronOutputCoord const& g) {
+	int n = checkAndAddNeuronMapping(g.srcNeuronVirtIndex);
+	ph_.neurons[n].outputVMSCoord.changeAbs(g.outCoord);
+	// add this neuron into the outputNeurons set:
+	s_.outputNeurons.push_back(g.srcNeuronVirtIndex);
+}
+
+void Decoder::decodeNeuronInputCoord(GeneNeuronInputCoord const& g) {
+	int n = checkAndAddNeuronMapping(g.destNeuronVirtIndex);
+	ph_.neurons[n].inputVMSCoord.changeAbs(g.inCoord);
+	// add this neuron into the inputNeurons set:
+	s_.inputNeurons.push_back(g.destNeuronVirtIndex);
+}
+
+} // namespace
+
+Phenotype PhenotypeDecoder::decode(Genome const& genome) {
+	static thread_local Scratch scratch;
+	Phenotype ph;
+	Decoder(genome, ph, scratch).run();
+	return ph;
+}
+
+bool PhenotypeDecoder::partMustGenerateJoint(BodyPartType type) {
+	switch (type) {
+	case BodyPartType::BONE:
+	case BodyPartType::GRIPPER:
+		return true;
+	default:
+		return false;
+	}
+}
+
+unsigned PhenotypeDecoder::getAttributeSlotCount(BodyPartType type, gene_part_attribute_type attrib) {
+	// common to all body parts:
+	switch (attrib) {
+	case GENE_ATTRIB_LOCAL_ROTATION:
+	case GENE_ATTRIB_ATTACHMENT_OFFSET:
+	case GENE_ATTRIB_SIZE:
+		return 1;
+	default:
+		break;
+	}
+	switch (type) {
+	case BodyPartType::BONE:
+		return attrib == GENE_ATTRIB_ASPECT_RATIO || attrib == GENE_ATTRIB_DENSITY ? 1 : 0;
+	case BodyPartType::JOINT:
+		return attrib == GENE_ATTRIB_JOINT_LOW_LIMIT || attrib == GENE_ATTRIB_JOINT_HIGH_LIMIT
+				|| attrib == GENE_ATTRIB_JOINT_RESET_TORQUE ? 1 : 0;
+	case BodyPartType::MUSCLE:
+		return attrib == GENE_ATTRIB_ASPECT_RATIO || attrib == GENE_ATTRIB_MOTOR_INPUT_COORD ? 1 : 0;
+	case BodyPartType::GRIPPER:
+		return attrib == GENE_ATTRIB_MOTOR_INPUT_COORD ? 1 : 0;
+	case BodyPartType::EGGLAYER:
+		if (attrib == GENE_ATTRIB_EGG_EJECT_SPEED)
+			return 1;
+		return attrib == GENE_ATTRIB_MOTOR_INPUT_COORD ? 2 : 0;
+	case BodyPartType::SENSOR_PROXIMITY:
+		return attrib == GENE_ATTRIB_SENSOR_OUTPUT_COORD ? NoseDetectableFlavoursCount : 0;
+	default:
+		return 0;
+	}
+}
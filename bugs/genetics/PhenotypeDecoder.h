@@ -0,0 +1,32 @@
+/*
+ * PhenotypeDecoder.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_PHENOTYPEDECODER_H_
+#define GENETICS_PHENOTYPEDECODER_H_
+
+#include "Phenotype.h"
+#include "Genome.h"
+
+/*
+ * Decodes a genome into a Phenotype.
+ * This is a pure function of the genome - it doesn't create any body parts and doesn't access the World or the physics,
+ * so it's safe to call from any thread, concurrently.
+ */
+class PhenotypeDecoder {
+public:
+	static Phenotype decode(Genome const& genome);
+
+	/*
+	 * returns the number of values of the given attribute that a body part of the given type has (zero if the part
+	 * doesn't have that attribute). This must match the attributes that the body parts register in their constructors.
+	 */
+	static unsigned getAttributeSlotCount(BodyPartType type, gene_part_attribute_type attrib);
+
+	static bool partMustGenerateJoint(BodyPartType type);
+};
+
+#endif /* GENETICS_PHENOTYPEDECODER_H_ */
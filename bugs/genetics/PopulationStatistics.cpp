@@ -0,0 +1,241 @@
+/*
+ * PopulationStatistics.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "PopulationStatistics.h"
+#include "PhenotypeCache.h"
+#include "../utils/parallel.h"
+#include "../utils/FlatMap.h"
+#include "../utils/rand.h"
+#include "../perf/marker.h"
+
+#include <algorithm>
+#include <numeric>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+constexpr unsigned lociPerJob = 16;
+
+// what we need to know about a chromosome
+struct ChromosomeInfo {
+	std::vector<uint64_t> alleles;		// the allele id of each gene
+	std::array<unsigned, PopulationStatistics::nGeneTypes> typeCounts {};
+};
+
+void describe(Chromosome const& c, ChromosomeInfo &info) {
+	static thread_local PhenotypeCache::Key key;
+	GeneSequence const& genes = c.genes;	// read-only access doesn't materialize shared segments
+	info.alleles.resize(genes.size());
+	for (size_t i=0; i<genes.size(); i++) {
+		key.clear();
+		PhenotypeCache::appendGeneKey(key, genes[i]);
+		info.alleles[i] = PhenotypeCache::hashKey(key);
+		unsigned type = (unsigned)genes[i].type;
+		if (type < PopulationStatistics::nGeneTypes)
+			info.typeCounts[type]++;
+	}
+}
+
+// the fraction of loci where two chromosomes differ; the loci that only the longer one has count as different
+float distance(std::vector<uint64_t> const& a, std::vector<uint64_t> const& b) {
+	size_t n = std::max(a.size(), b.size());
+	if (n == 0)
+		return 0;
+	size_t common = std::min(a.size(), b.size());
+	size_t diffs = n - common;
+	for (size_t i=0; i<common; i++)
+		diffs += a[i] != b[i];
+	return (float)diffs / n;
+}
+
+unsigned percentile(std::vector<unsigned> const& sorted, float p) {
+	return sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5f))];
+}
+
+struct LocusStats {
+	float diversity = 0;
+	unsigned alleles = 0;
+	bool valid = false;		// at least two chromosomes have this locus
+};
+
+/*
+ * the diversity at a locus is Nei's unbiased estimator: n/(n-1) * (1 - sum(p_i^2)), which is the chance that two
+ * different chromosomes picked at random carry different alleles.
+ */
+void analyzeLoci(std::vector<ChromosomeInfo> const& infos, unsigned begin, unsigned end, std::vector<LocusStats> &out) {
+	static thread_local FlatMap<uint64_t, unsigned> counts;
+	for (unsigned locus = begin; locus < end; locus++) {
+		counts.clear();
+		unsigned n = 0;
+		for (auto &info : infos) {
+			if (info.alleles.size() <= locus)
+				continue;
+			counts[info.alleles[locus]]++;
+			n++;
+		}
+		if (n < 2)
+			continue;
+		double sumSquares = 0;
+		counts.forEach([&sumSquares, n] (uint64_t, unsigned count) {
+			double p = (double)count / n;
+			sumSquares += p * p;
+		});
+		out[locus].diversity = (float)(n / (n - 1.0) * (1 - sumSquares));
+		out[locus].alleles = counts.size();
+		out[locus].valid = true;
+	}
+}
+
+} // namespace
+
+PopulationStatistics::Report PopulationStatistics::analyze(Snapshot const& snapshot, unsigned distanceSamples, ThreadPool &pool) {
+	PERF_MARKER_FUNC;
+	Report r;
+	r.simulationTime = snapshot.simulationTime;
+	r.bugs = snapshot.genomes.size();
+	r.gametes = snapshot.gametes.size();
+
+	// chromosomes [2k, 2k+1] belong to bug k, the gametes come after them:
+	std::vector<Chromosome const*> chromosomes;
+	chromosomes.reserve(2 * snapshot.genomes.size() + snapshot.gametes.size());
+	for (auto &g : snapshot.genomes) {
+		chromosomes.push_back(&g.first);
+		chromosomes.push_back(&g.second);
+	}
+	for (auto &c : snapshot.gametes)
+		chromosomes.push_back(&c);
+	r.chromosomes = chromosomes.size();
+	if (chromosomes.empty())
+		return r;
+
+	std::vector<ChromosomeInfo> infos(chromosomes.size());
+	std::vector<unsigned> indices(chromosomes.size());
+	std::iota(indices.begin(), indices.end(), 0);
+	parallel_for(indices.begin(), indices.end(), pool, [&] (unsigned i) {
+		describe(*chromosomes[i], infos[i]);
+	});
+
+	// lengths and gene types:
+	std::vector<unsigned> lengths;
+	lengths.reserve(infos.size());
+	std::array<size_t, nGeneTypes> typeCounts {};
+	size_t totalGenes = 0;
+	for (auto &info : infos) {
+		lengths.push_back(info.alleles.size());
+		totalGenes += info.alleles.size();
+		for (unsigned t=0; t<nGeneTypes; t++)
+			typeCounts[t] += info.typeCounts[t];
+	}
+	std::sort(lengths.begin(), lengths.end());
+	r.lengthMin = lengths.front();
+	r.lengthP10 = percentile(lengths, 0.1f);
+	r.lengthMedian = percentile(lengths, 0.5f);
+	r.lengthP90 = percentile(lengths, 0.9f);
+	r.lengthMax = lengths.back();
+	r.lengthMean = (float)totalGenes / lengths.size();
+	for (unsigned t=0; t<nGeneTypes; t++)
+		r.geneTypeFrequency[t] = totalGenes ? (float)typeCounts[t] / totalGenes : 0.f;
+
+	// allele diversity, in chunks of loci:
+	std::vector<LocusStats> loci(r.lengthMax);
+	std::vector<unsigned> chunks;
+	for (unsigned l=0; l<r.lengthMax; l+=lociPerJob)
+		chunks.push_back(l);
+	parallel_for(chunks.begin(), chunks.end(), pool, [&] (unsigned begin) {
+		analyzeLoci(infos, begin, std::min(begin + lociPerJob, r.lengthMax), loci);
+	});
+	unsigned validLoci = 0;
+	double diversitySum = 0, allelesSum = 0;
+	for (auto &l : loci) {
+		if (!l.valid)
+			continue;
+		validLoci++;
+		diversitySum += l.diversity;
+		allelesSum += l.alleles;
+	}
+	if (validLoci) {
+		r.alleleDiversity = diversitySum / validLoci;
+		r.allelesPerLocus = allelesSum / validLoci;
+	}
+
+	// genome distances; if there are few bugs, all the pairs are compared:
+	size_t nBugs = snapshot.genomes.size();
+	if (nBugs < 2 || distanceSamples == 0)
+		return r;
+	std::vector<std::pair<unsigned, unsigned>> pairs;
+	if (nBugs * (nBugs - 1) / 2 <= distanceSamples) {
+		for (unsigned a=0; a<nBugs; a++)
+			for (unsigned b=a+1; b<nBugs; b++)
+				pairs.push_back(std::make_pair(a, b));
+	} else {
+		for (unsigned i=0; i<distanceSamples; i++) {
+			unsigned a = randi(nBugs - 1);
+			unsigned b = randi(nBugs - 2);
+			if (b >= a)
+				b++;	// b != a
+			pairs.push_back(std::make_pair(a, b));
+		}
+	}
+	std::vector<float> distances(pairs.size());
+	std::vector<unsigned> pairIndices(pairs.size());
+	std::iota(pairIndices.begin(), pairIndices.end(), 0);
+	parallel_for(pairIndices.begin(), pairIndices.end(), pool, [&] (unsigned i) {
+		unsigned a = pairs[i].first, b = pairs[i].second;
+		distances[i] = 0.5f * (distance(infos[2*a].alleles, infos[2*b].alleles)
+				+ distance(infos[2*a+1].alleles, infos[2*b+1].alleles));
+	});
+	r.distanceSamples = distances.size();
+	r.distanceMin = *std::min_element(distances.begin(), distances.end());
+	r.distanceMax = *std::max_element(distances.begin(), distances.end());
+	r.distanceMean = std::accumulate(distances.begin(), distances.end(), 0.0) / distances.size();
+	return r;
+}
+
+static const char* geneTypeName(unsigned type) {
+	switch ((gene_type)type) {
+	case gene_type::NO_OP: return "no_op";
+	case gene_type::START_MARKER: return "start_marker";
+	case gene_type::STOP: return "stop";
+	case gene_type::SKIP: return "skip";
+	case gene_type::PROTEIN: return "protein";
+	case gene_type::OFFSET: return "offset";
+	case gene_type::JOINT_OFFSET: return "joint_offset";
+	case gene_type::PART_ATTRIBUTE: return "part_attribute";
+	case gene_type::BODY_ATTRIBUTE: return "body_attribute";
+	case gene_type::SYNAPSE: return "synapse";
+	case gene_type::TRANSFER_FUNC: return "transfer_func";
+	case gene_type::NEURAL_BIAS: return "neural_bias";
+	case gene_type::NEURON_OUTPUT_COORD: return "neuron_output_coord";
+	case gene_type::NEURON_INPUT_COORD: return "neuron_input_coord";
+	case gene_type::NEURAL_PARAM: return "neural_param";
+	default: return nullptr;
+	}
+}
+
+void PopulationStatistics::writeCSVHeader(std::ostream &out) {
+	out << "sim_time,bugs,gametes,chromosomes"
+		<< ",length_min,length_p10,length_median,length_p90,length_max,length_mean";
+	for (unsigned t=0; t<nGeneTypes; t++)
+		if (geneTypeName(t))
+			out << ",freq_" << geneTypeName(t);
+	out << ",allele_diversity,alleles_per_locus"
+		<< ",distance_samples,distance_mean,distance_min,distance_max\n";
+}
+
+void PopulationStatistics::writeCSVRow(std::ostream &out, Report const& r) {
+	out << r.simulationTime << "," << r.bugs << "," << r.gametes << "," << r.chromosomes
+		<< "," << r.lengthMin << "," << r.lengthP10 << "," << r.lengthMedian << "," << r.lengthP90 << "," << r.lengthMax
+		<< "," << r.lengthMean;
+	for (unsigned t=0; t<nGeneTypes; t++)
+		if (geneTypeName(t))
+			out << "," << r.geneTypeFrequency[t];
+	out << "," << r.alleleDiversity << "," << r.allelesPerLocus
+		<< "," << r.distanceSamples << "," << r.distanceMean << "," << r.distanceMin << "," << r.distanceMax << "\n";
+}
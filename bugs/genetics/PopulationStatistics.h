@@ -0,0 +1,74 @@
+/*
+ * PopulationStatistics.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef GENETICS_POPULATIONSTATISTICS_H_
+#define GENETICS_POPULATIONSTATISTICS_H_
+
+#include "Genome.h"
+#include <vector>
+#include <array>
+#include <ostream>
+
+class ThreadPool;
+
+/*
+ * Statistics over the genetic material of a whole population: the genomes of the living bugs and the chromosomes
+ * of the free gametes.
+ *
+ * Alleles are identified by the gene type and the values of the gene's atoms (meta-genes are left out, like in the
+ * PhenotypeCache key); a locus is a position in the chromosome.
+ * The work is done in parallel on a thread pool, over a snapshot of the population, so nothing in the world is
+ * touched while the statistics are computed.
+ */
+class PopulationStatistics {
+public:
+	static constexpr unsigned nGeneTypes = (unsigned)gene_type::END + 1;
+
+	// the population's genetic material; copying chromosomes is cheap since their gene segments are shared
+	struct Snapshot {
+		float simulationTime = 0;
+		std::vector<Genome> genomes;			// one for each living bug
+		std::vector<Chromosome> gametes;
+	};
+
+	struct Report {
+		float simulationTime = 0;
+		unsigned bugs = 0;
+		unsigned gametes = 0;
+		unsigned chromosomes = 0;
+
+		// chromosome length distribution:
+		unsigned lengthMin = 0;
+		unsigned lengthP10 = 0;
+		unsigned lengthMedian = 0;
+		unsigned lengthP90 = 0;
+		unsigned lengthMax = 0;
+		float lengthMean = 0;
+
+		// fraction of all genes that have each type (indexed by gene_type)
+		std::array<float, nGeneTypes> geneTypeFrequency {};
+
+		// the chance that two random chromosomes carry different alleles at a locus, averaged over all loci
+		float alleleDiversity = 0;
+		float allelesPerLocus = 0;
+
+		// distance between random pairs of bug genomes: the fraction of loci that differ
+		unsigned distanceSamples = 0;
+		float distanceMean = 0;
+		float distanceMin = 0;
+		float distanceMax = 0;
+	};
+
+	// [distanceSamples] is the number of random pairs of genomes that are compared
+	static Report analyze(Snapshot const& snapshot, unsigned distanceSamples, ThreadPool &pool);
+
+	// time series output, one line for each report
+	static void writeCSVHeader(std::ostream &out);
+	static void writeCSVRow(std::ostream &out, Report const& report);
+};
+
+#endif /* GENETICS_POPULATIONSTATISTICS_H_ */
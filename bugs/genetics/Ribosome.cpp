@@ -21,6 +21,9 @@
 #include "Genome.h"
 #include "GeneDefinitions.h"
 #include "CummulativeValue.h"
+#include "PhenotypeCache.h"
+#include "PhenotypeDecoder.h"
+#include "../Infrastructure.h"
 #include "../utils/log.h"
 #include "../math/math3D.h"
 #include "../utils/rand.h"
@@ -36,27 +39,35 @@
 Ribosome::Ribosome(Bug* bug)
 	: bug_{bug}
 {
-	// there are no default body parts; they either get created by the genes, or the embryo
-	// is discarded at the end of development if it lacks critical parts such as mouth or egg-layer
-
-	// start decoding with root body part at offset 0 in the genome:
-	activeSet_.push_back(std::make_pair(bug_->body_, 0));
+	PhenotypeCache::Key key = PhenotypeCache::makeKey(bug_->genome_);
+	phenotype_ = PhenotypeCache::get().find(key);
+	if (phenotype_)
+		return;
+	// decode the genome in the background, the result is needed only at the end of the development:
+	std::shared_ptr<DecodeJob> job = std::make_shared<DecodeJob>();
+	job->genome = bug_->genome_;
+	job->key = std::move(key);
+	decodeJob_ = job;
+	decodeTask_ = Infrastructure::getThreadPool().queueTask([job] {
+		std::shared_ptr<const Phenotype> phenotype = std::make_shared<const Phenotype>(PhenotypeDecoder::decode(job->genome));
+		PhenotypeCache::get().insert(std::move(job->key), phenotype);
+		job->result = std::move(phenotype);
+	});
 }
 
 Ribosome::~Ribosome() {
+	// an unfinished decode job is left to finish on its own, it doesn't refer to this object
 	cleanUp();
 }
 
 void Ribosome::cleanUp() {
-	neuralGenes_.clear();
-	activeSet_.clear();
-	mapNeurons_.clear();
-	mapSynapses_.clear();
-	outputNeurons_.clear();
-	inputNeurons_.clear();
+	parts_.clear();
 	motors_.clear();
 	sensors_.clear();
 	mapInputNerves_.clear();
+	phenotype_.reset();
+	decodeJob_.reset();
+	decodeTask_.reset();
 }
 
 // compares two unsigned longs as if they were expressed as coordinates in a circular scale
@@ -73,45 +84,44 @@ void Ribosome::cleanUp() {
 //	return d1 < d2;
 //}
 
+
 void Ribosome::initializeNeuralNetwork() {
 	// create and initialize the neural network:
 	bug_->neuralNet_ = new NeuralNet();
-	bug_->neuralNet_->neurons.reserve(mapNeurons_.size());
-	for (uint i=0; i<mapNeurons_.size(); i++) {
+	bug_->neuralNet_->neurons.reserve(phenotype_->neuronCount);
+	for (uint i=0; i<phenotype_->neuronCount; i++) {
 		bug_->neuralNet_->neurons.push_back(new Neuron());
 	}
 #ifdef DEBUG
-	for (auto const& it : mapNeurons_) {
-		mapNeuronVirtIndex_[bug_->neuralNet_->neurons[it.second.index]] = it.first;
+	for (uint i=0; i<phenotype_->neuronCount; i++) {
+		int virtualIndex = phenotype_->neurons[i].virtualIndex;
+		mapNeuronVirtIndex_[bug_->neuralNet_->neurons[i]] = virtualIndex;
 		if (false) {
-			LOGLN("Neuron MAPPING: " << it.first << "(v) -> " << it.second.index << "(r)" << "\t" << bug_->neuralNet_->neurons[it.second.index]);
+			LOGLN("Neuron MAPPING: " << virtualIndex << "(v) -> " << i << "(r)" << "\t" << bug_->neuralNet_->neurons[i]);
 		}
 	}
 #endif
 }
 
-void Ribosome::decodeDeferredGenes() {
-	// create all synapses
-	for (auto s : mapSynapses_) {
-		int32_t from = s.first >> 32;
-		int32_t to = (s.first) & 0xFFFFFFFF;
-		createSynapse(from, to, s.second);
-	}
-	// now decode the deferred neural genes (neuron properties):
-	for (auto &g : neuralGenes_)
-		decodeGene(*g, nullptr, nullptr, false);
-	// apply all neuron properties
-	for (auto &n : mapNeurons_) {
-		if (n.second.transfer.hasValue()) {
-			int funcIndex = clamp((int)n.second.transfer.get(),
+void Ribosome::createSynapses() {
+	for (auto &s : phenotype_->synapses)
+		createSynapse(s.from, s.to, s.info);
+}
+
+void Ribosome::applyNeuronProperties() {
+	// the neurons past neuronCount are mapped only by the neural genes, they don't participate in any synapses
+	for (uint index=0; index<phenotype_->neuronCount; index++) {
+		NeuronInfo const& n = phenotype_->neurons[index];
+		if (n.transfer.hasValue()) {
+			int funcIndex = clamp((int)n.transfer.get(),
 					(int)transferFuncNames::FN_ONE,
 					(int)transferFuncNames::FN_MAXCOUNT-1);
-			bug_->neuralNet_->neurons[n.second.index]->setTranferFunction((transferFuncNames)funcIndex);
+			bug_->neuralNet_->neurons[index]->setTranferFunction((transferFuncNames)funcIndex);
 		}
-		if (n.second.bias.hasValue())
-			bug_->neuralNet_->neurons[n.second.index]->inputBias = n.second.bias;
-		if (n.second.param.hasValue())
-			bug_->neuralNet_->neurons[n.second.index]->neuralParam = n.second.param;
+		if (n.bias.hasValue())
+			bug_->neuralNet_->neurons[index]->inputBias = n.bias;
+		if (n.param.hasValue())
+			bug_->neuralNet_->neurons[index]->neuralParam = n.param;
 	}
 }
 
@@ -122,213 +132,111 @@ void Ribosome::sortNervesByVMSCoord(std::vector<InputOutputNerve<T>> &nerves) {
 	});
 }
 
+
 bool Ribosome::step() {
 	LOGPREFIX("Ribosome");
-	if (activeSet_.empty()) {
-		// finished decoding all body parts.
-
-		// check if critical body parts exist (at least a mouth and egg-layer)
-		bool hasMouth = false, hasEggLayer = false;
-		bug_->body_->applyRecursive([&hasMouth, &hasEggLayer, this] (BodyPart* p) {
-			if (p->getType() == BodyPartType::MOUTH)
-				hasMouth = true;
-			if (p->getType() == BodyPartType::EGGLAYER) {
-				hasEggLayer = true;
-				((EggLayer*)p)->setTargetEggMass(bug_->eggMass_);
-			}
-			return hasMouth && hasEggLayer;
-		});
-		if (!hasMouth || !hasEggLayer) {
-			// here mark the embryo as dead and return
-			bug_->isAlive_ = false;
-			cleanUp();
-			return false;
+	if (!phenotype_) {
+		if (decodeTask_->isFinished()) {
+			phenotype_ = decodeJob_->result;
+			decodeJob_.reset();
+			decodeTask_.reset();
 		}
+	}
+	// take as long as the decoding of the genes takes (one gene per development branch per step):
+	if (!phenotype_ || nSteps_ < phenotype_->developmentSteps) {
+		nSteps_++;
+		return true;
+	}
 
-		// link all muscles to joints:
-		resolveMuscleLinkage();
-
-		// now decode the neural network:
-		initializeNeuralNetwork();
-		decodeDeferredGenes();
-		// link nerves to sensors and motors:
-		resolveNerveLinkage();
-		// commit neuron properties:
-		commitNeurons();
-
-		// clean up:
+	// finished developing.
+	if (!phenotype_->viable) {
+		// the embryo lacks critical body parts (at least a mouth and egg-layer are needed)
+		// here mark the embryo as dead and return
+		bug_->isAlive_ = false;
 		cleanUp();
-
 		return false;
 	}
-	unsigned nCrtBranches = activeSet_.size();
-	for (unsigned i=0; i<nCrtBranches; i++) {
-#ifdef ENABLE_START_MARKER_GENES
-		if (activeSet_[i].second.crtGenomePos == activeSet_[i].second.startGenomePos) {
-			// move forward until we hit a start marker
-			auto &c1 = bug_->genome_.first.genes;
-			auto &c2 = bug_->genome_.second.genes;
-			auto &offs = activeSet_[i].second.crtGenomePos;
-			while ((c1.size() > offs && c1[offs].type != gene_type::START_MARKER)
-				|| (c2.size() > offs && c2[offs].type != gene_type::START_MARKER)) {
-				activeSet_[i].second.crtGenomePos++;
-				// did we hit a marker?
-				if ((c1.size() > offs && c1[offs].type == gene_type::START_MARKER)
-					|| (c2.size() > offs && c2[offs].type == gene_type::START_MARKER))
-					break;
-			}
-		}
-#endif
-		BodyPart* p = activeSet_[i].first;
-		unsigned offset = activeSet_[i].second.crtGenomePos++;
-		Gene *g1 = nullptr, *g2 = nullptr;
-		if (offset < bug_->genome_.first.genes.size())
-			g1 = &bug_->genome_.first.genes[offset];
-		if (offset < bug_->genome_.second.genes.size())
-			g2 = &bug_->genome_.second.genes[offset];
-		bool reachedTheEnd = !g1 && !g2;
-		if (reachedTheEnd
-				|| (g1 && g1->type == gene_type::STOP)
-				|| (g2 && g2->type == gene_type::STOP)) {
-			// so much for this development path;
-			// grow body parts from all segments now
-			for (unsigned k=0; k<BodyPart::MAX_CHILDREN; k++)
-				growBodyPart(p, k, activeSet_[i].second.hyperPositions[k],
-						activeSet_[i].second.startGenomePos + activeSet_[i].second.offsets[k]);
-			// decode joint genes if such is the case:
-			auto it = mapJointOffsets_.find(p);
-			if (it != mapJointOffsets_.end()) {
-				Joint* joint = it->second.first;
-				int jOffset = it->second.second.hasValue() ? it->second.second : 0;
-				activeSet_.push_back(std::make_pair(joint, activeSet_[i].second.startGenomePos + jOffset));
-			}
-			// and remove this branch:
-			activeSet_.erase(activeSet_.begin()+i);
-			i--, nCrtBranches--;
-			continue;
-		}
 
-		// now decode the genes:
-		if (g1)
-			decodeGene(*g1, p, &activeSet_[i].second, true);
-		if (g2)
-			decodeGene(*g2, p, &activeSet_[i].second, true);
-
-		int skipCount = 0;
-		if (g1 && g1->type == gene_type::SKIP) {
-			int depth = p->getDepth();
-			if (depth <= g1->data.gene_skip.maxDepth && depth >= g1->data.gene_skip.minDepth)
-				skipCount += g1->data.gene_skip.count;
-		}
-		if (g2 && g2->type == gene_type::SKIP) {
-			int depth = p->getDepth();
-			if (depth <= g2->data.gene_skip.maxDepth && depth >= g2->data.gene_skip.minDepth) {
-				if (skipCount)
-					skipCount = (skipCount + g2->data.gene_skip.count) / 2;
-				else
-					skipCount = g2->data.gene_skip.count;
-			}
-		}
-		activeSet_[i].second.crtGenomePos += skipCount;
-	}
-	return true;
-}
+	// create all the body parts:
+	instantiatePhenotype();
+	setupEggLayers();
 
-void Ribosome::growBodyPart(BodyPart* parent, unsigned attachmentSegment, glm::vec4 hyperPosition, unsigned genomeOffset) {
-	// grow only works on bones and torso
-	if (parent->getType() != BodyPartType::BONE && parent->getType() != BodyPartType::TORSO)
-		return;
-	// determine the body part type to grow from the hyperPosition
-	BodyPartType partTypes[2][2][2][2] = {
-		/* W- */ {
-			/* Z- */ {
-				/* Y- */ {
-					/* X- */ BodyPartType::BONE, /* X+ */ BodyPartType::INVALID
-				},
-				/* Y+ */ {
-					/* X- */ BodyPartType::GRIPPER, /* X+ */ BodyPartType::MOUTH
-				},
-			},
-			/* Z+ */ {
-				/* Y- */ {
-					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
-				},
-				/* Y+ */ {
-					/* X- */ BodyPartType::MUSCLE, /* X+ */ BodyPartType::EGGLAYER
-				},
-			},
-		},
-		/* W+ */ {
-			/* Z- */ {
-				/* Y- */ {
-					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
-				},
-				/* Y+ */ {
-					/* X- */ BodyPartType::SENSOR_PROXIMITY, /* X+ */ BodyPartType::INVALID
-				},
-			},
-			/* Z+ */ {
-				/* Y- */ {
-					/* X- */ BodyPartType::INVALID, /* X+ */ BodyPartType::INVALID
-				},
-				/* Y+ */ {
-					/* X- */ BodyPartType::SENSOR_COMPASS, /* X+ */ BodyPartType::SENSOR_SIGHT
-				},
-			},
-		}
-	};
-	// if any one axis is zero, we cannot determine the part type and none is grown
-	if (hyperPosition.x * hyperPosition.y * hyperPosition.z * hyperPosition.w == 0)
-		return;
-	BodyPartType newBodyPartType = partTypes[hyperPosition.w > 0][hyperPosition.z > 0][hyperPosition.y > 0][hyperPosition.x > 0];
-	if (newBodyPartType == BodyPartType::INVALID)
-		return;
-
-	// TODO Auto-generate body-part-sensors in joints & grippers and other parts that may have useful info
+	// link all muscles to joints:
+	resolveMuscleLinkage();
 
-	float angle = attachmentSegment * 2*PI / BodyPart::MAX_CHILDREN;
+	// now create the neural network:
+	initializeNeuralNetwork();
+	createSynapses();
+	applyNeuronProperties();
+	// link nerves to sensors and motors:
+	resolveNerveLinkage();
+	// commit neuron properties:
+	commitNeurons();
 
-	// The child's attachment point relative to the parent's center is computed from the angle of the current segment,
-	// by casting a ray from the parent's origin in the specified angle (which is relative to the parent's orientation)
-	// until it touches an edge of the parent. That point is used as attachment of the new part.
+	// clean up:
+	cleanUp();
 
-	Joint* upstreamJoint = nullptr;
-	bool useUpstreamJoint = partMustGenerateJoint(newBodyPartType);
-	if (useUpstreamJoint) {
-		// we cannot grow this part directly onto its parent, they must be connected by a joint
-		upstreamJoint = new Joint();
-		parent->add(upstreamJoint, angle);
+	return false;
+}
 
-		// set part to point to the joint's node, since that's where the actual part will be attached:
-		parent = upstreamJoint;
-		// recompute coordinates in joint's space:
-		angle = 0;
+void Ribosome::instantiatePhenotype() {
+	Phenotype const& phenotype = *phenotype_;
+	parts_.push_back(bug_->body_);
+	for (unsigned i=1; i<phenotype.parts.size(); i++) {
+		Phenotype::Part const& p = phenotype.parts[i];
+		assertDbg(p.parentIndex >= 0 && p.parentIndex < (int)i);
+		IMotor* pMotor = nullptr;
+		ISensor* pSensor = nullptr;
+		BodyPart* bp = createBodyPart(p.type, pMotor, pSensor);
+		assertDbg(bp);
+		attachBodyPart(parts_[p.parentIndex], bp, p.angle, pMotor, pSensor);
+	}
+	// apply the attributes from the genes over the parts' default values:
+	for (unsigned i=0; i<phenotype.parts.size(); i++) {
+#ifdef DEBUG
+		for (gene_part_attribute_type a=GENE_ATTRIB_INVALID+1; a<GENE_ATTRIB_END; a++)
+			assertDbg(parts_[i]->getAttributeCount(a) == PhenotypeDecoder::getAttributeSlotCount(phenotype.parts[i].type, a)
+					&& "PhenotypeDecoder's attribute slots don't match the body part's attributes");
+#endif
+		for (auto &a : phenotype.parts[i].attributes) {
+			CummulativeValue* pAttrib = parts_[i]->getAttribute(a.attribute, a.index);
+			if (pAttrib)
+				pAttrib->merge(a.value);
+		}
+	}
+	for (auto &a : phenotype.bodyAttributes) {
+		auto it = bug_->mapBodyAttributes_.find(a.first);
+		if (it != bug_->mapBodyAttributes_.end())
+			it->second->merge(a.second);
 	}
+}
 
+BodyPart* Ribosome::createBodyPart(BodyPartType type, IMotor* &outMotor, ISensor* &outSensor) {
 	BodyPart* bp = nullptr;
-	IMotor* pMotor = nullptr;
-	ISensor* pSensor = nullptr;
-	switch (newBodyPartType) {
+	switch (type) {
+	case BodyPartType::JOINT:
+		bp = new Joint(bug_->getWorld());
+		break;
 	case BodyPartType::BONE:
-		bp = new Bone();
+		bp = new Bone(bug_->getWorld());
 		break;
 	case BodyPartType::GRIPPER: {
-		Gripper* gr = new Gripper();
-		pMotor = gr;
+		Gripper* gr = new Gripper(bug_->getWorld());
+		outMotor = gr;
 		bp = gr;
 		break;
 	}
 	case BodyPartType::MUSCLE: {
 		// muscle must be linked to the nearest joint - or one towards which it's oriented if equidistant
 		// linkage is postponed until before commit when all parts are in place (muscle may be created before joint)
-		Muscle* m = new Muscle();
+		Muscle* m = new Muscle(bug_->getWorld());
 		muscles_.push_back(m);
-		pMotor = m;
+		outMotor = m;
 		bp = m;
 		break;
 	}
 	case BodyPartType::MOUTH: {
-		Mouth* m = new Mouth();
+		Mouth* m = new Mouth(bug_->getWorld());
 		bp = m;
 		break;
 	}
@@ -339,8 +247,8 @@ void Ribosome::growBodyPart(BodyPart* parent, unsigned attachmentSegment, glm::v
 		// bp = new sensortype?(part->bodyPart, PhysicsProperties(offset, angle));
 //		break;
 	case BodyPartType::SENSOR_PROXIMITY: {
-		Nose* n = new Nose();
-		pSensor = n;
+		Nose* n = new Nose(bug_->getWorld());
+		outSensor = n;
 		bp = n;
 		break;
 	}
@@ -348,34 +256,35 @@ void Ribosome::growBodyPart(BodyPart* parent, unsigned attachmentSegment, glm::v
 		// bp = new sensortype?(part->bodyPart, PhysicsProperties(offset, angle));
 		break;
 	case BodyPartType::EGGLAYER: {
-		EggLayer* e = new EggLayer();
-		pMotor = e;
+		EggLayer* e = new EggLayer(bug_->getWorld());
+		outMotor = e;
 		bug_->eggLayers_.push_back(e);
 		bp = e;
 		break;
 	}
 	default:
-		ERROR("unhandled gene part type: "<<(uint)newBodyPartType);
+		ERROR("unhandled gene part type: "<<(uint)type);
 		break;
 	}
-	if (!bp)
-		return;
+	return bp;
+}
 
-	if (useUpstreamJoint) {
-		// add joint mapping to this part:
-		mapJointOffsets_[bp] = std::make_pair(upstreamJoint, CummulativeValue());
-	}
 
-	parent->add(bp, angle);
+void Ribosome::attachBodyPart(BodyPart* parent, BodyPart* part, float angle, IMotor* motor, ISensor* sensor) {
+	parts_.push_back(part);
+	parent->add(part, angle);
 
 	// this must happen AFTER the part is added to its parent:
-	if (pMotor)
-		addMotor(pMotor, bp);
-	if (pSensor)
-		addSensor(pSensor);
+	if (motor)
+		addMotor(motor, part);
+	if (sensor)
+		addSensor(sensor);
+}
 
-	// start a new development path from the new part:
-	activeSet_.push_back(std::make_pair(bp, genomeOffset));
+void Ribosome::setupEggLayers() {
+	for (BodyPart* p : parts_)
+		if (p->getType() == BodyPartType::EGGLAYER)
+			((EggLayer*)p)->setTargetEggMass(bug_->eggMass_);
 }
 
 void Ribosome::addMotor(IMotor* motor, BodyPart* part) {
@@ -389,216 +298,13 @@ void Ribosome::addSensor(ISensor* sensor) {
 	sensors_.push_back(sensor);
 }
 
-bool Ribosome::hasNeuron(int virtualIndex, bool physical) {
-	 bool hasVirtual = mapNeurons_.find(virtualIndex) != mapNeurons_.end();
-	 if (physical)
-		 return hasVirtual && bug_->neuralNet_ && mapNeurons_[virtualIndex].index < bug_->neuralNet_->neurons.size();
-	 else
-		 return hasVirtual;
-}
-
-void Ribosome::checkAndAddNeuronMapping(int virtualIndex) {
-	if (!hasNeuron(virtualIndex, false)) {
-		int realIndex = mapNeurons_.size();
-		mapNeurons_[virtualIndex] = NeuronInfo(realIndex);
-	}
-}
-
-void Ribosome::decodeGene(Gene const& g, BodyPart* part, GrowthData *growthData, bool deferNeural) {
-	switch (g.type) {
-	case gene_type::NO_OP:
-		break;
-#ifdef ENABLE_START_MARKER_GENES
-	case gene_type::START_MARKER:
-		break;
-#endif
-	case gene_type::SKIP:
-		break;
-	case gene_type::STOP:
-		break;
-	case gene_type::PROTEIN:
-		decodeProtein(g.data.gene_protein, part, growthData);
-		break;
-	case gene_type::OFFSET:
-		decodeOffset(g.data.gene_offset, part, growthData);
-		break;
-	case gene_type::JOINT_OFFSET:
-		decodeJointOffset(g.data.gene_joint_offset, part);
-		break;
-	case gene_type::PART_ATTRIBUTE:
-		decodePartAttrib(g.data.gene_attribute, part);
-		break;
-	case gene_type::BODY_ATTRIBUTE:
-		bug_->mapBodyAttributes_[g.data.gene_body_attribute.attribute]->changeAbs(g.data.gene_body_attribute.value);
-		break;
-	case gene_type::SYNAPSE:
-		// only from depth 0 (torso) must the neural genes be taken into account
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			decodeSynapse(g.data.gene_synapse);
-		}
-		break;
-	case gene_type::NEURON_OUTPUT_COORD:
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			if (deferNeural)
-				neuralGenes_.push_back(&g);
-			else
-				decodeNeuronOutputCoord(g.data.gene_neuron_output);
-		}
-		break;
-	case gene_type::NEURON_INPUT_COORD:
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			if (deferNeural)
-				neuralGenes_.push_back(&g);
-			else
-				decodeNeuronInputCoord(g.data.gene_neuron_input);
-		}
-		break;
-	case gene_type::TRANSFER_FUNC:
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			if (deferNeural)
-				neuralGenes_.push_back(&g);
-			else
-				decodeTransferFn(g.data.gene_transfer_function);
-		}
-		break;
-	case gene_type::NEURAL_BIAS:
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			if (deferNeural)
-				neuralGenes_.push_back(&g);
-			else
-				decodeNeuralBias(g.data.gene_neural_constant);
-		}
-		break;
-	case gene_type::NEURAL_PARAM:
-		if (!part || part->getType() == BodyPartType::TORSO) {
-			if (deferNeural)
-				neuralGenes_.push_back(&g);
-			else
-				decodeNeuralParam(g.data.gene_neural_param);
-		}
-		break;
-	default:
-		ERROR("Unhandled gene type : " << (uint)g.type);
-	}
-}
-
-bool Ribosome::partMustGenerateJoint(BodyPartType part_type) {
-	switch (part_type) {
-	case BodyPartType::BONE:
-	case BodyPartType::GRIPPER:
-		return true;
-	default:
-		return false;
-	}
-}
-
-void Ribosome::decodeProtein(GeneProtein const& g, BodyPart* part, GrowthData *growthData) {
-	int crtDepth = part->getDepth();
-	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
-		return;
-	uint segment = clamp<int>(g.targetSegment, 0, BodyPart::MAX_CHILDREN-1);
-	glm::vec4 &pos = growthData->hyperPositions[segment];
-	switch (g.protein) {
-	case GENE_PROT_A:
-		pos.x--;
-		break;
-	case GENE_PROT_B:
-		pos.x++;
-		break;
-	case GENE_PROT_C:
-		pos.y--;
-		break;
-	case GENE_PROT_D:
-		pos.y++;
-		break;
-	case GENE_PROT_E:
-		pos.z--;
-		break;
-	case GENE_PROT_F:
-		pos.z++;
-		break;
-	case GENE_PROT_G:
-		pos.w--;
-		break;
-	case GENE_PROT_H:
-		pos.w++;
-		break;
-	}
-}
-
-void Ribosome::decodeOffset(GeneOffset const& g, BodyPart *part, GrowthData *growthData) {
-	int crtDepth = part->getDepth();
-	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
-		return;
-	uint segment = clamp<int>(g.targetSegment, 0, BodyPart::MAX_CHILDREN-1);
-	growthData->offsets[segment].changeAbs(g.offset);
-}
-
-void Ribosome::decodeJointOffset(GeneJointOffset const& g, BodyPart* part) {
-	int crtDepth = part->getDepth();
-	if (crtDepth < g.minDepth || crtDepth > g.maxDepth)
-		return;
-	if (mapJointOffsets_.find(part) != mapJointOffsets_.end())
-		mapJointOffsets_[part].second.changeAbs(g.offset);
-}
-
-void Ribosome::decodePartAttrib(GeneAttribute const& g, BodyPart* part) {
-	int depth = part->getDepth();
-	if (depth >= g.minDepth && depth <= g.maxDepth)
-	{
-		CummulativeValue* pAttrib = part->getAttribute(g.attribute, g.attribIndex);
-		if (pAttrib)
-			pAttrib->changeAbs(g.value);
-	}
-}
-
-void Ribosome::decodeSynapse(GeneSynapse const& g) {
-	// the number of neurons is derived from the synapse values
-	checkAndAddNeuronMapping(g.from);
-	checkAndAddNeuronMapping(g.to);
-	uint64_t key = synKey(g.from, g.to);
-	assert(!std::isnan(g.weight.value));
-	mapSynapses_[key].weight.changeAbs(g.weight);
-	mapSynapses_[key].priority.changeAbs(g.priority);
-}
-
-void Ribosome::decodeTransferFn(GeneTransferFunction const& g) {
-	if (hasNeuron(g.targetNeuron, false))
-		mapNeurons_[g.targetNeuron].transfer.changeAbs(g.functionID);
-}
-
-void Ribosome::decodeNeuralBias(GeneNeuralBias const& g) {
-	assert(!std::isnan(g.value.value));
-	if (hasNeuron(g.targetNeuron, false))
-		mapNeurons_[g.targetNeuron].bias.changeAbs(g.value);
-}
-
-void Ribosome::decodeNeuralParam(GeneNeuralParam const& g) {
-	assert(!std::isnan(g.value.value));
-	if (hasNeuron(g.targetNeuron, false))
-		mapNeurons_[g.targetNeuron].param.changeAbs(g.value);
-}
-
-void Ribosome::decodeNeuronOutputCoord(GeneNeuronOutputCoord const& g) {
-	checkAndAddNeuronMapping(g.srcNeuronVirtIndex);
-	mapNeurons_[g.srcNeuronVirtIndex].outputVMSCoord.changeAbs(g.outCoord);
-	// add this neuron into the outputNeurons_ set:
-	outputNeurons_.insert(g.srcNeuronVirtIndex);
-}
-
-void Ribosome::decodeNeuronInputCoord(GeneNeuronInputCoord const& g) {
-	checkAndAddNeuronMapping(g.destNeuronVirtIndex);
-	mapNeurons_[g.destNeuronVirtIndex].inputVMSCoord.changeAbs(g.inCoord);
-	// add this neuron into the inputNeurons_ set:
-	inputNeurons_.insert(g.destNeuronVirtIndex);
-}
 
 void Ribosome::createSynapse(int from, int to, SynapseInfo const& info) {
-	assertDbg(hasNeuron(from, true));	// should be there, since synapses dictate neurons
-	assertDbg(hasNeuron(to, true));
+	// should be there, since synapses dictate neurons
+	assertDbg(from >= 0 && from < (int)phenotype_->neuronCount && to >= 0 && to < (int)phenotype_->neuronCount);
 
-	OutputSocket* pFrom = &bug_->neuralNet_->neurons[mapNeurons_[from].index]->output;
-	Neuron* pTo = bug_->neuralNet_->neurons[mapNeurons_[to].index];
+	OutputSocket* pFrom = &bug_->neuralNet_->neurons[from]->output;
+	Neuron* pTo = bug_->neuralNet_->neurons[to];
 
 	InputSocket* i = new InputSocket(pTo, info.weight);
 	pTo->addInput(std::unique_ptr<InputSocket>(i), info.priority);
@@ -737,20 +443,18 @@ void Ribosome::resolveNerveLinkage() {
 	}
 	// build the neuron vectors:
 	std::vector<InputOutputNerve<Neuron*>> inputNeurons;
-	for (int i : inputNeurons_) {
-		if (!hasNeuron(i, true))
+	for (int index : phenotype_->inputNeurons) {
+		if (index >= (int)phenotype_->neuronCount)
 			continue; // this neuron doesn't actually exist because it doesn't participate in any synapses
-		Neuron* neuron = bug_->neuralNet_->neurons[mapNeurons_[i].index];
-		float vmsCoord = mapNeurons_[i].inputVMSCoord;
-		inputNeurons.push_back(std::make_pair(neuron, vmsCoord));
+		float vmsCoord = phenotype_->neurons[index].inputVMSCoord;
+		inputNeurons.push_back(std::make_pair(bug_->neuralNet_->neurons[index], vmsCoord));
 	}
 	std::vector<InputOutputNerve<Neuron*>> outputNeurons;
-	for (int i : outputNeurons_) {
-		if (!hasNeuron(i, true))
+	for (int index : phenotype_->outputNeurons) {
+		if (index >= (int)phenotype_->neuronCount)
 			continue; // this neuron doesn't actually exist because it doesn't participate in any synapses
-		Neuron* neuron = bug_->neuralNet_->neurons[mapNeurons_[i].index];
-		float vmsCoord = mapNeurons_[i].outputVMSCoord;
-		outputNeurons.push_back(std::make_pair(neuron, vmsCoord));
+		float vmsCoord = phenotype_->neurons[index].outputVMSCoord;
+		outputNeurons.push_back(std::make_pair(bug_->neuralNet_->neurons[index], vmsCoord));
 	}
 	// sort the input/output nerves by their VMS coords, smallest to greatest:
 	sortNervesByVMSCoord(motorInputs);
@@ -764,8 +468,6 @@ void Ribosome::resolveNerveLinkage() {
 
 	motors_.clear();
 	sensors_.clear();
-	inputNeurons_.clear();
-	outputNeurons_.clear();
 }
 
 void Ribosome::commitNeurons() {
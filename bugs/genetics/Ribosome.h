@@ -8,11 +8,15 @@
 #include "Genome.h"
 #include "Gene.h"
 #include "CummulativeValue.h"
+#include "Phenotype.h"
+#include "PhenotypeCache.h"
 #include "../body-parts/BodyPart.h"
-#include <glm/vec4.hpp>
+#include "../utils/ThreadPool.h"
+#include "../utils/FlatMap.h"
 #include <vector>
 #include <set>
 #include <map>
+#include <memory>
 
 class Bug;
 class BodyPart;
@@ -25,46 +29,17 @@ class ISensor;
 class Muscle;
 class Joint;
 
-struct NeuronInfo {
-	int index;
-	CummulativeValue transfer;
-	CummulativeValue bias;
-	CummulativeValue param;
-	CummulativeValue inputVMSCoord;
-	CummulativeValue outputVMSCoord;
-	/*NeuronInfo(int index, float transfer, float constant)
-		: index(index), transfer(transfer), bias(constant) {
-	}*/
-	explicit NeuronInfo(int index)
-		: index(index) {
-	}
-	NeuronInfo(NeuronInfo const& other) = default;
-	NeuronInfo() : index(-1) {
-	}
-};
-
-struct SynapseInfo {
-	CummulativeValue weight;
-	CummulativeValue priority;
-};
-
-struct GrowthData {
-	unsigned startGenomePos; // initial genome offset for this part (children are relative to this one)
-	unsigned crtGenomePos; // current READ position in genome for this part
-	glm::vec4 hyperPositions[BodyPart::MAX_CHILDREN] { glm::vec4() };	// holds hyper-space positions for each segment in a body part
-	CummulativeValue offsets[BodyPart::MAX_CHILDREN]; // holds relative genome offsets for each segment in a body part
-
-	GrowthData(int initialOffs)
-		: startGenomePos(initialOffs), crtGenomePos(initialOffs) {
-	}
-};
-
 template<typename T>
 using InputOutputNerve = std::pair<T, float>;	// first (T) is the nerve pointer, second is the VMS coordinate
 
 /**
- * decodes the entity's genome and builds it step by step. When finished the entity will have its final
+ * builds the entity's body and neural network from its genome, step by step. When finished the entity will have its final
  * shape and preprogrammed functionality, but will be very small in size.
+ *
+ * The genome is decoded into a Phenotype by the PhenotypeDecoder, on the thread pool, as soon as the ribosome is created
+ * (or the phenotype is taken from the PhenotypeCache if an equivalent genome has been decoded before).
+ * The development takes as many steps as the decoding of the genes would, and at the end the phenotype is
+ * instantiated into actual body parts and neurons.
  */
 class Ribosome {
 public:
@@ -81,52 +56,41 @@ public:
 	bool step();
 
 private:
+	struct DecodeJob {
+		Genome genome;
+		PhenotypeCache::Key key;
+		std::shared_ptr<const Phenotype> result;
+	};
+
 	Bug* bug_;
-	std::vector<std::pair<BodyPart*, GrowthData>> activeSet_;
-	std::map<BodyPart*, std::pair<Joint*, CummulativeValue>> mapJointOffsets_;	// maps a body part pointer to its upstream joint
-																	// and relative genome offset of the joint (if joint exists)
+	std::shared_ptr<const Phenotype> phenotype_;
+	std::shared_ptr<DecodeJob> decodeJob_;	// the decoding in progress on the thread pool, if any
+	PoolTaskHandle decodeTask_;
+	unsigned nSteps_ = 0;					// number of development steps so far
+	std::vector<BodyPart*> parts_;			// all the body parts in creation order, parts_[0] is the torso
 	std::vector<Muscle*> muscles_;
-	std::vector<const Gene*> neuralGenes_;
-	std::map<int, NeuronInfo> mapNeurons_;	// maps virtual neuron indices (as encoded in the genes)
-											// to actual indices in the neural network plus cummulative properties
 #ifdef DEBUG
 	std::map<Neuron*, int> mapNeuronVirtIndex_;	// maps neurons to their virtual indices
 	std::map<InputSocket*, std::pair<std::string, int>> mapSockMotorInfo;	// first: motorName, second: inputID
 #endif
-	std::map<uint64_t, SynapseInfo> mapSynapses_;
-	std::set<int> outputNeurons_;	// virtual indices of output neurons
-	std::set<int> inputNeurons_;	// virtual indices of input neurons
 	std::vector<IMotor*> motors_;
 	int nMotorLines_ = 0;
 	std::vector<ISensor*> sensors_;
-	std::map<InputSocket*, int> mapInputNerves_;	// maps inputSockets from motors to motor line indexes
+	FlatMap<InputSocket*, int> mapInputNerves_;	// maps inputSockets from motors to motor line indexes
 
-	void decodeGene(Gene const& g, BodyPart* part, GrowthData *growthData, bool deferNeural);
-	void decodeProtein(GeneProtein const& g, BodyPart* part, GrowthData *growthData);
-	void decodeOffset(GeneOffset const& g, BodyPart* part, GrowthData *growthData);
-	void decodeJointOffset(GeneJointOffset const& g, BodyPart* part);
-	void decodePartAttrib(GeneAttribute const& g, BodyPart* part);
-	void decodeSynapse(GeneSynapse const& g);
-	void decodeTransferFn(GeneTransferFunction const& g);
-	void decodeNeuralBias(GeneNeuralBias const& g);
-	void decodeNeuralParam(GeneNeuralParam const& g);
-	void decodeNeuronOutputCoord(GeneNeuronOutputCoord const& g);
-	void decodeNeuronInputCoord(GeneNeuronInputCoord const& g);
-	bool partMustGenerateJoint(BodyPartType part_type);
-	void growBodyPart(BodyPart* parent, unsigned attachmentSegment, glm::vec4 hyperPosition, unsigned genomeOffset);
+	void instantiatePhenotype();
+	BodyPart* createBodyPart(BodyPartType type, IMotor* &outMotor, ISensor* &outSensor);
+	void attachBodyPart(BodyPart* parent, BodyPart* part, float angle, IMotor* motor, ISensor* sensor);
+	void setupEggLayers();
 	void addMotor(IMotor* motor, BodyPart* part);
 	void addSensor(ISensor* sensor);
 	void resolveMuscleLinkage();
 	Joint* findNearestJoint(Muscle* m, int dir);
 
 	void initializeNeuralNetwork();
-	void decodeDeferredGenes();
-	void checkAndAddNeuronMapping(int virtualIndex);
-	void updateNeuronConstant(int virtualIndex, float constant);
-	bool hasNeuron(int virtualIndex, bool physical); // checks whether a virtual neuron exists and, if requested, its physical equivalent too
-	// Compute a synapse key (unique id for from-to pair:
-	inline uint64_t synKey(uint64_t from, uint64_t to) { return ((from << 32) & 0xFFFFFFFF00000000) | (to & 0xFFFFFFFF); }
-	void createSynapse(int from, int to, SynapseInfo const& info);
+	void createSynapses();
+	void applyNeuronProperties();
+	void createSynapse(int from, int to, SynapseInfo const& info);	// from and to are real neuron indices
 	void resolveNerveLinkage();
 	void commitNeurons();
 	void linkMotorNerves(std::vector<InputOutputNerve<Neuron*>> const& orderedOutputNeurons_,
@@ -26,19 +26,29 @@
 #include "serialization/objectTypes.h"
 #include "session/SessionManager.h"
 #include "session/PopulationManager.h"
+#include "session/IslandMigration.h"
+#include "session/PopulationAnalytics.h"
+#include "session/LineageLog.h"
 #include "Infrastructure.h"
 
 #include "utils/log.h"
 #include "utils/DrawList.h"
 #include "utils/UpdateList.h"
 #include "utils/rand.h"
+#include "utils/parallel.h"
+#include "utils/ObjectPool.h"
 
 #include "perf/marker.h"
 #include "perf/results.h"
 #include "perf/frameCapture.h"
+#include "perf/counters.h"
+#include "perf/mallocCounter.h"
 
-#ifdef DEBUG
 #include "entities/Bug.h"
+#include "body-parts/BodyPart.h"
+#include "genetics/PhenotypeDecoder.h"
+
+#ifdef DEBUG
 #include "body-parts/Torso.h"
 #include "body-parts/sensors/Nose.h"
 #include "neuralnet/OutputSocket.h"
@@ -52,6 +62,9 @@
 #include <functional>
 #include <stdexcept>
 #include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+#include <chrono>
 
 #include <sys/stat.h>
 
@@ -63,6 +76,9 @@ bool skipRendering = true;
 bool updatePaused = false;
 bool slowMo = false;
 bool captureFrame = false;
+bool runAnalytics = false;
+unsigned stepsPerFrame = 1;					// fast-forward multiplier: max number of simulation steps per displayed frame
+constexpr unsigned maxStepsPerFrame = 256;
 b2World *pPhysWld = nullptr;
 PhysicsDebugDraw *pPhysicsDraw = nullptr;
 
@@ -72,7 +88,12 @@ template<> void draw(b2World* wld, RenderContext const &ctx) {
 
 template<> void update(b2World* wld, float dt) {
 	PERF_MARKER_FUNC;
+	static auto &stepNanoseconds = perf::Counters::get("physics-step-ns");
+	static auto &steps = perf::Counters::get("physics-steps");
+	auto tStart = std::chrono::steady_clock::now();
 	wld->Step(dt, 5, 2);
+	stepNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tStart).count();
+	steps++;
 }
 
 template<> void update(std::function<void(float)> *fn, float dt) {
@@ -96,6 +117,15 @@ void onInputEventHandler(InputEvent& ev) {
 	} else if (ev.key == GLFW_KEY_F1) {
 		if (ev.type == InputEvent::EV_KEY_DOWN)
 			captureFrame = true;
+	} else if (ev.key == GLFW_KEY_F2) {
+		if (ev.type == InputEvent::EV_KEY_DOWN)
+			runAnalytics = true;
+	} else if (ev.key == GLFW_KEY_KP_ADD || ev.key == GLFW_KEY_EQUAL) {
+		if (ev.type == InputEvent::EV_KEY_DOWN)
+			stepsPerFrame = std::min(maxStepsPerFrame, stepsPerFrame * 2);
+	} else if (ev.key == GLFW_KEY_KP_SUBTRACT || ev.key == GLFW_KEY_MINUS) {
+		if (ev.type == InputEvent::EV_KEY_DOWN)
+			stepsPerFrame = std::max(1u, stepsPerFrame / 2);
 	}
 }
 
@@ -129,17 +159,95 @@ bool autosave(SessionManager &sessionMgr) {
 void printFrameCaptureData(std::vector<perf::FrameCapture::frameData> data);
 void printTopHits(std::vector<perf::sectionData> data);
 void printCallTree(std::vector<std::shared_ptr<perf::sectionData>> t, int level);
+void printCounters();
 
 #define FFMT(prec, X) std::fixed << std::setprecision(prec) << (X)
 #define IFMT(spac, X) std::fixed << std::setprecision(0) << std::setw(spac) << (X)
 
 void printStatus(float simulationTime, float realTime, float simDTAcc, float realDTAcc, int population, int generations) {
+	static auto &genomeResident = perf::Counters::get("genome-bytes-resident");
+	static auto &genomeLogical = perf::Counters::get("genome-bytes-logical");
+	static auto &phenotypeHits = perf::Counters::get("phenotype-cache-hits");
+	static auto &phenotypeMisses = perf::Counters::get("phenotype-cache-misses");
+	static auto &foodPoolHits = perf::Counters::get("food-pool-hits");
+	static auto &foodPoolMisses = perf::Counters::get("food-pool-misses");
+	static auto &bodiesAwake = perf::Counters::get("physics-bodies-awake");
+	static auto &bodiesAsleep = perf::Counters::get("physics-bodies-asleep");
+	static auto &stepNanoseconds = perf::Counters::get("physics-step-ns");
+	static auto &steps = perf::Counters::get("physics-steps");
+	static int64_t lastStepNanoseconds = 0, lastSteps = 0;
+	static auto &updateMallocs = perf::Counters::get("world-update-mallocs");
+	static auto &updates = perf::Counters::get("world-updates");
+	static int64_t lastUpdateMallocs = 0, lastUpdates = 0;
+	// average physics step time since the previous status line (compare runs with and without --compound-bodies):
+	int64_t intervalSteps = steps.load() - lastSteps;
+	float stepMicroseconds = intervalSteps ? (stepNanoseconds.load() - lastStepNanoseconds) * 1.e-3f / intervalSteps : 0.f;
+	lastStepNanoseconds = stepNanoseconds.load();
+	lastSteps = steps.load();
+	// heap allocations per World::update since the previous status line:
+	int64_t intervalUpdates = updates.load() - lastUpdates;
+	std::stringstream mallocsPerUpdate;
+	if (perf::getMallocCount() < 0)
+		mallocsPerUpdate << "n/a";	// not built with ENABLE_MALLOC_COUNTER
+	else
+		mallocsPerUpdate << FFMT(1, intervalUpdates ? (float)(updateMallocs.load() - lastUpdateMallocs) / intervalUpdates : 0.f);
+	lastUpdateMallocs = updateMallocs.load();
+	lastUpdates = updates.load();
+	int64_t foodPoolTotal = foodPoolHits.load() + foodPoolMisses.load();
+	ObjectPool::Stats objPool = ObjectPool::getStats();
 	LOGLN(	"SIM-TIME: " << IFMT(5, simulationTime)
 			<< "\tREAL-time: "<< IFMT(5, realTime)
 			<< "\tINST-MUL: " << FFMT(2, simDTAcc/realDTAcc)
 			<< "\tAVG-MUL: " << FFMT(2, simulationTime/realTime)
 			<< "\tPopulation: " << population
-			<< "\tGenerations: " << generations);
+			<< "\tGenerations: " << generations
+			<< "\tGenome-MEM: " << genomeResident.load() / 1024 << " KB (unshared: " << genomeLogical.load() / 1024 << " KB)"
+			<< "\tPhenotype-cache: " << phenotypeHits.load() << " hits / " << phenotypeMisses.load() << " misses"
+			<< "\tFood-pool: " << FFMT(1, foodPoolTotal ? 100.f * foodPoolHits.load() / foodPoolTotal : 0.f) << "% hits"
+			<< "\tBodies: " << bodiesAwake.load() << " awake / " << bodiesAsleep.load() << " asleep"
+			<< "\tPhysics: " << FFMT(1, stepMicroseconds) << " us/step (" << pPhysWld->GetBodyCount() << " bodies, "
+			<< pPhysWld->GetJointCount() << " joints)"
+			<< "\tHeap: " << mallocsPerUpdate.str() << " mallocs/update"
+			<< "\tObject-pool: " << objPool.liveObjects << " objects in " << objPool.chunksInUse * ObjectPool::ChunkSize / 1024
+			<< " KB (" << FFMT(1, 100.f * objPool.getFragmentation()) << "% fragmented)");
+}
+
+// decodes [count] mutants of the default genome on the thread pool and prints statistics about their phenotypes
+void decodeMutants(unsigned count) {
+	LOGPREFIX("decodeMutants");
+	std::vector<Genome> genomes;
+	genomes.reserve(count);
+	for (unsigned i=0; i<count; i++)
+		genomes.push_back(Bug::createBasicMutantGenome());
+	std::vector<Phenotype> phenotypes(count);
+	std::vector<std::pair<Genome*, Phenotype*>> jobs;
+	for (unsigned i=0; i<count; i++)
+		jobs.push_back(std::make_pair(&genomes[i], &phenotypes[i]));
+
+	auto tStart = std::chrono::steady_clock::now();
+	parallel_for(jobs.begin(), jobs.end(), Infrastructure::getThreadPool(), [] (std::pair<Genome*, Phenotype*> &job) {
+		*job.second = PhenotypeDecoder::decode(*job.first);
+	});
+	float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - tStart).count();
+
+	unsigned viable = 0;
+	size_t parts = 0, neurons = 0, synapses = 0, steps = 0;
+	for (auto &ph : phenotypes) {
+		if (!ph.viable)
+			continue;
+		viable++;
+		parts += ph.parts.size();
+		neurons += ph.neuronCount;
+		synapses += ph.synapses.size();
+		steps += ph.developmentSteps;
+	}
+	float n = std::max(1u, viable);
+	LOGLN("decoded " << count << " genomes in " << FFMT(3, elapsed) << " s (" << Infrastructure::getThreadPool().getThreadCount() << " threads)");
+	LOGLN("viable: " << viable << " (" << FFMT(1, 100.f * viable / std::max(1u, count)) << "%)"
+			<< "\tavg parts: " << FFMT(1, parts / n)
+			<< "\tavg neurons: " << FFMT(1, neurons / n)
+			<< "\tavg synapses: " << FFMT(1, synapses / n)
+			<< "\tavg development steps: " << FFMT(1, steps / n));
 }
 
 int main(int argc, char* argv[]) {
@@ -153,6 +261,13 @@ int main(int argc, char* argv[]) {
 		bool defaultSession = false;
 		bool saveSession = false;
 		bool enableAutosave = false;
+		bool islandMode = false;
+		float frameUpdateBudget = 0.030f;	// [s] max wall time spent on simulation steps per displayed frame
+		IslandMigration::Config islandConfig;
+		PopulationAnalytics::Config analyticsConfig;
+		bool recordLineage = false;
+		bool foodParticles = false;
+		LineageLog::Config lineageConfig;
 		for (int i=1; i<argc; i++) {
 			if (!strcmp(argv[i], "--load")) {
 				if (defaultSession) {
@@ -184,6 +299,100 @@ int main(int argc, char* argv[]) {
 				i++;
 			} else if (!strcmp(argv[i], "--enable-autosave")) {
 				enableAutosave = true;
+			} else if (!strcmp(argv[i], "--ff-budget")) {
+				if (i == argc-1) {
+					ERROR("Expected number of milliseconds after --ff-budget");
+					return -1;
+				}
+				frameUpdateBudget = atof(argv[i+1]) * 1.e-3f;
+				i++;
+			} else if (!strcmp(argv[i], "--ff")) {
+				if (i == argc-1) {
+					ERROR("Expected number of steps per frame after --ff");
+					return -1;
+				}
+				stepsPerFrame = std::max(1, std::min((int)maxStepsPerFrame, atoi(argv[i+1])));
+				i++;
+			} else if (!strcmp(argv[i], "--island")) {
+				if (i >= argc-2) {
+					ERROR("Expected island index and island count after --island");
+					return -1;
+				}
+				char *indexEnd = nullptr, *countEnd = nullptr;
+				errno = 0;
+				long index = strtol(argv[i+1], &indexEnd, 10);
+				long count = strtol(argv[i+2], &countEnd, 10);
+				if (errno || indexEnd == argv[i+1] || *indexEnd || countEnd == argv[i+2] || *countEnd) {
+					ERROR("Island index and island count must be integers");
+					return -1;
+				}
+				if (count <= 0 || count > (long)IslandMigration::maxIslandCount) {
+					ERROR("Island count must be between 1 and " << IslandMigration::maxIslandCount);
+					return -1;
+				}
+				if (index < 0 || index >= count) {
+					ERROR("Island index must be between 0 and island count - 1");
+					return -1;
+				}
+				islandMode = true;
+				islandConfig.islandIndex = index;
+				islandConfig.islandCount = count;
+				i += 2;
+			} else if (!strcmp(argv[i], "--island-spool")) {
+				if (i == argc-1) {
+					ERROR("Expected directory after --island-spool");
+					return -1;
+				}
+				islandConfig.spoolDir = argv[i+1];
+				i++;
+			} else if (!strcmp(argv[i], "--island-topology")) {
+				if (i == argc-1 || !IslandMigration::parseTopology(argv[i+1], islandConfig.topology)) {
+					ERROR("Expected ring or all after --island-topology");
+					return -1;
+				}
+				i++;
+			} else if (!strcmp(argv[i], "--island-interval")) {
+				if (i == argc-1) {
+					ERROR("Expected number of seconds after --island-interval");
+					return -1;
+				}
+				islandConfig.migrationInterval = atof(argv[i+1]);
+				i++;
+			} else if (!strcmp(argv[i], "--analytics")) {
+				if (i == argc-1) {
+					ERROR("Expected number of seconds after --analytics");
+					return -1;
+				}
+				analyticsConfig.interval = atof(argv[i+1]);
+				i++;
+			} else if (!strcmp(argv[i], "--analytics-out")) {
+				if (i == argc-1) {
+					ERROR("Expected filename after --analytics-out");
+					return -1;
+				}
+				analyticsConfig.outputPath = argv[i+1];
+				i++;
+			} else if (!strcmp(argv[i], "--lineage")) {
+				if (i == argc-1) {
+					ERROR("Expected filename after --lineage");
+					return -1;
+				}
+				recordLineage = true;
+				lineageConfig.outputPath = argv[i+1];
+				i++;
+			} else if (!strcmp(argv[i], "--compound-bodies")) {
+				BodyPart::setCompoundBodies(true);
+			} else if (!strcmp(argv[i], "--food-particles")) {
+				foodParticles = true;
+			} else if (!strcmp(argv[i], "--decode-mutants")) {
+				// batch mode - no simulation, no window
+				if (i == argc-1) {
+					ERROR("Expected number of genomes after --decode-mutants");
+					return -1;
+				}
+				decodeMutants(std::max(0, atoi(argv[i+1])));
+				Infrastructure::shutDown();
+				return 0;
 			} else {
 				ERROR("Unknown argument " << argv[i]);
 				return -1;
@@ -231,7 +440,13 @@ int main(int argc, char* argv[]) {
 		PhysDestroyListener destroyListener;
 		physWld.SetDestructionListener(&destroyListener);
 
+		// created before the world, so it outlives all the bugs that record into it:
+		std::unique_ptr<LineageLog> lineageLog;
+		if (recordLineage)
+			lineageLog = std::make_unique<LineageLog>(lineageConfig);
 		World world;
+		world.setLineageLog(lineageLog.get());
+		world.getFoodParticles().setEnabled(foodParticles);
 
 		world.setPhysics(&physWld);
 		world.setDestroyListener(&destroyListener);
@@ -244,7 +459,7 @@ int main(int argc, char* argv[]) {
 		win1->addElement(std::make_shared<Button>(glm::vec2(100, 100), glm::vec2(60, 35), "buton1"));
 		win1->addElement(std::make_shared<TextField>(glm::vec2(50, 170), glm::vec2(200, 40), "text"));*/
 
-		OperationsStack opStack(vp1, World::getInstance(), &physWld);
+		OperationsStack opStack(vp1, &world, &physWld);
 		opStack.pushOperation(std::unique_ptr<IOperation>(new OperationPan(InputEvent::MB_RIGHT)));
 		opStack.pushOperation(std::unique_ptr<IOperation>(new OperationSpring(InputEvent::MB_LEFT)));
 		opStack.pushOperation(std::unique_ptr<IOperation>(new OperationGui(Gui)));
@@ -253,7 +468,7 @@ int main(int argc, char* argv[]) {
 		randSeed(time(NULL));
 		LOGLN("RAND seed: "<<rand_seed);
 
-		SessionManager sessionMgr;
+		SessionManager sessionMgr(world);
 
 		if (defaultSession)
 			sessionMgr.startDefaultSession();
@@ -279,7 +494,7 @@ int main(int argc, char* argv[]) {
 				{20, 10, ViewportCoord::percent}); 											// size
 
 		DrawList drawList;
-		drawList.add(World::getInstance());
+		drawList.add(&world);
 		drawList.add(&physWld);
 		drawList.add(&scale);
 		drawList.add(&sigViewer);
@@ -293,7 +508,16 @@ int main(int argc, char* argv[]) {
 		updateList.add(&physWld);
 		updateList.add(&contactListener);
 		updateList.add(&sessionMgr.getPopulationManager());
-		updateList.add(World::getInstance());
+		std::unique_ptr<IslandMigration> islandMigration;
+		if (islandMode) {
+			islandMigration = std::make_unique<IslandMigration>(world, islandConfig);
+			updateList.add(islandMigration.get());
+		}
+		PopulationAnalytics analytics(world, analyticsConfig);
+		updateList.add(&analytics);
+		if (lineageLog)
+			updateList.add(lineageLog.get());
+		updateList.add(&world);
 		updateList.add(&sigViewer);
 
 		float realTime = 0;							// [s]
@@ -382,8 +606,26 @@ int main(int argc, char* argv[]) {
 						simDT = 0;
 				}
 
-				simulationTime += simDT;
-				simDTAcc += simDT;
+				continuousUpdateList.update(realDT);
+				if (simDT > 0) {
+					PERF_MARKER("frame-update");
+					// fast forward: run up to [stepsPerFrame] fixed steps, as many as fit in the frame's time budget;
+					// only the state after the last step is rendered
+					unsigned maxSteps = slowMo ? 1 : stepsPerFrame;
+					unsigned steps = 0;
+					float updateStart = glfwGetTime();
+					do {
+						updateList.update(simDT);
+						simulationTime += simDT;
+						simDTAcc += simDT;
+					} while (++steps < maxSteps && glfwGetTime() - updateStart < frameUpdateBudget);
+				}
+
+				if (runAnalytics) {
+					// on demand (F2)
+					runAnalytics = false;
+					analytics.runNow();
+				}
 
 				if (simulationTime > lastPrintedSimTime+simTimePrintInterval) {
 					int population = sessionMgr.getPopulationManager().getPopulationCount();
@@ -393,12 +635,6 @@ int main(int argc, char* argv[]) {
 					lastPrintedSimTime = simulationTime;
 				}
 
-				continuousUpdateList.update(realDT);
-				if (simDT > 0) {
-					PERF_MARKER("frame-update");
-					updateList.update(simDT);
-				}
-
 				if (!skipRendering) {
 					PERF_MARKER("frame-draw");
 					// wait until previous frame finishes rendering and show frame output:
@@ -420,6 +656,13 @@ int main(int argc, char* argv[]) {
 								{10, 45},
 								0, 18, glm::vec3(1.f, 0.5f, 0.1f));
 					}
+					if (stepsPerFrame > 1 && !slowMo) {
+						std::stringstream ss;
+						ss << ">> Fast forward x" << stepsPerFrame << " >>";
+						GLText::get()->print(ss.str(),
+								{10, 70},
+								0, 18, glm::vec3(0.2f, 1.f, 0.4f));
+					}
 
 					// do the actual openGL render for the previous frame (which is independent of our world)
 					gltBegin();
@@ -448,6 +691,9 @@ int main(int argc, char* argv[]) {
 		std::cout << "\n--------------- END -------------------------------\n";
 	}
 
+	std::cout << "\n============= Counters ==============\n";
+	printCounters();
+
 	std::cout << "\n\n";
 
 	return 0;
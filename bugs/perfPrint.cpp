@@ -7,6 +7,7 @@
 
 #include "perf/section.h"
 #include "perf/frameCapture.h"
+#include "perf/counters.h"
 #include "utils/ioModif.h"
 
 #include <thread>
@@ -226,3 +227,8 @@ void printFrameCaptureData(std::vector<perf::FrameCapture::frameData> data) {
 	std::cout << ioModif::RESET << "\n\n";
 }
 
+
+void printCounters() {
+	for (auto &c : perf::Counters::getAll())
+		std::cout << "\t" << c.first << ": " << c.second << "\n";
+}
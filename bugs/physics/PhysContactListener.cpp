@@ -7,18 +7,20 @@
 
 #include "PhysContactListener.h"
 #include "PhysicsBody.h"
+#include "../Infrastructure.h"
 
 #include "../perf/marker.h"
+#include "../utils/parallel.h"
 #include "../utils/log.h"
 
 #include <Box2D/Box2D.h>
+#include <algorithm>
 
 #ifdef DEBUG_DMALLOC
 #include <dmalloc.h>
 #endif
 
-PhysContactListener::PhysContactListener()
-	: eventBuffer(1024) {
+PhysContactListener::PhysContactListener() {
 }
 
 PhysContactListener::~PhysContactListener() {
@@ -37,21 +39,48 @@ void PhysContactListener::PreSolve(b2Contact* contact, const b2Manifold* oldMani
 }*/
 
 void PhysContactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) {
-	PhysicsBody *body1 = (PhysicsBody*)contact->GetFixtureA()->GetBody()->GetUserData();
-	PhysicsBody *body2 = (PhysicsBody*)contact->GetFixtureB()->GetBody()->GetUserData();
+	// the fixtures tell which object was hit, since a b2Body may be shared by several objects (compound bodies):
+	PhysicsBody *body1 = PhysicsBody::getForFixture(contact->GetFixtureA());
+	PhysicsBody *body2 = PhysicsBody::getForFixture(contact->GetFixtureB());
 	if (!body1 || !body2)
 		return;
 
-	if (body1->categoryFlags_ & body2->collisionEventMask_)
-		eventBuffer.push_back(eventData(body2, body1, impulse->normalImpulses[0]));
-	if (body2->categoryFlags_ & body1->collisionEventMask_)
-		eventBuffer.push_back(eventData(body1, body2, impulse->normalImpulses[0]));
+	// most contacts have no listener; only touch the buffer for the ones that do:
+	bool to2 = (body1->categoryFlags_ & body2->collisionEventMask_) != 0;
+	bool to1 = (body2->categoryFlags_ & body1->collisionEventMask_) != 0;
+	if (!to1 && !to2)
+		return;
+	auto &events = threadBuffers_[b2GetThreadId()].events;
+	if (to2)
+		events.push_back(eventData(body2, body1, impulse->normalImpulses[0]));
+	if (to1)
+		events.push_back(eventData(body1, body2, impulse->normalImpulses[0]));
 }
 
 void PhysContactListener::update(float dt) {
 	PERF_MARKER_FUNC;
-	for (auto e : eventBuffer) {
-		e.target->onCollision.trigger(e.argument, e.impulseMagnitude);
+	events_.clear();
+	for (auto &buf : threadBuffers_) {
+		for (auto &e : buf.events) {
+			e.group = e.target->getEntityFunc_ ? static_cast<void const*>(e.target->getAssociatedEntity()) : e.target;
+			events_.push_back(e);
+		}
+		buf.events.clear();
+	}
+	if (events_.empty())
+		return;
+	// stable, so that each group gets its events in the order they were reported:
+	std::stable_sort(events_.begin(), events_.end(), [] (eventData const& a, eventData const& b) {
+		return a.group < b.group;
+	});
+	groups_.clear();
+	for (unsigned i=0, j; i<events_.size(); i=j) {
+		for (j=i+1; j<events_.size() && events_[j].group == events_[i].group; j++)
+			;
+		groups_.push_back(std::make_pair(i, j));
 	}
-	eventBuffer.clear();
+	parallel_for(groups_.begin(), groups_.end(), Infrastructure::getThreadPool(), [this] (std::pair<unsigned, unsigned> const& g) {
+		for (unsigned i=g.first; i<g.second; i++)
+			events_[i].target->onCollision.trigger(events_[i].argument, events_[i].impulseMagnitude);
+	});
 }
@@ -8,11 +8,22 @@
 #ifndef PHYSCONTACTLISTENER_H_
 #define PHYSCONTACTLISTENER_H_
 
-#include "../utils/MTVector.h"
+#include <Box2D/Common/b2Settings.h>
 #include <Box2D/Dynamics/b2WorldCallbacks.h>
 
+#include <vector>
+#include <utility>
+
 class PhysicsBody;
 
+/*
+ * Gathers the collisions reported during the physics step and triggers the onCollision events of the bodies that
+ * listen for them after the step.
+ * Box2D (-MT) calls PostSolve from several threads, so each of its threads has its own buffer. The events are then
+ * grouped by the entity that owns the target body and the groups are dispatched in parallel on the thread pool:
+ * the handlers of one entity are never called concurrently, but handlers of different entities are, so they must
+ * only modify the other object through thread-safe means (atomics, destroy(), deferred actions).
+ */
 class PhysContactListener : public b2ContactListener {
 public:
 	PhysContactListener();
@@ -23,6 +34,7 @@ public:
 	// void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
 	void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
 
+	// dispatches the events gathered during the last physics step
 	void update(float dt);
 
 private:
@@ -30,12 +42,21 @@ private:
 		PhysicsBody* target;
 		PhysicsBody* argument;
 		float impulseMagnitude;
+		void const* group = nullptr;	// the entity that owns the target; the events of a group are dispatched together
 
 		eventData(PhysicsBody* target, PhysicsBody* arg, float imp)
 			: target(target), argument(arg), impulseMagnitude(imp) {
 		}
 	};
-	MTVector<eventData> eventBuffer;
+	// aligned so the threads don't write into the same cache line
+	struct alignas(64) threadBuffer {
+		std::vector<eventData> events;
+	};
+	threadBuffer threadBuffers_[b2_maxThreads];
+
+	// the events of all the threads, sorted by group, and the [begin, end) ranges of the groups
+	std::vector<eventData> events_;
+	std::vector<std::pair<unsigned, unsigned>> groups_;
 };
 
 #endif /* PHYSCONTACTLISTENER_H_ */
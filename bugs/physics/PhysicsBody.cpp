@@ -9,6 +9,7 @@
 #include "../World.h"
 #include "../math/box2glm.h"
 #include "../math/aabb.h"
+#include "../math/math3D.h"
 #include <Box2D/Box2D.h>
 #include <cmath>
 
@@ -18,6 +19,7 @@
 
 PhysicsBody::PhysicsBody(ObjectTypes userObjType, void* userPtr, EventCategoryFlags::type categFlags, EventCategoryFlags::type collisionMask)
 	: b2Body_(nullptr)
+	, world_(nullptr)
 	, userObjectType_(userObjType)
 	, userPointer_(userPtr)
 	, categoryFlags_(categFlags)
@@ -25,10 +27,7 @@ PhysicsBody::PhysicsBody(ObjectTypes userObjType, void* userPtr, EventCategoryFl
 {
 }
 
-void PhysicsBody::create(const PhysicsProperties& props) {
-	assertDbg(b2Body_==nullptr);
-	assertDbg(userPointer_ != nullptr);
-	assertDbg(userObjectType_ != ObjectTypes::UNDEFINED);
+static b2BodyDef makeBodyDef(PhysicsBody* body, const PhysicsProperties& props) {
 	assertDbg(!std::isnan(props.angle));
 	assertDbg(!std::isnan(props.angularVelocity));
 	assertDbg(!std::isnan(props.position.x));
@@ -40,25 +39,78 @@ void PhysicsBody::create(const PhysicsProperties& props) {
 	def.angle = props.angle;
 	def.position.Set(props.position.x, props.position.y);
 	def.type = props.dynamic ? b2_dynamicBody : b2_staticBody;
-	def.userData = (void*)this;
+	def.userData = (void*)body;
 	def.angularDamping = def.linearDamping = 0.3f;
 	def.angularVelocity = props.angularVelocity;
 	def.linearVelocity = g2b(props.velocity);
+	return def;
+}
+
+void PhysicsBody::create(World* world, const PhysicsProperties& props) {
+	assertDbg(world != nullptr);
+	assertDbg(b2Body_==nullptr && !host_);
+	assertDbg(userPointer_ != nullptr);
+	assertDbg(userObjectType_ != ObjectTypes::UNDEFINED);
 
-	World::getInstance()->queueDeferredAction([this, def] {
-		b2Body_ = World::getInstance()->getPhysics()->CreateBody(&def);
+	b2BodyDef def = makeBodyDef(this, props);
+	world_ = world;
+	world_->queueDeferredAction([this, def] {
+		b2Body_ = world_->getPhysics()->CreateBody(&def);
 	});
 }
 
+void PhysicsBody::createNow(World* world, const PhysicsProperties& props) {
+	assertDbg(world != nullptr);
+	assertDbg(b2Body_==nullptr && !host_);
+	assertDbg(userPointer_ != nullptr);
+	assertDbg(userObjectType_ != ObjectTypes::UNDEFINED);
+#ifdef DEBUG
+	world->assertOnMainThread();
+#endif
+
+	b2BodyDef def = makeBodyDef(this, props);
+	world_ = world;
+	b2Body_ = world_->getPhysics()->CreateBody(&def);
+}
+
+void PhysicsBody::adopt(World* world, b2Body* body, PhysicsProperties const &props) {
+	assertDbg(world != nullptr && body != nullptr);
+	assertDbg(b2Body_==nullptr && !host_);
+#ifdef DEBUG
+	world->assertOnMainThread();
+#endif
+
+	b2BodyDef def = makeBodyDef(this, props);
+	world_ = world;
+	b2Body_ = body;
+	body->SetUserData(def.userData);
+	body->SetType(def.type);
+	body->SetTransform(def.position, def.angle);
+	body->SetLinearVelocity(def.linearVelocity);
+	body->SetAngularVelocity(def.angularVelocity);
+	body->SetLinearDamping(def.linearDamping);
+	body->SetAngularDamping(def.angularDamping);
+}
+
 PhysicsBody::~PhysicsBody() {
 #ifdef DEBUG
-	World::assertOnMainThread();
+	if (world_)
+		world_->assertOnMainThread();
 #endif
+	destroyBody();
+}
+
+void PhysicsBody::destroyBody() {
 	onDestroy.trigger(this);
-	if (b2Body_) {
+	if (host_)
+		unshareBody();
+	else if (b2Body_ && recycleFunc_)
+		recycleFunc_(b2Body_);
+	else if (b2Body_) {
 		auto bodyPtr = b2Body_;
 		bodyPtr->GetWorld()->DestroyBody(bodyPtr);
 	}
+	b2Body_ = nullptr;
 }
 
 PhysicsBody* PhysicsBody::getForB2Body(b2Body* body) {
@@ -67,12 +119,95 @@ PhysicsBody* PhysicsBody::getForB2Body(b2Body* body) {
 	return (PhysicsBody*)body->GetUserData();
 }
 
+PhysicsBody* PhysicsBody::getForFixture(b2Fixture* fixture) {
+	if (fixture->GetUserData())
+		return (PhysicsBody*)fixture->GetUserData();
+	return getForB2Body(fixture->GetBody());
+}
+
+bool PhysicsBody::ownsFixture(b2Fixture* fixture) const {
+	// untagged fixtures belong to the b2Body's owner
+	return fixture->GetUserData() == this || (!host_ && !fixture->GetUserData());
+}
+
+b2Fixture* PhysicsBody::getFixture() const {
+	if (b2Body_) {
+		for (b2Fixture* pFix = b2Body_->GetFixtureList(); pFix; pFix = pFix->GetNext())
+			if (ownsFixture(pFix))
+				return pFix;
+	}
+	return nullptr;
+}
+
 aabb PhysicsBody::getAABB() const {
 	aabb x;
 	if (b2Body_) {
 		for (b2Fixture* pFix = b2Body_->GetFixtureList(); pFix; pFix = pFix->GetNext()) {
-			x = x.reunion(pFix->GetAABB(0));
+			if (ownsFixture(pFix))
+				x = x.reunion(pFix->GetAABB(0));
 		}
 	}
 	return x;
 }
+
+// returns a copy of the shape, moved by the transform; only circles and polygons are supported
+static b2Shape const* transformShape(b2Shape const* shape, b2Transform const& xf,
+		b2CircleShape &circle, b2PolygonShape &polygon) {
+	switch (shape->GetType()) {
+	case b2Shape::e_circle:
+		circle = *static_cast<b2CircleShape const*>(shape);
+		circle.m_p = b2Mul(xf, circle.m_p);
+		return &circle;
+	case b2Shape::e_polygon:
+		polygon = *static_cast<b2PolygonShape const*>(shape);
+		for (int i=0; i<polygon.m_count; i++) {
+			polygon.m_vertices[i] = b2Mul(xf, polygon.m_vertices[i]);
+			polygon.m_normals[i] = b2Mul(xf.q, polygon.m_normals[i]);
+		}
+		polygon.m_centroid = b2Mul(xf, polygon.m_centroid);
+		return &polygon;
+	default:
+		assertDbg(!"shape type not supported");
+		return shape;
+	}
+}
+
+b2Fixture* PhysicsBody::createFixture(b2FixtureDef const& def, glm::vec3 const& offset) {
+	assertDbg(b2Body_ != nullptr);
+	b2FixtureDef fdef = def;
+	fdef.userData = (void*)this;
+	b2CircleShape circle;
+	b2PolygonShape polygon;
+	if (offset != glm::vec3(0))
+		fdef.shape = transformShape(def.shape, b2Transform(g2b(vec3xy(offset)), b2Rot(offset.z)), circle, polygon);
+	return b2Body_->CreateFixture(&fdef);
+}
+
+void PhysicsBody::shareBody(PhysicsBody* host) {
+	assertDbg(host && host->b2Body_ && !host->host_);
+	assertDbg(!b2Body_ && !host_);
+	host_ = host;
+	b2Body_ = host->b2Body_;
+	world_ = host->world_;
+	hostDestroyHandle_ = host->onDestroy.add(std::bind(&PhysicsBody::onHostDestroy, this, std::placeholders::_1));
+}
+
+void PhysicsBody::unshareBody() {
+	if (!host_)
+		return;
+	for (b2Fixture* pFix = b2Body_->GetFixtureList(); pFix; ) {
+		b2Fixture* next = pFix->GetNext();
+		if (pFix->GetUserData() == this)
+			b2Body_->DestroyFixture(pFix);
+		pFix = next;
+	}
+	host_->onDestroy.remove(hostDestroyHandle_);
+	host_ = nullptr;
+	b2Body_ = nullptr;
+}
+
+void PhysicsBody::onHostDestroy(PhysicsBody* host) {
+	onHostDestroyed.trigger(host);
+	// if nobody took care of it, the fixtures must go before the host's b2Body does:
+	unshareBody();
+}
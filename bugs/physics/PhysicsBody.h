@@ -12,10 +12,14 @@
 #include "../math/box2glm.h"
 #include "../ObjectTypesAndFlags.h"
 #include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
 #include <functional>
 
 class b2Body;
+class b2Fixture;
+struct b2FixtureDef;
 class Entity;
+class World;
 struct aabb;
 
 struct PhysicsProperties {
@@ -44,29 +48,69 @@ public:
 	PhysicsBody() : PhysicsBody(ObjectTypes::UNDEFINED, nullptr, 0, 0) {}
 	virtual ~PhysicsBody();
 
-	void create(PhysicsProperties const &props);
+	// creates the b2Body in the given world's physics (deferred until the world executes its deferred actions)
+	void create(World* world, PhysicsProperties const &props);
+	// same as create(), but the b2Body is created right away; only call this on the main thread, outside the physics step
+	void createNow(World* world, PhysicsProperties const &props);
+	// destroys the b2Body (or hands it to recycleFunc_) while this object lives on; triggers onDestroy
+	void destroyBody();
+	// takes over an existing (recycled) b2Body instead of creating one, placing it according to props;
+	// the body is not activated - main thread only
+	void adopt(World* world, b2Body* body, PhysicsProperties const &props);
+	/*
+	 * creates a fixture on b2Body_, placed at [offset] (x, y, angle) relative to the b2Body's origin.
+	 * The fixture is tagged with this object, so collisions with it are reported to this object even when
+	 * the b2Body is shared with others (see shareBody()).
+	 */
+	b2Fixture* createFixture(b2FixtureDef const& def, glm::vec3 const& offset = glm::vec3(0));
+	/*
+	 * makes this object use the host's b2Body instead of having one of its own (a compound body); the fixtures created
+	 * through createFixture() go on the host's b2Body and keep reporting collisions to this object.
+	 * If the host is destroyed first, onHostDestroyed is triggered while its b2Body still exists, so the owner can move
+	 * to a body of its own; otherwise the fixtures go away with the host's b2Body.
+	 */
+	void shareBody(PhysicsBody* host);
+	// stops using the host's b2Body, destroying this object's fixtures on it
+	void unshareBody();
+	PhysicsBody* getHost() const { return host_; }
+	// the first fixture that belongs to this object (b2Body_ may carry fixtures of other objects if it's shared)
+	b2Fixture* getFixture() const;
 	inline glm::vec2 getPosition() { return b2g(b2Body_->GetPosition()); }
 	inline Entity* getAssociatedEntity() { assertDbg(getEntityFunc_ != nullptr); return getEntityFunc_(*this); }
 	aabb getAABB() const;
 
 	static PhysicsBody* getForB2Body(b2Body* body);
+	// the object that owns the fixture - this is not always the b2Body's owner, if the b2Body is shared
+	static PhysicsBody* getForFixture(b2Fixture* fixture);
 
 	Event<void(PhysicsBody *other, float impulseMagnitude)> onCollision;
 	Event<void(PhysicsBody* caller)> onDestroy;
+	Event<void(PhysicsBody* host)> onHostDestroyed;
 
 	// the Box2D body:
 	b2Body* b2Body_;
+	// the world in which the body was created
+	World* world_;
 	// the type of object that owns this body
 	ObjectTypes userObjectType_;
 	// the pointer MUST be set to the object that owns this body (type of object depends on userObjectType_)
 	void* userPointer_;
 	// this callback MUST be set to a valid function that will return the associated entity of this body
 	std::function<Entity*(PhysicsBody const& body)> getEntityFunc_;
+	// if set, the b2Body is handed over to this when the PhysicsBody is destroyed, instead of being destroyed with it
+	std::function<void(b2Body* body)> recycleFunc_;
 
 	// bit field for the categories that this object belongs to:
 	EventCategoryFlags::type categoryFlags_;
 	// bit mask for what other categories of objects that this collides with should trigger onCollision events on this object
 	EventCategoryFlags::type collisionEventMask_;
+
+private:
+	PhysicsBody* host_ = nullptr;		// the object whose b2Body we're sharing, if any
+	int hostDestroyHandle_ = -1;
+
+	bool ownsFixture(b2Fixture* fixture) const;
+	void onHostDestroy(PhysicsBody* host);
 };
 
 #endif /* OBJECTS_PHYSICSBODY_H_ */
@@ -0,0 +1,120 @@
+/*
+ * SleepManager.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "SleepManager.h"
+#include "PhysicsBody.h"
+#include "../entities/WorldConst.h"
+#include "../math/box2glm.h"
+
+#include "../perf/marker.h"
+#include "../perf/counters.h"
+
+#include <Box2D/Box2D.h>
+#include <algorithm>
+#include <cmath>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+constexpr float SleepManager::RegionSize;
+constexpr unsigned SleepManager::MaxRegions;
+
+// the counters are shared by all the worlds in the process, so each manager adds the change in its own counts
+static perf::Counters::counter_type& awakeCounter() {
+	static auto &c = perf::Counters::get("physics-bodies-awake");
+	return c;
+}
+static perf::Counters::counter_type& asleepCounter() {
+	static auto &c = perf::Counters::get("physics-bodies-asleep");
+	return c;
+}
+
+SleepManager::~SleepManager() {
+	awakeCounter() -= awakeCount_;
+	asleepCounter() -= asleepCount_;
+}
+
+void SleepManager::setBounds(aabb const& bounds) {
+	bounds_ = bounds;
+	glm::vec2 size = bounds.vMax - bounds.vMin;
+	regionSize_ = RegionSize;
+	while ((size.x / regionSize_ + 1) * (size.y / regionSize_ + 1) > MaxRegions)
+		regionSize_ *= 2;
+	gridW_ = std::max(1, (int)std::ceil(size.x / regionSize_));
+	gridH_ = std::max(1, (int)std::ceil(size.y / regionSize_));
+	active_.assign(gridW_ * gridH_, 0);
+}
+
+int SleepManager::regionX(float x) const {
+	return std::min(gridW_ - 1, std::max(0, (int)std::floor((x - bounds_.vMin.x) / regionSize_)));
+}
+
+int SleepManager::regionY(float y) const {
+	return std::min(gridH_ - 1, std::max(0, (int)std::floor((y - bounds_.vMin.y) / regionSize_)));
+}
+
+void SleepManager::clearActiveAreas() {
+	std::fill(active_.begin(), active_.end(), 0);
+}
+
+void SleepManager::addActiveArea(aabb const& area) {
+	if (area.empty())
+		return;
+	glm::vec2 margin(WorldConst::IdleBodyWakeDistance);
+	int x0 = regionX(area.vMin.x - margin.x), x1 = regionX(area.vMax.x + margin.x);
+	int y0 = regionY(area.vMin.y - margin.y), y1 = regionY(area.vMax.y + margin.y);
+	for (int y=y0; y<=y1; y++)
+		std::fill(active_.begin() + y * gridW_ + x0, active_.begin() + y * gridW_ + x1 + 1, 1);
+}
+
+bool SleepManager::isActive(glm::vec2 pos) const {
+	return active_[regionY(pos.y) * gridW_ + regionX(pos.x)] != 0;
+}
+
+bool SleepManager::isIdle(b2Body* body) const {
+	PhysicsBody* pb = PhysicsBody::getForB2Body(body);
+	if (!pb || (pb->categoryFlags_ & EventCategoryFlags::FOOD) == 0)
+		return false;
+	float maxSpeed = WorldConst::IdleBodyRestSpeed;
+	return body->GetLinearVelocity().LengthSquared() < maxSpeed * maxSpeed
+			&& std::abs(body->GetAngularVelocity()) < WorldConst::IdleBodyRestAngularSpeed;
+}
+
+void SleepManager::update(b2World* physWld) {
+	PERF_MARKER_FUNC;
+	unsigned awake = 0, asleep = 0;
+	putToSleepNext_.clear();
+	for (b2Body* body = physWld->GetBodyList(); body; body = body->GetNext()) {
+		if (body->GetType() != b2_dynamicBody || !body->IsActive())
+			continue;	// inactive dynamic bodies are the pooled ones
+		bool active = isActive(b2g(body->GetPosition()));
+		if (body->IsAwake()) {
+			if (!active && isIdle(body)) {
+				body->SetAwake(false);
+				putToSleepNext_.insert(body);
+				asleep++;
+			} else
+				awake++;
+		} else if (putToSleep_.count(body)) {
+			if (active) {
+				body->SetAwake(true);	// a bug is coming, simulate it properly
+				awake++;
+			} else {
+				putToSleepNext_.insert(body);
+				asleep++;
+			}
+		} else
+			asleep++;	// Box2D's own sleep, leave it alone
+	}
+	putToSleep_.swap(putToSleepNext_);
+
+	awakeCounter() += (int64_t)awake - awakeCount_;
+	asleepCounter() += (int64_t)asleep - asleepCount_;
+	awakeCount_ = awake;
+	asleepCount_ = asleep;
+}
@@ -0,0 +1,74 @@
+/*
+ * SleepManager.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef PHYSICS_SLEEPMANAGER_H_
+#define PHYSICS_SLEEPMANAGER_H_
+
+#include "../math/aabb.h"
+
+#include <glm/vec2.hpp>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+class b2World;
+class b2Body;
+
+/*
+ * Physics level of detail for the bodies nobody cares about: food chunks and dead body parts (the bodies in the FOOD
+ * event category) that are far from every living bug are put to sleep as soon as they are slow enough, without
+ * waiting for Box2D's own (much stricter) rest detection. Sleeping bodies cost nothing in the step.
+ *
+ * The world is divided into coarse regions; a region is active while a living bug's AABB (grown by
+ * IdleBodyWakeDistance) touches it. The bodies put to sleep here are woken when their region becomes active, so
+ * near the bugs everything is simulated as before. Box2D still wakes any sleeping body that an awake one touches.
+ *
+ * Main thread only, outside the physics step.
+ */
+class SleepManager {
+public:
+	static constexpr float RegionSize = 4.f;			// [m]
+	static constexpr unsigned MaxRegions = 1 << 16;		// the regions get bigger if the bounds are too large for this
+
+	SleepManager() = default;
+	SleepManager(SleepManager const&) = delete;
+	~SleepManager();
+
+	void setBounds(aabb const& bounds);
+
+	// all the regions become inactive
+	void clearActiveAreas();
+	// the regions touched by the area (grown by IdleBodyWakeDistance) become active
+	void addActiveArea(aabb const& area);
+	bool isActive(glm::vec2 pos) const;
+
+	// puts to sleep the idle bodies in the inactive regions and wakes those (that we put to sleep) in the active ones
+	void update(b2World* physWld);
+
+	// dynamic bodies found in the last update, awake and asleep
+	unsigned getAwakeCount() const { return awakeCount_; }
+	unsigned getAsleepCount() const { return asleepCount_; }
+
+private:
+	aabb bounds_ {glm::vec2(0), glm::vec2(0)};
+	float regionSize_ = RegionSize;
+	int gridW_ = 1, gridH_ = 1;
+	std::vector<uint8_t> active_ = std::vector<uint8_t>(1, 1);	// everything is active until the bounds are set
+
+	// the bodies we put to sleep; the pointers are only compared, a destroyed body simply drops out on the next update
+	std::unordered_set<b2Body*> putToSleep_;
+	std::unordered_set<b2Body*> putToSleepNext_;
+
+	unsigned awakeCount_ = 0;
+	unsigned asleepCount_ = 0;
+
+	int regionX(float x) const;
+	int regionY(float y) const;
+	bool isIdle(b2Body* body) const;
+};
+
+#endif /* PHYSICS_SLEEPMANAGER_H_ */
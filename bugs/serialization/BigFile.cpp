@@ -12,6 +12,13 @@
 #include <memory.h>
 #include <stdint.h>
 #include <fstream>
+#include <cstring>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 static constexpr uint32_t BIGFILE_MAGIC = 0xB16F17E5;
 
@@ -33,23 +40,35 @@ BinaryStream& operator >> (BinaryStream& stream, bigFile_header &h) {
 	return stream;
 }
 
-bool BigFile::loadFromDisk_v1(BinaryStream &fileStream) {
+BigFile::~BigFile() {
+	unmap();
+}
+
+void BigFile::unmap() {
+	if (!mapping_)
+		return;
+	munmap(mapping_, mappingSize_);
+	mapping_ = nullptr;
+	mappingSize_ = 0;
+}
+
+bool BigFile::loadFromDisk_v1(BinaryStream &tableStream) {
+	LOGPREFIX("BigFile")
 	bigFile_tableHeader_v1 tableHeader;
-	fileStream >> tableHeader;
-	std::vector<bigFile_tableEntry_v1> tableEntries;
+	tableStream >> tableHeader;
+	size_t contentsStart = tableStream.getPos() + tableHeader.tableSize;
 	for (unsigned i=0; i<tableHeader.numEntries; i++) {
 		bigFile_tableEntry_v1 entry;
-		fileStream >> entry;
-		tableEntries.push_back(entry);
-	}
-	for (unsigned i=0; i<tableHeader.numEntries; i++) {
-		FileDescriptor &fd = mapFiles[tableEntries[i].filename];
-		fd.fileName = tableEntries[i].filename;
-		fd.size = tableEntries[i].size;
-		fd.ownsMemory_ = true;
-		fd.pStart = malloc(fd.size);
-		#warning "may defer actual malloc and read until the file is requested"
-		fileStream.read(fd.pStart, fd.size);
+		tableStream >> entry;
+		if (contentsStart + entry.offset + entry.size > mappingSize_) {
+			LOGLN("WARNING: BigFile entry \"" << entry.filename << "\" goes past the end of the file! (truncated?)");
+			mapFiles.clear();
+			return false;
+		}
+		FileDescriptor &fd = mapFiles[entry.filename];
+		fd.fileName = entry.filename;
+		fd.size = entry.size;
+		fd.pStart = entry.size ? (char*)mapping_ + contentsStart + entry.offset : nullptr;
 	}
 	return true;
 }
@@ -100,12 +119,32 @@ bool BigFile::saveToDisk_v1(const std::string &path) {
 
 bool BigFile::loadFromDisk(const std::string &path) {
 	LOGPREFIX("BigFile")
+	mapFiles.clear();
+	unmap();
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		ERROR("Could not open " << path << ": " << strerror(errno));
+		return false;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0) {
+		LOGLN("WARNING: Empty or unreadable BigFile at: " << path);
+		close(fd);
+		return false;
+	}
+	// private and writable, so that the pages stay copy-on-write if anyone writes into a loaded file's buffer:
+	void* mapping = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);	// the mapping keeps the file
+	if (mapping == MAP_FAILED) {
+		ERROR("Could not map " << path << ": " << strerror(errno));
+		return false;
+	}
+	mapping_ = mapping;
+	mappingSize_ = st.st_size;
+	// the entries are deserialized in about the order they were written, so let the kernel read ahead:
+	madvise(mapping_, mappingSize_, MADV_SEQUENTIAL);
 	try {
-		std::ifstream file(path, std::ios::in | std::ios::binary);
-		// void* hdrBinData = malloc(sizeof(bigFile_header));
-		// file.read((char*)hdrBinData, sizeof(bigFile_header));
-		//BinaryStream hdrStream(hdrBinData, sizeof(bigFile_header));
-		BinaryStream fileStream(file);
+		BinaryStream fileStream(mapping_, mappingSize_);
 		bigFile_header hdr;
 		fileStream >> hdr;
 		if (hdr.magic != BIGFILE_MAGIC) {
@@ -119,9 +158,6 @@ bool BigFile::loadFromDisk(const std::string &path) {
 			LOGLN("WARNING: No known method to handle version "<<hdr.version<<" of BigFile! canceling...");
 			return false;
 		}
-	} catch (std::ios::failure &e) {
-		ERROR("EXCEPTION during loading from disk (" << path<<"):\n" << e.what());
-		return false;
 	} catch (std::runtime_error &e) {
 		ERROR("EXCEPTION during deserialization from file "<< path<<":\n" << e.what());
 		return false;
@@ -43,8 +43,14 @@ public:
 	};
 
 	BigFile() = default;
-	~BigFile() = default;
+	BigFile(BigFile const&) = delete;
+	~BigFile();
 
+	/*
+	 * maps the file into memory (replacing the current contents); nothing is copied, the descriptors of the loaded
+	 * files point straight into the mapping, so they are only valid while this BigFile lives.
+	 * The pages are read from disk as they are touched.
+	 */
 	bool loadFromDisk(const std::string &path);
 	bool saveToDisk(const std::string &path);
 
@@ -57,8 +63,12 @@ public:
 
 private:
 	std::map<std::string, FileDescriptor> mapFiles;
+	void* mapping_ = nullptr;
+	size_t mappingSize_ = 0;
 
-	bool loadFromDisk_v1(BinaryStream &fileStream);
+	void unmap();
+	// [tableStream] is over the mapping, right after the header
+	bool loadFromDisk_v1(BinaryStream &tableStream);
 	bool saveToDisk_v1(const std::string &path);
 };
 
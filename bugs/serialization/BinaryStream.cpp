@@ -93,6 +93,19 @@ void BinaryStream::read(void* outBuffer, size_t size) {
 	}
 }
 
+void BinaryStream::write(const void* inBuffer, size_t size) {
+	while (pos_ + size > capacity_) {
+		if (ownsBuffer_)
+			expandBuffer();
+		else
+			throw std::runtime_error("attempted to write past the end of unmanaged buffer!");
+	}
+	memcpy((char*)buffer_+pos_, inBuffer, size);
+	pos_ += size;
+	if (pos_ > size_)
+		size_ = pos_;
+}
+
 /**
  * inputs data into the stream, incrementing the position. If the size of the stream grows larger than its capacity:
  * 	a. the capacity is increased if the stream owns the underlying buffer
@@ -40,6 +40,7 @@ public:
 
 	size_t getCapacity() const { return capacity_; }
 	size_t getSize() const { return ifstream_ ? fileSize_ : size_; }
+	size_t getPos() const { return pos_; }
 	const void* getBuffer() const { assertDbg(!ifstream_); return buffer_; }
 	void seek(size_t offset);
 	bool eof() { return ifstream_ ? pos_ >= fileSize_ : pos_ >= size_; }
@@ -49,6 +50,10 @@ public:
 	 * The data will be written exactly as encoded in the stream, no translations or deserialization will occur.
 	 */
 	void read(void* buffer, size_t size);
+	/**
+	 * writes raw data into the stream, exactly as it is in the supplied buffer (the counterpart of read()).
+	 */
+	void write(const void* buffer, size_t size);
 
 	BinaryStream& operator << (int8_t const& i);
 	BinaryStream& operator << (uint8_t const& i);
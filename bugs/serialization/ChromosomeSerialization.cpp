@@ -7,6 +7,7 @@
 
 #include "BinaryStream.h"
 #include "GeneSerialization.h"
+#include "ChromosomeSerialization.h"
 #include "../genetics/Genome.h"
 
 BinaryStream& operator << (BinaryStream &stream, Chromosome::insertion const& ins) {
@@ -30,10 +31,15 @@ BinaryStream& operator << (BinaryStream &stream, Chromosome const& chromosome) {
 }
 
 BinaryStream& operator >> (BinaryStream &stream, Chromosome &chromosome) {
-	chromosome.genes.clear();
-	chromosome.insertions.clear();
 	uint32_t nGenes;
 	stream >> nGenes;
+	deserializeChromosomeGenes(stream, chromosome, nGenes);
+	return stream;
+}
+
+void deserializeChromosomeGenes(BinaryStream &stream, Chromosome &chromosome, uint32_t nGenes) {
+	chromosome.genes.clear();
+	chromosome.insertions.clear();
 	chromosome.genes.reserve(nGenes);
 	for (unsigned i=0; i<nGenes; i++) {
 		Gene g;
@@ -48,5 +54,4 @@ BinaryStream& operator >> (BinaryStream &stream, Chromosome &chromosome) {
 		stream >> ins;
 		chromosome.insertions.push_back(ins);
 	}
-	return stream;
 }
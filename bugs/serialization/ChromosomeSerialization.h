@@ -8,10 +8,15 @@
 #ifndef SERIALIZATION_CHROMOSOMESERIALIZATION_H_
 #define SERIALIZATION_CHROMOSOMESERIALIZATION_H_
 
+#include <cstdint>
+
 struct Chromosome;
 class BinaryStream;
 
 BinaryStream& operator << (BinaryStream &stream, Chromosome const& chromosome);
 BinaryStream& operator >> (BinaryStream &stream, Chromosome &chromosome);
 
+// reads the rest of a chromosome (in the format above) after its gene count has already been read from the stream
+void deserializeChromosomeGenes(BinaryStream &stream, Chromosome &chromosome, uint32_t nGenes);
+
 #endif /* SERIALIZATION_CHROMOSOMESERIALIZATION_H_ */
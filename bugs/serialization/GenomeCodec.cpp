@@ -0,0 +1,570 @@
+/*
+ * GenomeCodec.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+/*
+ * Layout (version 1):
+ * 	uint32		marker
+ * 	uint8		version
+ * 	uint8		metaGeneBits
+ * 	varint		size of the dynamic variations table, followed by the table (floats)
+ * 	chromosome 1:
+ * 		varint	number of genes, followed by the genes
+ * 		insertions
+ * 	chromosome 2:
+ * 		varint	number of edits, followed by the edits; each one begins with a varint (count << 2 | op) and
+ * 				the literal genes follow for REPLACE and INSERT
+ * 		insertions
+ *
+ * 	gene:		uint8 type, meta-gene chance_to_delete, meta-gene chance_to_swap, the type's fields (see visitGeneFields)
+ * 	meta-gene:	value (metaGeneBits/8 bytes), varint index of its dynamic variation in the table
+ * 	atom:		value (zig-zag varint or float), meta-gene chanceToMutate, meta-gene changeAmount
+ * 	insertions:	varint count, followed by pairs of zig-zag varints (index, age)
+ */
+
+#include "GenomeCodec.h"
+#include "BinaryStream.h"
+#include "ChromosomeSerialization.h"
+#include "../utils/FlatMap.h"
+#include "../utils/assert.h"
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <string>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+enum EditOp : unsigned {
+	COPY = 0,		// copy [count] genes from the first chromosome
+	REPLACE = 1,	// [count] literal genes replace as many genes of the first chromosome
+	INSERT = 2,		// [count] literal genes that don't correspond to any gene of the first chromosome
+	SKIP = 3,		// skip [count] genes of the first chromosome
+};
+
+// how far ahead to look for the point where the chromosomes line up again after an insertion in one of them
+constexpr size_t resyncLookahead = 4;
+
+/*
+ * calls v(field) for each field of the gene that is serialized, in order.
+ * The fields are either atoms or plain integers (attribute types).
+ */
+template<class GENE, class V>
+void visitGeneFields(GENE &g, V &v) {
+	switch (g.type) {
+	case gene_type::BODY_ATTRIBUTE:
+		v(g.data.gene_body_attribute.attribute);
+		v(g.data.gene_body_attribute.value);
+		break;
+	case gene_type::PROTEIN:
+		v(g.data.gene_protein.protein);
+		v(g.data.gene_protein.targetSegment);
+		v(g.data.gene_protein.minDepth);
+		v(g.data.gene_protein.maxDepth);
+		break;
+	case gene_type::OFFSET:
+		v(g.data.gene_offset.minDepth);
+		v(g.data.gene_offset.maxDepth);
+		v(g.data.gene_offset.offset);
+		v(g.data.gene_offset.targetSegment);
+		break;
+	case gene_type::JOINT_OFFSET:
+		v(g.data.gene_joint_offset.minDepth);
+		v(g.data.gene_joint_offset.maxDepth);
+		v(g.data.gene_joint_offset.offset);
+		break;
+	case gene_type::PART_ATTRIBUTE:
+		v(g.data.gene_attribute.attribute);
+		v(g.data.gene_attribute.value);
+		v(g.data.gene_attribute.minDepth);
+		v(g.data.gene_attribute.maxDepth);
+		v(g.data.gene_attribute.attribIndex);
+		break;
+	case gene_type::SKIP:
+		v(g.data.gene_skip.minDepth);
+		v(g.data.gene_skip.maxDepth);
+		v(g.data.gene_skip.count);
+		break;
+	case gene_type::SYNAPSE:
+		v(g.data.gene_synapse.from);
+		v(g.data.gene_synapse.to);
+		v(g.data.gene_synapse.weight);
+		v(g.data.gene_synapse.priority);
+		break;
+	case gene_type::NEURON_INPUT_COORD:
+		v(g.data.gene_neuron_input.destNeuronVirtIndex);
+		v(g.data.gene_neuron_input.inCoord);
+		break;
+	case gene_type::NEURON_OUTPUT_COORD:
+		v(g.data.gene_neuron_output.srcNeuronVirtIndex);
+		v(g.data.gene_neuron_output.outCoord);
+		break;
+	case gene_type::TRANSFER_FUNC:
+		v(g.data.gene_transfer_function.targetNeuron);
+		v(g.data.gene_transfer_function.functionID);
+		break;
+	case gene_type::NEURAL_BIAS:
+		v(g.data.gene_neural_constant.targetNeuron);
+		v(g.data.gene_neural_constant.value);
+		break;
+	case gene_type::NEURAL_PARAM:
+		v(g.data.gene_neural_param.targetNeuron);
+		v(g.data.gene_neural_param.value);
+		break;
+#ifdef ENABLE_START_MARKER_GENES
+	case gene_type::START_MARKER:
+#endif
+	case gene_type::NO_OP:
+	case gene_type::STOP:
+		break;
+	default:
+		throw std::runtime_error("GenomeCodec: unknown gene type");
+	}
+}
+
+uint64_t zigzag(int64_t x) {
+	return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63);
+}
+
+int64_t unzigzag(uint64_t z) {
+	return (int64_t)(z >> 1) ^ -(int64_t)(z & 1);
+}
+
+uint32_t floatBits(float f) {
+	uint32_t u;
+	memcpy(&u, &f, sizeof(u));
+	return u;
+}
+
+float bitsFloat(uint32_t u) {
+	float f;
+	memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+void writeVarint(std::vector<uint8_t> &out, uint64_t x) {
+	while (x >= 0x80) {
+		out.push_back((uint8_t)(x | 0x80));
+		x >>= 7;
+	}
+	out.push_back((uint8_t)x);
+}
+
+// the working memory of the encoder; one per thread, reused between calls
+struct Scratch {
+	std::vector<uint8_t> bytes[2];			// the encoded genes of each chromosome
+	std::vector<size_t> geneOffsets[2];		// where each gene begins in bytes[]; one extra entry at the end
+	std::vector<float> variations;			// the table of dynamic variations
+	FlatMap<uint32_t, unsigned> variationIndex;	// float bits -> index in variations
+	std::vector<uint8_t> edits;
+	std::vector<uint8_t> output;
+
+	void reset() {
+		for (int i=0; i<2; i++) {
+			bytes[i].clear();
+			geneOffsets[i].clear();
+		}
+		variations.clear();
+		variationIndex.clear();
+		edits.clear();
+		output.clear();
+	}
+};
+
+class Writer {
+public:
+	Writer(Scratch &s, unsigned metaGeneBits) : s_(s), metaGeneBits_(metaGeneBits) {}
+
+	void setOutput(std::vector<uint8_t> &out) { out_ = &out; }
+
+	void byte(uint8_t b) { out_->push_back(b); }
+
+	void varint(uint64_t x) { writeVarint(*out_, x); }
+
+	void floatValue(float f) {
+		uint32_t u = floatBits(f);
+		for (int i=0; i<4; i++)
+			out_->push_back((uint8_t)(u >> (8*i)));
+	}
+
+	void metaGene(MetaGene const& m) {
+		uint32_t u = floatBits(m.value);
+		unsigned drop = 32 - metaGeneBits_;
+		if (drop) {
+			// round to nearest (the carry may propagate into the exponent, which is still the nearest value)
+			if ((u & 0x7f800000) != 0x7f800000)
+				u += 1u << (drop - 1);
+			u >>= drop;
+		}
+		for (unsigned i=0; i<metaGeneBits_/8; i++)
+			out_->push_back((uint8_t)(u >> (8*i)));
+		uint32_t key = floatBits(m.dynamic_variation);
+		unsigned* index = s_.variationIndex.find(key);
+		if (!index) {
+			index = &s_.variationIndex[key];
+			*index = s_.variations.size();
+			s_.variations.push_back(m.dynamic_variation);
+		}
+		varint(*index);
+	}
+
+	template<typename T>
+	void operator()(Atom<T> const& a) {
+		if (std::is_floating_point<T>::value)
+			floatValue((float)a.value);
+		else
+			varint(zigzag((int64_t)a.value));
+		metaGene(a.chanceToMutate);
+		metaGene(a.changeAmount);
+	}
+
+	template<typename T>
+	void operator()(T const& plainValue) {
+		static_assert(std::is_integral<T>::value, "plain gene fields must be integers");
+		varint(zigzag((int64_t)plainValue));
+	}
+
+	void gene(Gene const& g) {
+		byte((uint8_t)g.type);
+		metaGene(g.chance_to_delete);
+		metaGene(g.chance_to_swap);
+		visitGeneFields(g, *this);
+	}
+
+	void insertions(Chromosome const& c) {
+		varint(c.insertions.size());
+		for (Chromosome::insertion const& i : c.insertions) {
+			varint(zigzag(i.index));
+			varint(zigzag(i.age));
+		}
+	}
+
+private:
+	Scratch &s_;
+	unsigned metaGeneBits_;
+	std::vector<uint8_t> *out_ = nullptr;
+};
+
+class Reader {
+public:
+	Reader(BinaryStream &stream) : stream_(stream) {}
+
+	uint8_t byte() {
+		uint8_t b;
+		stream_ >> b;
+		return b;
+	}
+
+	uint64_t varint() {
+		uint64_t x = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			uint8_t b = byte();
+			x |= (uint64_t)(b & 0x7f) << shift;
+			if (!(b & 0x80))
+				return x;
+		}
+		throw std::runtime_error("GenomeCodec: malformed varint");
+	}
+
+	// reads a count and checks that it's not absurd (each element takes at least one byte)
+	size_t count() {
+		uint64_t n = varint();
+		if (n > stream_.getSize())
+			throw std::runtime_error("GenomeCodec: corrupt element count");
+		return n;
+	}
+
+	float floatValue() {
+		uint32_t u = 0;
+		for (int i=0; i<4; i++)
+			u |= (uint32_t)byte() << (8*i);
+		return bitsFloat(u);
+	}
+
+	void header() {
+		uint8_t version = byte();
+		if (version != GenomeCodec::version)
+			throw std::runtime_error("GenomeCodec: unknown version " + std::to_string(version));
+		metaGeneBits_ = byte();
+		if (metaGeneBits_ != 16 && metaGeneBits_ != 24 && metaGeneBits_ != 32)
+			throw std::runtime_error("GenomeCodec: invalid meta-gene precision");
+		size_t n = count();
+		variations_.reserve(n);
+		for (size_t i=0; i<n; i++)
+			variations_.push_back(floatValue());
+	}
+
+	void metaGene(MetaGene &m) {
+		uint32_t u = 0;
+		for (unsigned i=0; i<metaGeneBits_/8; i++)
+			u |= (uint32_t)byte() << (8*i);
+		m.value = bitsFloat(u << (32 - metaGeneBits_));
+		uint64_t index = varint();
+		if (index >= variations_.size())
+			throw std::runtime_error("GenomeCodec: corrupt meta-gene");
+		m.dynamic_variation = variations_[index];
+	}
+
+	template<typename T>
+	void operator()(Atom<T> &a) {
+		if (std::is_floating_point<T>::value)
+			a.value = floatValue();
+		else
+			a.value = (T)unzigzag(varint());
+		metaGene(a.chanceToMutate);
+		metaGene(a.changeAmount);
+	}
+
+	template<typename T>
+	void operator()(T &plainValue) {
+		static_assert(std::is_integral<T>::value, "plain gene fields must be integers");
+		plainValue = (T)unzigzag(varint());
+	}
+
+	Gene gene() {
+		Gene g;
+		uint8_t type = byte();
+		if (type == (uint8_t)gene_type::INVALID || type > (uint8_t)gene_type::END)
+			throw std::runtime_error("GenomeCodec: unknown gene type");
+		g.type = (gene_type)type;
+		metaGene(g.chance_to_delete);
+		metaGene(g.chance_to_swap);
+		visitGeneFields(g, *this);
+		return g;
+	}
+
+	void insertions(Chromosome &c) {
+		size_t n = count();
+		c.insertions.clear();
+		for (size_t i=0; i<n; i++) {
+			int index = (int)unzigzag(varint());
+			int age = (int)unzigzag(varint());
+			c.insertions.push_back(Chromosome::insertion(index, age));
+		}
+	}
+
+private:
+	BinaryStream &stream_;
+	unsigned metaGeneBits_ = 32;
+	std::vector<float> variations_;
+};
+
+/*
+ * collects the edits that turn the first chromosome into the second one, merging consecutive edits of the same kind
+ */
+class EditWriter {
+public:
+	// [genes] and [offsets] are the encoded genes of the second chromosome, from which the literals are copied
+	EditWriter(std::vector<uint8_t> const& genes, std::vector<size_t> const& offsets, std::vector<uint8_t> &out)
+		: genes_(genes), offsets_(offsets), out_(out) {
+	}
+
+	// [first] is the index in the second chromosome of the first gene affected by the edit
+	void add(EditOp op, size_t count, size_t first) {
+		if (count_ && op == op_ && op != SKIP) {
+			count_ += count;
+			return;
+		}
+		writePending();
+		op_ = op;
+		count_ = count;
+		first_ = first;
+	}
+
+	// writes the last edit and returns the number of edits
+	size_t finish() {
+		writePending();
+		return nEdits_;
+	}
+
+private:
+	std::vector<uint8_t> const& genes_;
+	std::vector<size_t> const& offsets_;
+	std::vector<uint8_t> &out_;
+	EditOp op_ = COPY;
+	size_t count_ = 0;
+	size_t first_ = 0;
+	size_t nEdits_ = 0;
+
+	void writePending() {
+		if (!count_)
+			return;
+		writeVarint(out_, ((uint64_t)count_ << 2) | op_);
+		if (op_ == REPLACE || op_ == INSERT)
+			out_.insert(out_.end(), genes_.begin() + offsets_[first_], genes_.begin() + offsets_[first_ + count_]);
+		nEdits_++;
+		count_ = 0;
+	}
+};
+
+class Encoder {
+public:
+	Encoder(Genome const& genome, Scratch &s, unsigned metaGeneBits)
+		: genome_(genome), s_(s), metaGeneBits_(metaGeneBits), writer_(s, metaGeneBits) {
+		s_.reset();
+	}
+
+	void run(BinaryStream &stream);
+
+private:
+	Genome const& genome_;
+	Scratch &s_;
+	unsigned metaGeneBits_;
+	Writer writer_;
+
+	void encodeGenes(int index, Chromosome const& c);
+	bool sameGene(size_t i2, size_t i1) const;
+	size_t diff();
+};
+
+void Encoder::encodeGenes(int index, Chromosome const& c) {
+	GeneSequence const& genes = c.genes;
+	writer_.setOutput(s_.bytes[index]);
+	s_.geneOffsets[index].reserve(genes.size() + 1);
+	for (size_t i=0; i<genes.size(); i++) {
+		s_.geneOffsets[index].push_back(s_.bytes[index].size());
+		writer_.gene(genes[i]);
+	}
+	s_.geneOffsets[index].push_back(s_.bytes[index].size());
+}
+
+// tells if gene [i2] of the second chromosome is encoded the same as gene [i1] of the first one
+bool Encoder::sameGene(size_t i2, size_t i1) const {
+	size_t size1 = s_.geneOffsets[0][i1+1] - s_.geneOffsets[0][i1];
+	size_t size2 = s_.geneOffsets[1][i2+1] - s_.geneOffsets[1][i2];
+	return size1 == size2
+		&& !memcmp(&s_.bytes[0][s_.geneOffsets[0][i1]], &s_.bytes[1][s_.geneOffsets[1][i2]], size1);
+}
+
+/*
+ * writes into s_.edits the edits that turn the first chromosome into the second one and returns their count.
+ * Where the genes differ, it looks a few genes ahead in both chromosomes for the point where they line up again
+ * (after a gene has been inserted into one of them), and if there's none, the gene is replaced.
+ */
+size_t Encoder::diff() {
+	size_t n1 = s_.geneOffsets[0].size() - 1;
+	size_t n2 = s_.geneOffsets[1].size() - 1;
+	EditWriter edits(s_.bytes[1], s_.geneOffsets[1], s_.edits);
+	size_t i = 0, j = 0;	// i in the second chromosome, j in the first
+	while (i < n2) {
+		if (j < n1 && sameGene(i, j)) {
+			edits.add(COPY, 1, i);
+			i++, j++;
+			continue;
+		}
+		bool resync = false;
+		for (size_t d = 1; d <= resyncLookahead && !resync; d++) {
+			if (j + d < n1 && sameGene(i, j + d)) {
+				edits.add(SKIP, d, i);
+				j += d;
+				resync = true;
+			} else if (j < n1 && i + d < n2 && sameGene(i + d, j)) {
+				edits.add(INSERT, d, i);
+				i += d;
+				resync = true;
+			}
+		}
+		if (resync)
+			continue;
+		if (j < n1) {
+			edits.add(REPLACE, 1, i);
+			j++;
+		} else
+			edits.add(INSERT, 1, i);
+		i++;
+	}
+	return edits.finish();
+}
+
+void Encoder::run(BinaryStream &stream) {
+	encodeGenes(0, genome_.first);
+	encodeGenes(1, genome_.second);
+	size_t nEdits = diff();
+
+	stream << GenomeCodec::marker << GenomeCodec::version << (uint8_t)metaGeneBits_;
+	std::vector<uint8_t> &out = s_.output;
+	writer_.setOutput(out);
+	writer_.varint(s_.variations.size());
+	for (float v : s_.variations)
+		writer_.floatValue(v);
+	writer_.varint(s_.geneOffsets[0].size() - 1);
+	out.insert(out.end(), s_.bytes[0].begin(), s_.bytes[0].end());
+	writer_.insertions(genome_.first);
+	writer_.varint(nEdits);
+	out.insert(out.end(), s_.edits.begin(), s_.edits.end());
+	writer_.insertions(genome_.second);
+	stream.write(out.data(), out.size());
+}
+
+void decodeSecondChromosome(Reader &r, Chromosome const& first, Chromosome &second, std::vector<Gene> &genes) {
+	GeneSequence const& genes1 = first.genes;
+	size_t j = 0;	// position in the first chromosome
+	size_t nEdits = r.count();
+	for (size_t e=0; e<nEdits; e++) {
+		uint64_t h = r.varint();
+		unsigned op = h & 3;
+		uint64_t count = h >> 2;
+		switch (op) {
+		case COPY:
+			if (count > genes1.size() - j)
+				throw std::runtime_error("GenomeCodec: corrupt chromosome edits");
+			for (uint64_t k=0; k<count; k++)
+				genes.push_back(genes1[j++]);
+			break;
+		case REPLACE:
+		case INSERT:
+			for (uint64_t k=0; k<count; k++)
+				genes.push_back(r.gene());
+			if (op == REPLACE)
+				j = std::min<uint64_t>(genes1.size(), j + count);
+			break;
+		case SKIP:
+			j = std::min<uint64_t>(genes1.size(), j + count);
+			break;
+		}
+	}
+	second.genes.assign(genes.data(), genes.size());
+}
+
+} // namespace
+
+constexpr uint32_t GenomeCodec::marker;
+constexpr uint8_t GenomeCodec::version;
+
+void GenomeCodec::encode(BinaryStream &stream, Genome const& genome, Options const& options) {
+	assertDbg(options.metaGeneBits == 16 || options.metaGeneBits == 24 || options.metaGeneBits == 32);
+	static thread_local Scratch scratch;
+	Encoder(genome, scratch, options.metaGeneBits).run(stream);
+}
+
+void GenomeCodec::decode(BinaryStream &stream, Genome &genome) {
+	uint32_t head;
+	stream >> head;
+	if (head != marker) {
+		// original format; [head] is the gene count of the first chromosome
+		deserializeChromosomeGenes(stream, genome.first, head);
+		stream >> genome.second;
+		return;
+	}
+	Reader r(stream);
+	r.header();
+	std::vector<Gene> genes;
+	size_t n1 = r.count();
+	genes.reserve(n1);
+	for (size_t i=0; i<n1; i++)
+		genes.push_back(r.gene());
+	genome.first.genes.assign(genes.data(), genes.size());
+	r.insertions(genome.first);
+	genes.clear();
+	decodeSecondChromosome(r, genome.first, genome.second, genes);
+	r.insertions(genome.second);
+}
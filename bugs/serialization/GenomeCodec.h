@@ -0,0 +1,49 @@
+/*
+ * GenomeCodec.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef SERIALIZATION_GENOMECODEC_H_
+#define SERIALIZATION_GENOMECODEC_H_
+
+#include "../genetics/Genome.h"
+#include <cstdint>
+
+class BinaryStream;
+
+/*
+ * Compact, versioned encoding of a genome:
+ * 	1. gene types are written as single bytes
+ * 	2. integer values (atoms, attribute types, insertions) are zig-zag varints - most of them take one byte
+ * 	3. float atom values are written in full; meta-gene values can be quantized (see Options::metaGeneBits)
+ * 	4. the dynamic variations of the meta-genes are almost always one of a few constants, so they are written once
+ * 		in a table at the beginning and referenced by index
+ * 	5. the second chromosome is written as a list of edits against the first one (copy a run of genes / replace /
+ * 		insert / skip), since the two are usually near-identical
+ *
+ * The encoded genome begins with a 32 bit marker that can never be the gene count of a chromosome in the original format
+ * (see ChromosomeSerialization.h), so decode() reads both formats.
+ */
+class GenomeCodec {
+public:
+	static constexpr uint32_t marker = 0xB065C0DE;
+	static constexpr uint8_t version = 1;
+
+	struct Options {
+		// how many of the top bits of each meta-gene's float value are kept (32, 24 or 16);
+		// 32 is lossless, 24 keeps a relative precision of 2^-16, 16 of 2^-8.
+		unsigned metaGeneBits = 32;
+	};
+
+	static void encode(BinaryStream &stream, Genome const& genome, Options const& options);
+	static void encode(BinaryStream &stream, Genome const& genome) { encode(stream, genome, Options()); }
+	/*
+	 * reads a genome written either by encode() or by the original format (the two chromosomes one after the other).
+	 * throws std::runtime_error if the data is corrupt or of an unknown version.
+	 */
+	static void decode(BinaryStream &stream, Genome &genome);
+};
+
+#endif /* SERIALIZATION_GENOMECODEC_H_ */
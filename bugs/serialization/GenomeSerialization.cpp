@@ -6,18 +6,16 @@
  */
 
 #include "BinaryStream.h"
-#include "ChromosomeSerialization.h"
+#include "GenomeCodec.h"
 #include "../genetics/Genome.h"
 
 BinaryStream& operator << (BinaryStream &stream, Genome const& genome) {
-	stream << genome.first;
-	stream << genome.second;
+	GenomeCodec::encode(stream, genome);
 	return stream;
 }
 
 BinaryStream& operator >> (BinaryStream &stream, Genome &genome) {
-	stream >> genome.first;
-	stream >> genome.second;
+	// this reads both the compact encoding and the original one (chromosomes written one after the other)
+	GenomeCodec::decode(stream, genome);
 	return stream;
 }
-
@@ -87,7 +87,7 @@ bool Serializer::serializeToFile(const std::string &path) {
 	return bigFile.saveToDisk(path);
 }
 
-bool Serializer::deserializeFromFile(const std::string &path) {
+bool Serializer::deserializeFromFile(const std::string &path, World &world) {
 	LOGPREFIX("Serializer");
 	LOGLN("Deserializing file \""<<path<<"\"...");
 	BigFile bigFile;
@@ -118,7 +118,7 @@ bool Serializer::deserializeFromFile(const std::string &path) {
 				continue;
 			}
 			BinaryStream fileStream(fileDesc.pStart, fileDesc.size);
-			deserializeFunc(fileStream);
+			deserializeFunc(fileStream, world);
 		}
 		LOGLN("File deserialization SUCCESSFUL.");
 		return true;
@@ -14,18 +14,21 @@
 #include <map>
 #include <vector>
 
+class World;
+
 class Serializer {
 public:
 	Serializer();
 	virtual ~Serializer();
 
-	typedef std::function<void(BinaryStream &stream)> DeserializeFuncType;
+	// deserialization functions must create the object and add it to the given world
+	typedef std::function<void(BinaryStream &stream, World &world)> DeserializeFuncType;
 
 	void queueObject(serializable_wrap &&obj);
 	bool serializeToFile(const std::string &path);
 
 	static void setDeserializationObjectMapping(SerializationObjectTypes objType, DeserializeFuncType func);
-	bool deserializeFromFile(const std::string &path);
+	bool deserializeFromFile(const std::string &path, World &world);
 
 private:
 	std::vector<serializable_wrap> serializationQueue_;
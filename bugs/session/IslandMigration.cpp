@@ -0,0 +1,222 @@
+/*
+ * IslandMigration.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "IslandMigration.h"
+#include "../World.h"
+#include "../entities/Bug.h"
+#include "../entities/Gamete.h"
+#include "../genetics/Genome.h"
+#include "../body-parts/BodyConst.h"
+#include "../serialization/Serializer.h"
+#include "../serialization/BinaryStream.h"
+#include "../serialization/ChromosomeSerialization.h"
+#include "../serialization/objectTypes.h"
+#include "../math/aabb.h"
+
+#include "../perf/marker.h"
+#include "../utils/log.h"
+#include "../utils/rand.h"
+
+#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include <cerrno>
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+namespace {
+
+// a chromosome travelling between islands, stored in the spool files as a GENOME record
+struct Migrant {
+	Chromosome chromosome;
+	uint32_t generation;
+	float mass;
+
+	void serialize(BinaryStream &stream) {
+		stream << generation << mass << chromosome;
+	}
+	SerializationObjectTypes getSerializationType() { return SerializationObjectTypes::GENOME; }
+};
+
+bool makeDir(std::string const& path) {
+	return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+} // namespace
+
+IslandMigration::IslandMigration(World &world, Config const& config)
+	: world_(world)
+	, config_(config)
+{
+	assertDbg(config_.islandIndex < config_.islandCount);
+	Serializer::setDeserializationObjectMapping(SerializationObjectTypes::GENOME, &IslandMigration::deserializeMigrant);
+	LOGPREFIX("IslandMigration");
+	if (!makeDir(config_.spoolDir) || !makeDir(getInboxPath(config_.islandIndex)))
+		ERROR("Could not create spool directory \"" << getInboxPath(config_.islandIndex) << "\"");
+	LOGLN("Island " << config_.islandIndex << " of " << config_.islandCount
+			<< ", topology: " << (config_.topology == Topology::RING ? "ring" : "all-to-all")
+			<< ", spool: \"" << config_.spoolDir << "\"");
+}
+
+bool IslandMigration::parseTopology(std::string const& str, Topology &out) {
+	if (str == "ring")
+		out = Topology::RING;
+	else if (str == "all")
+		out = Topology::ALL_TO_ALL;
+	else
+		return false;
+	return true;
+}
+
+std::string IslandMigration::getInboxPath(unsigned islandIndex) const {
+	std::stringstream ss;
+	ss << config_.spoolDir << "/island" << islandIndex;
+	return ss.str();
+}
+
+std::vector<unsigned> IslandMigration::getNeighbours() const {
+	std::vector<unsigned> ret;
+	if (config_.islandCount < 2)
+		return ret;
+	switch (config_.topology) {
+	case Topology::RING:
+		ret.push_back((config_.islandIndex + 1) % config_.islandCount);
+		break;
+	case Topology::ALL_TO_ALL:
+		for (unsigned i=0; i<config_.islandCount; i++)
+			if (i != config_.islandIndex)
+				ret.push_back(i);
+		break;
+	}
+	return ret;
+}
+
+void IslandMigration::update(float dt) {
+	PERF_MARKER_FUNC;
+	timeSinceExchange_ += dt;
+	if (timeSinceExchange_ < config_.migrationInterval)
+		return;
+	timeSinceExchange_ = 0;
+	unsigned sent = exportMigrants();
+	unsigned received = importMigrants();
+	if (sent || received) {
+		LOGPREFIX("IslandMigration");
+		LOGLN("sent " << sent << " migrants, imported " << received << " spool files");
+	}
+}
+
+unsigned IslandMigration::exportMigrants() {
+	PERF_MARKER_FUNC;
+	std::vector<unsigned> neighbours = getNeighbours();
+	if (neighbours.empty())
+		return 0;
+
+	std::vector<Migrant> migrants;
+	migrants.reserve(config_.migrantsPerExport);
+	// free gametes leave this island:
+	std::vector<Entity*> gametes;
+	world_.getEntities(gametes, EntityType::GAMETE);
+	while (migrants.size() < config_.migrantsPerExport && !gametes.empty()) {
+		unsigned i = randi(gametes.size()-1);
+		Gamete* g = static_cast<Gamete*>(gametes[i]);
+		gametes[i] = gametes.back();
+		gametes.pop_back();
+		if (g->isZombie())
+			continue;
+		migrants.push_back(Migrant{g->getChromosome(), g->generation_, g->getMass()});
+		g->destroy();
+	}
+	// not enough gametes, make new ones from the living bugs' genomes:
+	std::vector<Entity*> bugs;
+	world_.getEntities(bugs, EntityType::BUG);
+	bugs.erase(std::remove_if(bugs.begin(), bugs.end(), [] (Entity* e) {
+		return e->isZombie() || !static_cast<Bug*>(e)->isAlive();
+	}), bugs.end());
+	while (migrants.size() < config_.migrantsPerExport && !bugs.empty()) {
+		Bug* b = static_cast<Bug*>(bugs[randi(bugs.size()-1)]);
+		migrants.push_back(Migrant{GeneticOperations::meyosis(b->getGenome()), b->getGeneration(), BodyConst::initialEggMass});
+	}
+
+	// distribute the migrants among the neighbours; rotate the starting neighbour so they all get their share:
+	unsigned sent = 0;
+	for (unsigned k=0; k<neighbours.size(); k++) {
+		unsigned dest = neighbours[(k + exportSequence_) % neighbours.size()];
+		Serializer serializer;
+		unsigned count = 0;
+		for (unsigned i=k; i<migrants.size(); i+=neighbours.size(), count++)
+			serializer.queueObject(&migrants[i]);
+		if (!count)
+			continue;
+		std::stringstream name;
+		name << config_.islandIndex << "-" << getpid() << "-" << exportSequence_;
+		std::string tmpPath = getInboxPath(dest) + "/." + name.str() + ".tmp";
+		std::string finalPath = getInboxPath(dest) + "/" + name.str() + ".mig";
+		if (!makeDir(getInboxPath(dest)) || !serializer.serializeToFile(tmpPath) || std::rename(tmpPath.c_str(), finalPath.c_str())) {
+			ERROR("Could not export migrants to \"" << finalPath << "\"");
+			std::remove(tmpPath.c_str());
+			continue;
+		}
+		sent += count;
+	}
+	exportSequence_++;
+	return sent;
+}
+
+unsigned IslandMigration::importMigrants() {
+	PERF_MARKER_FUNC;
+	std::string inbox = getInboxPath(config_.islandIndex);
+	std::vector<std::string> files;
+	DIR* dir = opendir(inbox.c_str());
+	if (!dir)
+		return 0;
+	while (dirent* ent = readdir(dir)) {
+		std::string name(ent->d_name);
+		// skip hidden (incomplete) files:
+		if (name[0] == '.' || name.size() < 4 || name.compare(name.size()-4, 4, ".mig"))
+			continue;
+		files.push_back(inbox + "/" + name);
+	}
+	closedir(dir);
+
+	unsigned imported = 0;
+	for (auto &path : files) {
+		Serializer serializer;
+		if (serializer.deserializeFromFile(path, world_)) {
+			std::remove(path.c_str());
+			imported++;
+			continue;
+		}
+		// keep the file for inspection, under a name that won't be picked up again:
+		std::string badPath = path + ".bad";
+		if (std::rename(path.c_str(), badPath.c_str())) {
+			ERROR("Could not import migrants from \"" << path << "\" nor move it out of the inbox");
+		} else {
+			ERROR("Could not import migrants from \"" << path << "\"; moved it to \"" << badPath << "\"");
+		}
+	}
+	return imported;
+}
+
+void IslandMigration::deserializeMigrant(BinaryStream &stream, World &world) {
+	Migrant m;
+	stream >> m.generation >> m.mass >> m.chromosome;
+	aabb bounds = world.getBounds();
+	glm::vec2 center = (bounds.vMin + bounds.vMax) * 0.5f;
+	// keep away from the walls:
+	float halfW = std::max(0.f, (bounds.vMax.x - bounds.vMin.x) * 0.5f - 0.5f);
+	float halfH = std::max(0.f, (bounds.vMax.y - bounds.vMin.y) * 0.5f - 0.5f);
+	glm::vec2 pos = center + glm::vec2(srandf() * halfW, srandf() * halfH);
+	std::unique_ptr<Gamete> gamete(new Gamete(&world, m.chromosome, pos, glm::vec2(0), m.mass));
+	gamete->generation_ = m.generation;
+	world.takeOwnershipOf(std::move(gamete));
+}
@@ -0,0 +1,70 @@
+/*
+ * IslandMigration.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef SESSION_ISLANDMIGRATION_H_
+#define SESSION_ISLANDMIGRATION_H_
+
+#include <string>
+#include <vector>
+
+class World;
+class BinaryStream;
+
+/*
+ * Island model evolution: several simulation processes (islands) each run their own world and periodically
+ * exchange migrants through a spool directory shared between them.
+ * Every [migrationInterval] seconds of simulation time an island exports a sample of its gametes (or, if there are
+ * not enough free gametes, chromosomes obtained by meyosis from living bugs) to each of its neighbours, and imports
+ * the migrants that its neighbours sent to it. Imported migrants are released as gametes at random positions.
+ *
+ * Spool layout: <spoolDir>/island<K>/<from>-<pid>-<seq>.mig is a file addressed to island K;
+ * files are written under a temporary name and renamed when complete, so a reader never sees partial files.
+ */
+class IslandMigration {
+public:
+	enum class Topology {
+		RING,			// island K sends migrants to island K+1 only
+		ALL_TO_ALL,		// island K sends migrants to all other islands
+	};
+
+	struct Config {
+		std::string spoolDir = "island-spool";
+		unsigned islandIndex = 0;
+		unsigned islandCount = 1;
+		Topology topology = Topology::RING;
+		float migrationInterval = 60.f;		// [s] simulation time between two exchanges
+		unsigned migrantsPerExport = 4;		// total number of migrants sent at each exchange
+	};
+
+	static constexpr unsigned maxIslandCount = 256;
+
+	IslandMigration(World &world, Config const& config);
+
+	void update(float dt);
+
+	// exports a sample of migrants to the neighbour islands; returns the number of migrants sent
+	unsigned exportMigrants();
+	// imports all the migrants that are waiting for this island; returns the number of files imported.
+	// files that can't be read are renamed to *.bad and left in the inbox
+	unsigned importMigrants();
+
+	static bool parseTopology(std::string const& str, Topology &out);
+
+private:
+	World &world_;
+	Config config_;
+	float timeSinceExchange_ = 0;
+	unsigned exportSequence_ = 0;
+
+	std::vector<unsigned> getNeighbours() const;
+	std::string getInboxPath(unsigned islandIndex) const;
+
+	// deserialize a migrant from the stream and release it as a gamete into the world
+	static void deserializeMigrant(BinaryStream &stream, World &world);
+};
+
+#endif /* SESSION_ISLANDMIGRATION_H_ */
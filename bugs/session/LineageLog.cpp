@@ -0,0 +1,181 @@
+/*
+ * LineageLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "LineageLog.h"
+#include "../serialization/BinaryStream.h"
+
+#include "../perf/marker.h"
+#include "../utils/log.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+constexpr uint32_t LineageLog::marker;
+constexpr uint16_t LineageLog::version;
+
+void LineageLog::Event::serialize(BinaryStream &stream, Event const& e) {
+	stream << (uint8_t)e.type << e.time << e.id;
+	switch (e.type) {
+	case EventType::BIRTH:
+		stream << e.parents[0] << e.parents[1] << e.generation << e.genomeHash;
+		break;
+	case EventType::DEATH:
+		stream << (uint8_t)e.cause << e.age << e.mass;
+		break;
+	case EventType::EGG:
+		stream << e.mass;
+		break;
+	}
+}
+
+void LineageLog::Event::deserialize(BinaryStream &stream, Event &e) {
+	uint8_t type;
+	stream >> type >> e.time >> e.id;
+	e.type = (EventType)type;
+	switch (e.type) {
+	case EventType::BIRTH:
+		stream >> e.parents[0] >> e.parents[1] >> e.generation >> e.genomeHash;
+		break;
+	case EventType::DEATH: {
+		uint8_t cause;
+		stream >> cause >> e.age >> e.mass;
+		e.cause = (DeathCause)cause;
+		break;
+	}
+	case EventType::EGG:
+		stream >> e.mass;
+		break;
+	default:
+		throw std::runtime_error("Invalid lineage event type");
+	}
+}
+
+LineageLog::LineageLog(Config const& config)
+	: config_(config)
+{
+	LOGPREFIX("LineageLog");
+	file_ = fopen(config_.outputPath.c_str(), "wb");
+	if (!file_) {
+		ERROR("Could not open lineage log \"" << config_.outputPath << "\"");
+		return;
+	}
+	BinaryStream header(8);
+	header << marker << version;
+	fwrite(header.getBuffer(), 1, header.getSize(), file_);
+	pending_.reserve(config_.batchSize);
+	writerThread_ = std::thread(&LineageLog::writerLoop, this);
+}
+
+LineageLog::~LineageLog() {
+	if (!file_)
+		return;
+	{
+		std::lock_guard<std::mutex> lk(mutex_);
+		stop_ = true;
+	}
+	wakeWriter_.notify_one();
+	writerThread_.join();
+	fclose(file_);
+	file_ = nullptr;
+}
+
+void LineageLog::record(Event const& e) {
+	if (!file_)
+		return;
+	bool wake;
+	{
+		std::lock_guard<std::mutex> lk(mutex_);
+		pending_.push_back(e);
+		eventsRecorded_++;
+		wake = pending_.size() >= config_.batchSize;
+	}
+	if (wake)
+		wakeWriter_.notify_one();
+}
+
+void LineageLog::recordBirth(uint64_t id, uint64_t parent1, uint64_t parent2, unsigned generation, uint64_t genomeHash) {
+	Event e;
+	e.type = EventType::BIRTH;
+	e.time = getTime();
+	e.id = id;
+	e.parents[0] = parent1;
+	e.parents[1] = parent2;
+	e.generation = generation;
+	e.genomeHash = genomeHash;
+	record(e);
+}
+
+void LineageLog::recordDeath(uint64_t id, DeathCause cause, float age, float mass) {
+	Event e;
+	e.type = EventType::DEATH;
+	e.time = getTime();
+	e.id = id;
+	e.cause = cause;
+	e.age = age;
+	e.mass = mass;
+	record(e);
+}
+
+void LineageLog::recordEgg(uint64_t parentId, float eggMass) {
+	Event e;
+	e.type = EventType::EGG;
+	e.time = getTime();
+	e.id = parentId;
+	e.mass = eggMass;
+	record(e);
+}
+
+void LineageLog::flush() {
+	if (!file_)
+		return;
+	std::unique_lock<std::mutex> lk(mutex_);
+	uint64_t target = eventsRecorded_;
+	flushRequested_ = true;
+	wakeWriter_.notify_one();
+	batchWritten_.wait(lk, [this, target] {
+		return eventsWritten_.load(std::memory_order_relaxed) >= target;
+	});
+}
+
+void LineageLog::writerLoop() {
+	perf::setCrtThreadName("lineage-writer");
+	std::vector<Event> batch;
+	batch.reserve(config_.batchSize);
+	std::unique_lock<std::mutex> lk(mutex_);
+	while (true) {
+		wakeWriter_.wait_for(lk, std::chrono::duration<float>(config_.flushInterval), [this] {
+			return stop_ || flushRequested_ || pending_.size() >= config_.batchSize;
+		});
+		bool stopping = stop_;
+		flushRequested_ = false;
+		batch.swap(pending_);
+		lk.unlock();
+		if (!batch.empty()) {
+			write(batch);
+			eventsWritten_.fetch_add(batch.size(), std::memory_order_relaxed);
+			batch.clear();
+		}
+		lk.lock();
+		batchWritten_.notify_all();
+		if (stopping && pending_.empty())
+			break;
+	}
+}
+
+void LineageLog::write(std::vector<Event> const& events) {
+	PERF_MARKER_FUNC;
+	BinaryStream stream(events.size() * 48);
+	for (auto &e : events)
+		Event::serialize(stream, e);
+	if (fwrite(stream.getBuffer(), 1, stream.getSize(), file_) != stream.getSize())
+		ERROR("Failed writing " << events.size() << " events to the lineage log");
+	fflush(file_);
+}
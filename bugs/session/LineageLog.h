@@ -0,0 +1,113 @@
+/*
+ * LineageLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef SESSION_LINEAGELOG_H_
+#define SESSION_LINEAGELOG_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+class BinaryStream;
+
+/*
+ * Append-only binary log of the life events of the bugs in a world: births (with the ids of the two bugs that
+ * produced the fused gametes), deaths and egg laying.
+ * Events can be recorded from any thread; they are queued in memory and written to the file in batches by a
+ * background thread, so the simulation never waits for the disk.
+ * The log can be read back and indexed with LineageReader.
+ *
+ * File layout: a header (marker, version) followed by the records, each starting with its type and the simulation
+ * time at which it happened; all values are little-endian (see BinaryStream).
+ */
+class LineageLog {
+public:
+	static constexpr uint32_t marker = 0xB0671AE6;
+	static constexpr uint16_t version = 1;
+
+	enum class EventType : uint8_t {
+		BIRTH = 1,
+		DEATH,
+		EGG,
+	};
+
+	enum class DeathCause : uint8_t {
+		STARVATION = 0,		// ran out of fat and energy
+		NOT_VIABLE,			// the embryo did not develop into a viable bug
+	};
+
+	struct Event {
+		EventType type;
+		float time;					// [s] simulation time
+		uint64_t id;				// the bug this event is about
+		// BIRTH:
+		uint64_t parents[2] {0, 0};	// the ids of the bugs that laid the two gametes; zero if unknown (founders)
+		uint32_t generation = 0;
+		uint64_t genomeHash = 0;
+		// DEATH:
+		DeathCause cause = DeathCause::STARVATION;
+		float age = 0;				// [s] time since the end of embryonic development
+		// DEATH, EGG:
+		float mass = 0;				// bug mass at death or mass of the egg
+
+		static void serialize(BinaryStream &stream, Event const& e);
+		// throws std::runtime_error if the stream ends before the whole event is read
+		static void deserialize(BinaryStream &stream, Event &e);
+	};
+
+	struct Config {
+		std::string outputPath = "lineage.log";
+		unsigned batchSize = 1024;		// events are written as soon as this many are pending
+		float flushInterval = 2.f;		// [s] wall-clock time after which pending events are written anyway
+	};
+
+	// opens (truncates) the output file and starts the writer thread; if the file can't be opened,
+	// an error is logged and all events are discarded
+	LineageLog(Config const& config);
+	// writes all the pending events and stops the writer thread
+	~LineageLog();
+
+	// advances the clock used to time stamp the events
+	void update(float dt) { time_.store(time_.load(std::memory_order_relaxed) + dt, std::memory_order_relaxed); }
+	float getTime() const { return time_.load(std::memory_order_relaxed); }
+
+	// these are thread safe:
+	void recordBirth(uint64_t id, uint64_t parent1, uint64_t parent2, unsigned generation, uint64_t genomeHash);
+	void recordDeath(uint64_t id, DeathCause cause, float age, float mass);
+	void recordEgg(uint64_t parentId, float eggMass);
+
+	// blocks until all the events recorded so far have been written to the file
+	void flush();
+
+	uint64_t getEventsWritten() const { return eventsWritten_.load(std::memory_order_relaxed); }
+
+private:
+	Config config_;
+	FILE* file_ = nullptr;
+	std::atomic<float> time_ {0};
+	std::atomic<uint64_t> eventsWritten_ {0};
+
+	std::mutex mutex_;
+	std::condition_variable wakeWriter_;
+	std::condition_variable batchWritten_;
+	std::vector<Event> pending_;
+	uint64_t eventsRecorded_ = 0;	// protected by mutex_
+	bool flushRequested_ = false;
+	bool stop_ = false;
+	std::thread writerThread_;
+
+	void record(Event const& e);
+	void writerLoop();
+	void write(std::vector<Event> const& events);
+};
+
+#endif /* SESSION_LINEAGELOG_H_ */
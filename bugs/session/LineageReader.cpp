@@ -0,0 +1,165 @@
+/*
+ * LineageReader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "LineageReader.h"
+#include "../serialization/BinaryStream.h"
+
+#include "../perf/marker.h"
+#include "../utils/log.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+bool LineageReader::load(std::string const& path) {
+	PERF_MARKER_FUNC;
+	LOGPREFIX("LineageReader");
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		ERROR("Could not open lineage log \"" << path << "\"");
+		return false;
+	}
+	std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	BinaryStream stream(data.data(), data.size());
+	uint32_t marker = 0;
+	uint16_t version = 0;
+	try {
+		stream >> marker >> version;
+	} catch (std::runtime_error &e) {
+	}
+	if (marker != LineageLog::marker || version != LineageLog::version) {
+		ERROR("\"" << path << "\" is not a lineage log (or has an unsupported version)");
+		return false;
+	}
+	load(stream);
+	if (truncated_)
+		LOGLN("the log is truncated; read " << eventCount_ << " complete events");
+	return true;
+}
+
+void LineageReader::load(BinaryStream &stream) {
+	LineageLog::Event e;
+	while (!stream.eof()) {
+		try {
+			LineageLog::Event::deserialize(stream, e);
+		} catch (std::runtime_error &err) {
+			truncated_ = true;
+			break;
+		}
+		addEvent(e);
+	}
+}
+
+LineageReader::Individual& LineageReader::getOrAdd(uint64_t id) {
+	auto it = index_.find(id);
+	if (it != index_.end())
+		return individuals_[it->second];
+	index_[id] = individuals_.size();
+	individuals_.emplace_back();
+	individuals_.back().id = id;
+	return individuals_.back();
+}
+
+void LineageReader::addEvent(LineageLog::Event const& e) {
+	eventCount_++;
+	switch (e.type) {
+	case LineageLog::EventType::BIRTH: {
+		// the parents are added first, so that founders come before their children
+		for (uint64_t p : e.parents)
+			if (p)
+				getOrAdd(p).children.push_back(e.id);
+		if (e.parents[0] == e.parents[1] && e.parents[0])
+			getOrAdd(e.parents[0]).children.pop_back();	// self-fertilization, don't list the child twice
+		Individual &ind = getOrAdd(e.id);
+		ind.parents[0] = e.parents[0];
+		ind.parents[1] = e.parents[1];
+		ind.generation = e.generation;
+		ind.genomeHash = e.genomeHash;
+		ind.birthTime = e.time;
+		ind.birthRecorded = true;
+		break;
+	}
+	case LineageLog::EventType::DEATH: {
+		Individual &ind = getOrAdd(e.id);
+		ind.dead = true;
+		ind.deathTime = e.time;
+		ind.deathCause = e.cause;
+		ind.age = e.age;
+		ind.mass = e.mass;
+		break;
+	}
+	case LineageLog::EventType::EGG:
+		getOrAdd(e.id).eggsLaid++;
+		break;
+	}
+}
+
+LineageReader::Individual const* LineageReader::find(uint64_t id) const {
+	auto it = index_.find(id);
+	return it != index_.end() ? &individuals_[it->second] : nullptr;
+}
+
+std::vector<uint64_t> LineageReader::getFounders() const {
+	std::vector<uint64_t> ret;
+	for (auto &ind : individuals_)
+		if (!ind.parents[0] && !ind.parents[1])
+			ret.push_back(ind.id);
+	return ret;
+}
+
+template<class F>
+std::vector<uint64_t> LineageReader::walk(uint64_t id, unsigned maxDepth, F neighbours) const {
+	std::vector<uint64_t> ret;
+	std::unordered_set<uint64_t> visited { id };
+	std::vector<uint64_t> level { id }, nextLevel;
+	for (unsigned depth = 0; depth < maxDepth && !level.empty(); depth++) {
+		nextLevel.clear();
+		for (uint64_t crt : level) {
+			Individual const* ind = find(crt);
+			if (!ind)
+				continue;
+			neighbours(*ind, [&] (uint64_t n) {
+				if (n && visited.insert(n).second) {
+					ret.push_back(n);
+					nextLevel.push_back(n);
+				}
+			});
+		}
+		level.swap(nextLevel);
+	}
+	return ret;
+}
+
+std::vector<uint64_t> LineageReader::getAncestors(uint64_t id, unsigned maxDepth) const {
+	return walk(id, maxDepth, [] (Individual const& ind, auto visit) {
+		visit(ind.parents[0]);
+		visit(ind.parents[1]);
+	});
+}
+
+std::vector<uint64_t> LineageReader::getDescendants(uint64_t id) const {
+	return walk(id, ~0u, [] (Individual const& ind, auto visit) {
+		for (uint64_t c : ind.children)
+			visit(c);
+	});
+}
+
+uint64_t LineageReader::findCommonAncestor(uint64_t id1, uint64_t id2) const {
+	std::vector<uint64_t> ancestors1 = getAncestors(id1);
+	std::unordered_set<uint64_t> set1(ancestors1.begin(), ancestors1.end());
+	set1.insert(id1);
+	if (set1.count(id2))
+		return id2;
+	for (uint64_t a : getAncestors(id2))
+		if (set1.count(a))
+			return a;
+	return 0;
+}
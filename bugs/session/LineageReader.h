@@ -0,0 +1,77 @@
+/*
+ * LineageReader.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef SESSION_LINEAGEREADER_H_
+#define SESSION_LINEAGEREADER_H_
+
+#include "LineageLog.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Reads a file written by LineageLog and indexes it by bug id, so the lineage (ancestors and descendants) of any
+ * bug can be walked for analysis.
+ * Bugs that appear only as parents (the founders of the population, or bugs born before the log was started) are
+ * indexed too, without birth information.
+ * A log that was cut short (the simulation was killed while writing) is read up to the last complete event.
+ */
+class LineageReader {
+public:
+	struct Individual {
+		uint64_t id = 0;
+		uint64_t parents[2] {0, 0};
+		unsigned generation = 0;
+		uint64_t genomeHash = 0;
+		bool birthRecorded = false;
+		bool dead = false;
+		float birthTime = 0;
+		float deathTime = 0;
+		LineageLog::DeathCause deathCause = LineageLog::DeathCause::STARVATION;
+		float age = 0;			// at death
+		float mass = 0;			// at death
+		unsigned eggsLaid = 0;
+		std::vector<uint64_t> children;
+	};
+
+	// loads and indexes the file; returns false if the file can't be read or is not a lineage log
+	bool load(std::string const& path);
+	// indexes the events in the stream (which must be positioned after the file header)
+	void load(BinaryStream &stream);
+
+	size_t getEventCount() const { return eventCount_; }
+	size_t getIndividualCount() const { return individuals_.size(); }
+	// true if the last event in the file was incomplete
+	bool isTruncated() const { return truncated_; }
+
+	// returns nullptr if the bug doesn't appear in the log
+	Individual const* find(uint64_t id) const;
+
+	// the bugs with no known parents, in the order in which they appear in the log
+	std::vector<uint64_t> getFounders() const;
+	// all the known ancestors of a bug, closest first, up to [maxDepth] generations back
+	std::vector<uint64_t> getAncestors(uint64_t id, unsigned maxDepth = ~0u) const;
+	// all the known descendants of a bug, closest first
+	std::vector<uint64_t> getDescendants(uint64_t id) const;
+	// the closest ancestor shared by the two bugs (a bug counts as its own ancestor); zero if there is none
+	uint64_t findCommonAncestor(uint64_t id1, uint64_t id2) const;
+
+private:
+	std::vector<Individual> individuals_;						// in the order of first appearance
+	std::unordered_map<uint64_t, unsigned> index_;				// id -> position in individuals_
+	size_t eventCount_ = 0;
+	bool truncated_ = false;
+
+	Individual& getOrAdd(uint64_t id);
+	void addEvent(LineageLog::Event const& e);
+	// breadth-first walk from a bug over its parents or its children; the bug itself is not included
+	template<class F>
+	std::vector<uint64_t> walk(uint64_t id, unsigned maxDepth, F neighbours) const;
+};
+
+#endif /* SESSION_LINEAGEREADER_H_ */
@@ -0,0 +1,90 @@
+/*
+ * PopulationAnalytics.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "PopulationAnalytics.h"
+#include "../World.h"
+#include "../Infrastructure.h"
+#include "../entities/Bug.h"
+#include "../entities/Gamete.h"
+
+#include "../perf/marker.h"
+#include "../utils/log.h"
+
+#include <vector>
+#include <iomanip>
+
+#include <sys/stat.h>
+
+#ifdef DEBUG_DMALLOC
+#include <dmalloc.h>
+#endif
+
+PopulationAnalytics::PopulationAnalytics(World &world, Config const& config)
+	: world_(world)
+	, config_(config)
+{
+}
+
+void PopulationAnalytics::update(float dt) {
+	simulationTime_ += dt;
+	if (config_.interval <= 0)
+		return;
+	timeSinceReport_ += dt;
+	if (timeSinceReport_ >= config_.interval)
+		runNow();
+}
+
+PopulationStatistics::Snapshot PopulationAnalytics::takeSnapshot(World &world, float simulationTime) {
+	PERF_MARKER_FUNC;
+	PopulationStatistics::Snapshot snapshot;
+	snapshot.simulationTime = simulationTime;
+	std::vector<Entity*> entities;
+	world.getEntities(entities, EntityType::BUG);
+	snapshot.genomes.reserve(entities.size());
+	for (Entity* e : entities) {
+		Bug* bug = static_cast<Bug*>(e);
+		if (bug->isAlive())
+			snapshot.genomes.push_back(bug->getGenome());
+	}
+	entities.clear();
+	world.getEntities(entities, EntityType::GAMETE);
+	snapshot.gametes.reserve(entities.size());
+	for (Entity* e : entities)
+		snapshot.gametes.push_back(static_cast<Gamete*>(e)->getChromosome());
+	return snapshot;
+}
+
+PopulationStatistics::Report PopulationAnalytics::runNow() {
+	PERF_MARKER_FUNC;
+	timeSinceReport_ = 0;
+	PopulationStatistics::Snapshot snapshot = takeSnapshot(world_, simulationTime_);
+	PopulationStatistics::Report report = PopulationStatistics::analyze(snapshot, config_.distanceSamples,
+			Infrastructure::getThreadPool());
+	writeReport(report);
+	LOGPREFIX("PopulationAnalytics");
+	LOGLN("chromosomes: " << report.chromosomes
+			<< "\tlength: " << report.lengthMin << ".." << report.lengthMedian << ".." << report.lengthMax
+			<< "\tallele diversity: " << std::fixed << std::setprecision(3) << report.alleleDiversity
+			<< "\tgenome distance: " << report.distanceMean);
+	return report;
+}
+
+void PopulationAnalytics::writeReport(PopulationStatistics::Report const& report) {
+	if (!output_.is_open()) {
+		struct stat buffer;
+		bool exists = stat(config_.outputPath.c_str(), &buffer) == 0 && buffer.st_size > 0;
+		output_.open(config_.outputPath, std::ios::out | std::ios::app);
+		if (!output_.is_open()) {
+			ERROR("Could not open analytics output file \"" << config_.outputPath << "\"");
+			return;
+		}
+		if (!exists)
+			PopulationStatistics::writeCSVHeader(output_);
+	}
+	PopulationStatistics::writeCSVRow(output_, report);
+	output_.flush();
+}
@@ -0,0 +1,51 @@
+/*
+ * PopulationAnalytics.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef SESSION_POPULATIONANALYTICS_H_
+#define SESSION_POPULATIONANALYTICS_H_
+
+#include "../genetics/PopulationStatistics.h"
+
+#include <string>
+#include <fstream>
+
+class World;
+
+/*
+ * Periodically (every [interval] seconds of simulation time) or on demand, takes a snapshot of the genetic material of
+ * the world (living bugs and free gametes), computes the population statistics on the thread pool
+ * (see PopulationStatistics) and appends them as a line to a CSV time series.
+ * The output file is created (or appended to) when the first report is written.
+ */
+class PopulationAnalytics {
+public:
+	struct Config {
+		float interval = 0;						// [s] simulation time between two reports; zero means on demand only
+		std::string outputPath = "analytics.csv";
+		unsigned distanceSamples = 256;			// number of random pairs of genomes compared at each report
+	};
+
+	PopulationAnalytics(World &world, Config const& config);
+
+	void update(float dt);
+
+	// analyzes the population now and writes the report
+	PopulationStatistics::Report runNow();
+
+	static PopulationStatistics::Snapshot takeSnapshot(World &world, float simulationTime);
+
+private:
+	World &world_;
+	Config config_;
+	float simulationTime_ = 0;
+	float timeSinceReport_ = 0;
+	std::ofstream output_;
+
+	void writeReport(PopulationStatistics::Report const& report);
+};
+
+#endif /* SESSION_POPULATIONANALYTICS_H_ */
@@ -38,7 +38,8 @@ unsigned PopulationManager::getPopulationTarget() {
 
 void PopulationManager::update(float dt) {
 	PERF_MARKER_FUNC;
-	unsigned bugPopulation = Bug::getPopulationCount() + Bug::getZygotesCount();
+	World::PopulationStats &stats = world_.getPopulationStats();
+	unsigned bugPopulation = stats.population + stats.freeZygotes;
 	if (bugPopulation != 0 && bugPopulation <= minPopulation) {
 		LOGPREFIX("PopulationManager");
 		LOGLN("Population reached the minimum point ("<<minPopulation<<"). Refilling up to "<<refillPopulationTarget<<"...");
@@ -53,16 +54,16 @@ void PopulationManager::update(float dt) {
 //			Bug* bug = static_cast<Bug*>(vec[idx]);
 			glm::vec2 pos = glm::vec2(srandf()*worldSize_.x*0.5f, srandf()*worldSize_.y*0.5f);
 //			std::unique_ptr<Bug> newBug(new Bug(bug->getGenome(), bug->getMass(), pos, glm::vec2(0), bug->getGeneration()));
-			std::unique_ptr<Bug> newBug(Bug::newBasicMutantBug(pos));
-			World::getInstance()->takeOwnershipOf(std::move(newBug));
+			std::unique_ptr<Bug> newBug(Bug::newBasicMutantBug(&world_, pos));
+			world_.takeOwnershipOf(std::move(newBug));
 		}
 	}
 }
 
 unsigned PopulationManager::getPopulationCount() {
-	return Bug::getPopulationCount();
+	return world_.getPopulationStats().population;
 }
 
 unsigned PopulationManager::getMaxGeneration() {
-	return Bug::getMaxGeneration();
+	return world_.getPopulationStats().maxGeneration;
 }
@@ -10,8 +10,12 @@
 
 #include <glm/vec2.hpp>
 
+class World;
+
 class PopulationManager {
 public:
+	explicit PopulationManager(World &world) : world_(world) {}
+
 	void update(float dt);
 	void setWorldSize(glm::vec2 size) { worldSize_ = size; }
 
@@ -20,6 +24,7 @@ public:
 	unsigned getPopulationTarget();
 
 private:
+	World &world_;
 	glm::vec2 worldSize_{0};
 };
 
@@ -11,9 +11,11 @@
 #include "PopulationManager.h"
 #include <string>
 
+class World;
+
 class SessionManager {
 public:
-	SessionManager();
+	explicit SessionManager(World &world);
 	virtual ~SessionManager() = default;
 
 	void startEmptySession();
@@ -23,8 +25,10 @@ public:
 	bool saveSessionToFile(std::string const &path);
 
 	PopulationManager& getPopulationManager() { return populationMgr; }
+	World& getWorld() { return world_; }
 
 private:
+	World &world_;
 	PopulationManager populationMgr;
 };
 
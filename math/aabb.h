@@ -43,7 +43,7 @@ struct aabb {
 	aabb(const aabb& x) = default;
 	aabb& operator = (aabb const& x) = default;
 
-	bool empty() {
+	bool empty() const {
 		return vMin.x > vMax.x || vMin.y > vMax.y;
 	}
 
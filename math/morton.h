@@ -0,0 +1,57 @@
+/*
+ * morton.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef MATH_MORTON_H_
+#define MATH_MORTON_H_
+
+#include <cstdint>
+#include <algorithm>
+
+// spreads the lower 16 bits of x so that there's a zero bit between each two consecutive bits
+inline uint32_t mortonSpreadBits(uint32_t x) {
+	x &= 0x0000ffff;
+	x = (x | (x << 8)) & 0x00ff00ff;
+	x = (x | (x << 4)) & 0x0f0f0f0f;
+	x = (x | (x << 2)) & 0x33333333;
+	x = (x | (x << 1)) & 0x55555555;
+	return x;
+}
+
+// inverse of mortonSpreadBits
+inline uint32_t mortonCompactBits(uint32_t x) {
+	x &= 0x55555555;
+	x = (x | (x >> 1)) & 0x33333333;
+	x = (x | (x >> 2)) & 0x0f0f0f0f;
+	x = (x | (x >> 4)) & 0x00ff00ff;
+	x = (x | (x >> 8)) & 0x0000ffff;
+	return x;
+}
+
+// computes the Z-order curve index of the (x, y) grid point (16 bits per axis)
+inline uint32_t mortonEncode(uint16_t x, uint16_t y) {
+	return mortonSpreadBits(x) | (mortonSpreadBits(y) << 1);
+}
+
+inline void mortonDecode(uint32_t code, uint16_t &outX, uint16_t &outY) {
+	outX = mortonCompactBits(code);
+	outY = mortonCompactBits(code >> 1);
+}
+
+/*
+ * computes the Z-order index of a point inside the [left, right] x [bottom, top] rectangle;
+ * points outside the rectangle are clamped to its edges.
+ */
+inline uint32_t mortonEncode(float x, float y, float left, float right, float bottom, float top) {
+	constexpr float maxCoord = 65535.f;
+	float u = (x - left) / (right - left) * maxCoord;
+	float v = (y - bottom) / (top - bottom) * maxCoord;
+	u = std::min(maxCoord, std::max(0.f, u));
+	v = std::min(maxCoord, std::max(0.f, v));
+	return mortonEncode((uint16_t)u, (uint16_t)v);
+}
+
+#endif /* MATH_MORTON_H_ */
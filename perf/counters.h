@@ -0,0 +1,61 @@
+/*
+ * counters.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef PERF_COUNTERS_H_
+#define PERF_COUNTERS_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <cstdint>
+
+namespace perf {
+
+/*
+ * Named process-wide counters, for quantities that are not timings (memory in use, objects alive etc).
+ * Obtain a counter once (keep the reference in a static) and update it from any thread:
+ *
+ * 		static auto &bytesInUse = perf::Counters::get("foo-bytes");
+ * 		bytesInUse += size;
+ */
+class Counters {
+public:
+	typedef std::atomic<int64_t> counter_type;
+
+	// returns the counter with the given name, creating it (with value zero) if it doesn't exist.
+	// the returned reference is valid until the end of the program.
+	static counter_type& get(std::string const& name) {
+		std::lock_guard<std::mutex> lk(mutex());
+		return map()[name];
+	}
+
+	// returns the current values of all the counters, sorted by name
+	static std::vector<std::pair<std::string, int64_t>> getAll() {
+		std::lock_guard<std::mutex> lk(mutex());
+		std::vector<std::pair<std::string, int64_t>> ret;
+		for (auto &c : map())
+			ret.emplace_back(c.first, c.second.load(std::memory_order_relaxed));
+		return ret;
+	}
+
+private:
+	static std::map<std::string, counter_type>& map() {
+		static std::map<std::string, counter_type> m;
+		return m;
+	}
+	static std::mutex& mutex() {
+		static std::mutex m;
+		return m;
+	}
+};
+
+} // namespace perf
+
+#endif /* PERF_COUNTERS_H_ */
@@ -0,0 +1,83 @@
+/*
+ * mallocCounter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "mallocCounter.h"
+
+#include <atomic>
+#include <cstddef>
+
+/*
+ * Opt-in: build with -DENABLE_MALLOC_COUNTER to count. This replaces the process-wide malloc, calloc and realloc
+ * with wrappers around glibc's own (__libc_*), so it only works with glibc and can't be combined with another
+ * malloc replacement (DEBUG_DMALLOC, ASan, tcmalloc).
+ */
+#if defined(ENABLE_MALLOC_COUNTER) && defined(DEBUG_DMALLOC)
+#error "ENABLE_MALLOC_COUNTER can't be used together with DEBUG_DMALLOC"
+#endif
+
+#ifdef ENABLE_MALLOC_COUNTER
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t n, size_t size);
+extern "C" void* __libc_realloc(void* p, size_t size);
+
+namespace {
+
+// the threads count on different cache lines, so the allocations on the thread pool don't fight over one of them
+constexpr unsigned nStripes = 16;
+struct alignas(64) stripe {
+	std::atomic<int64_t> count;
+};
+stripe stripes[nStripes];
+std::atomic<unsigned> nextStripe {0};
+thread_local int crtStripe = -1;	// constant-initialized, so reading it never allocates
+
+inline void countAllocation() {
+	if (crtStripe < 0)
+		crtStripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % nStripes;
+	stripes[crtStripe].count.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+extern "C" void* malloc(size_t size) {
+	countAllocation();
+	return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t n, size_t size) {
+	countAllocation();
+	return __libc_calloc(n, size);
+}
+
+extern "C" void* realloc(void* p, size_t size) {
+	countAllocation();
+	return __libc_realloc(p, size);
+}
+
+namespace perf {
+
+int64_t getMallocCount() {
+	int64_t sum = 0;
+	for (auto &s : stripes)
+		sum += s.count.load(std::memory_order_relaxed);
+	return sum;
+}
+
+} // namespace perf
+
+#else
+
+namespace perf {
+
+int64_t getMallocCount() {
+	return -1;
+}
+
+} // namespace perf
+
+#endif // ENABLE_MALLOC_COUNTER
@@ -0,0 +1,24 @@
+/*
+ * mallocCounter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef PERF_MALLOCCOUNTER_H_
+#define PERF_MALLOCCOUNTER_H_
+
+#include <cstdint>
+
+namespace perf {
+
+/*
+ * Number of heap allocations (malloc, calloc, realloc - and so operator new) made by the whole process so far.
+ * Take the difference over the code you measure.
+ * Returns -1 unless the program is built with ENABLE_MALLOC_COUNTER (see mallocCounter.cpp).
+ */
+int64_t getMallocCount();
+
+} // namespace perf
+
+#endif /* PERF_MALLOCCOUNTER_H_ */
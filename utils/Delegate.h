@@ -0,0 +1,153 @@
+/*
+ * Delegate.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef UTILS_DELEGATE_H_
+#define UTILS_DELEGATE_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, class Alloc = std::allocator<char>>
+class Delegate;
+
+/*
+ * A callable wrapper like std::function, but callables up to InlineSize bytes (lambdas capturing a few pointers,
+ * std::bind of a member function and an object) are stored inside the delegate itself instead of on the heap.
+ * Bigger ones are allocated with Alloc (which must be stateless).
+ * Calling goes through a single function pointer.
+ */
+template <typename R, typename... Args, class Alloc>
+class Delegate<R(Args...), Alloc> {
+public:
+	static constexpr size_t InlineSize = 4 * sizeof(void*);
+
+	Delegate() = default;
+	Delegate(std::nullptr_t) {}
+
+	template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Delegate>::value>::type>
+	Delegate(F &&f) {
+		typedef typename std::decay<F>::type Fn;
+		ops_ = Ops<Fn>::table();
+		Ops<Fn>::construct(&storage_, std::forward<F>(f));
+	}
+
+	Delegate(Delegate const& d) {
+		if (d.ops_) {
+			d.ops_->copy(&storage_, &d.storage_);
+			ops_ = d.ops_;
+		}
+	}
+
+	Delegate(Delegate &&d) noexcept {
+		if (d.ops_) {
+			d.ops_->move(&storage_, &d.storage_);
+			ops_ = d.ops_;
+			d.ops_ = nullptr;
+		}
+	}
+
+	~Delegate() { reset(); }
+
+	Delegate& operator = (Delegate const& d) {
+		if (this != &d) {
+			reset();
+			if (d.ops_) {
+				d.ops_->copy(&storage_, &d.storage_);
+				ops_ = d.ops_;
+			}
+		}
+		return *this;
+	}
+
+	Delegate& operator = (Delegate &&d) noexcept {
+		if (this != &d) {
+			reset();
+			if (d.ops_) {
+				d.ops_->move(&storage_, &d.storage_);
+				ops_ = d.ops_;
+				d.ops_ = nullptr;
+			}
+		}
+		return *this;
+	}
+
+	void reset() {
+		if (ops_) {
+			ops_->destroy(&storage_);
+			ops_ = nullptr;
+		}
+	}
+
+	explicit operator bool() const { return ops_ != nullptr; }
+
+	R operator()(Args... args) const {
+		return ops_->invoke(&storage_, std::forward<Args>(args)...);
+	}
+
+private:
+	typedef typename std::aligned_storage<InlineSize, alignof(std::max_align_t)>::type Storage;
+
+	struct OpsTable {
+		R (*invoke)(Storage const* s, Args&&... args);
+		void (*copy)(Storage* dst, Storage const* src);
+		void (*move)(Storage* dst, Storage* src);		// also destroys src
+		void (*destroy)(Storage* s);
+	};
+
+	// small callables live in the storage, the others on the heap with a pointer to them in the storage
+	template<class Fn, bool isInline = (sizeof(Fn) <= InlineSize && alignof(Fn) <= alignof(std::max_align_t)
+										&& std::is_nothrow_move_constructible<Fn>::value)>
+	struct Ops;
+
+	template<class Fn>
+	struct Ops<Fn, true> {
+		static Fn* get(Storage const* s) { return const_cast<Fn*>(reinterpret_cast<Fn const*>(s)); }
+		template<class F>
+		static void construct(Storage* s, F &&f) { new (s) Fn(std::forward<F>(f)); }
+		static R invoke(Storage const* s, Args&&... args) { return (*get(s))(std::forward<Args>(args)...); }
+		static void copy(Storage* dst, Storage const* src) { new (dst) Fn(*get(src)); }
+		static void move(Storage* dst, Storage* src) { new (dst) Fn(std::move(*get(src))); get(src)->~Fn(); }
+		static void destroy(Storage* s) { get(s)->~Fn(); }
+		static OpsTable const* table() {
+			static const OpsTable t { &invoke, &copy, &move, &destroy };
+			return &t;
+		}
+	};
+
+	template<class Fn>
+	struct Ops<Fn, false> {
+		typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Fn> FnAlloc;
+		static Fn* get(Storage const* s) { return *reinterpret_cast<Fn* const*>(s); }
+		template<class F>
+		static void construct(Storage* s, F &&f) {
+			FnAlloc alloc;
+			Fn* p = alloc.allocate(1);
+			new (p) Fn(std::forward<F>(f));
+			new (s) Fn*(p);
+		}
+		static R invoke(Storage const* s, Args&&... args) { return (*get(s))(std::forward<Args>(args)...); }
+		static void copy(Storage* dst, Storage const* src) { construct(dst, *get(src)); }
+		static void move(Storage* dst, Storage* src) { new (dst) Fn*(get(src)); }
+		static void destroy(Storage* s) {
+			Fn* p = get(s);
+			p->~Fn();
+			FnAlloc().deallocate(p, 1);
+		}
+		static OpsTable const* table() {
+			static const OpsTable t { &invoke, &copy, &move, &destroy };
+			return &t;
+		}
+	};
+
+	Storage storage_;
+	OpsTable const* ops_ = nullptr;
+};
+
+#endif /* UTILS_DELEGATE_H_ */
@@ -8,39 +8,80 @@
 #ifndef EVENT_H_
 #define EVENT_H_
 
-#include <functional>
 #include <vector>
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include "Delegate.h"
 #include "assert.h"
 
+/*
+ * A list of callbacks (delegates) that are all called when the event is triggered.
+ * add() returns a handle which stays valid until remove() is called with it, no matter what else is added or removed.
+ * A callback may remove itself (or others) and add new ones while the event is being triggered: removed callbacks
+ * are only marked and destroyed after the outermost trigger() ends, and added ones wait in a separate list until
+ * then (so the list being iterated never moves); callbacks added during trigger() are only called on the next one.
+ */
 template <typename T>
 class Event {
 public:
 
-	int add(std::function<T> fn) {
-		callbackList_.push_back(fn);
-		return callbackList_.size() - 1;
+	template<class F>
+	int add(F &&fn) {
+		compact();
+		(triggerDepth_ ? pending_ : slots_).push_back(Slot{nextHandle_, false, Delegate<T>(std::forward<F>(fn))});
+		return nextHandle_++;
 	}
 
 	void remove(int handle) {
-		assertDbg(handle >= 0 && (unsigned)handle < callbackList_.size());
-		callbackList_[handle] = nullptr;
-	}
-
-	void trigger() {
-		for (auto c : callbackList_)
-			c();
+		// the handles increase along the lists (pending_ comes after slots_), so they're sorted by them:
+		std::vector<Slot> &list = (!pending_.empty() && handle >= pending_.front().handle) ? pending_ : slots_;
+		auto it = std::lower_bound(list.begin(), list.end(), handle, [] (Slot const& s, int h) {
+			return s.handle < h;
+		});
+		assertDbg(it != list.end() && it->handle == handle && !it->removed);
+		// the callback may be the one running right now, it's destroyed by compact() when no trigger() is active:
+		it->removed = true;
+		holes_++;
+		compact();
 	}
 
 	template<typename... argTypes>
-	void trigger(argTypes... argList) {
-		for (auto c : callbackList_)
-			if (c)
-				c(argList...);
+	void trigger(argTypes&&... argList) {
+		triggerDepth_++;
+		for (size_t i=0, n=slots_.size(); i<n; i++)
+			if (!slots_[i].removed)
+				slots_[i].fn(argList...);
+		triggerDepth_--;
+		compact();
 	}
 
 protected:
-	std::vector<std::function<T>> callbackList_;
+	struct Slot {
+		int handle;
+		bool removed;
+		Delegate<T> fn;
+	};
+	std::vector<Slot> slots_;
+	std::vector<Slot> pending_;		// added during trigger(), moved to slots_ by compact()
+	int nextHandle_ = 0;
+	unsigned holes_ = 0;
+	unsigned triggerDepth_ = 0;
+
+	void compact() {
+		if (triggerDepth_)
+			return;
+		if (!pending_.empty()) {
+			std::move(pending_.begin(), pending_.end(), std::back_inserter(slots_));
+			pending_.clear();
+		}
+		if (!holes_)
+			return;
+		slots_.erase(std::remove_if(slots_.begin(), slots_.end(), [] (Slot const& s) {
+			return s.removed;
+		}), slots_.end());
+		holes_ = 0;
+	}
 };
 
 #endif /* EVENT_H_ */
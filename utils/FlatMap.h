@@ -0,0 +1,118 @@
+/*
+ * FlatMap.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef UTILS_FLATMAP_H_
+#define UTILS_FLATMAP_H_
+
+/*
+ *  Flat (open-addressing) hash map for integer and pointer keys.
+ *
+ *  All the entries live in a single array, collisions are resolved by linear probing, so a lookup
+ *  usually touches a single cache line and there is no allocation per element.
+ *  1. there is no erase - the map only grows until it's cleared
+ *  2. clear() keeps the allocated storage, so a map that is reused (for example as a scratch map in a loop)
+ *  	stops allocating altogether once it reached its working size
+ *  3. pointers to values are invalidated when the map grows
+ *  4. iteration order is unspecified
+ */
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+template<class K, class V>
+class FlatMap {
+	static_assert(std::is_integral<K>::value || std::is_pointer<K>::value, "FlatMap keys must be integers or pointers");
+public:
+	FlatMap() = default;
+
+	// returns a pointer to the value mapped to [key] or nullptr if there's none
+	V* find(K key) {
+		if (slots_.empty())
+			return nullptr;
+		for (size_t i = hash(key) & mask(); ; i = (i+1) & mask()) {
+			if (!slots_[i].used)
+				return nullptr;
+			if (slots_[i].key == key)
+				return &slots_[i].value;
+		}
+	}
+	const V* find(K key) const {
+		return const_cast<FlatMap*>(this)->find(key);
+	}
+
+	bool contains(K key) const { return find(key) != nullptr; }
+
+	// returns the value mapped to [key], inserting a default-constructed one if there's none
+	V& operator[](K key) {
+		if ((size_ + 1) * 4 > slots_.size() * 3)	// keep the load factor under 75%
+			grow();
+		size_t i = hash(key) & mask();
+		for (; slots_[i].used; i = (i+1) & mask())
+			if (slots_[i].key == key)
+				return slots_[i].value;
+		slots_[i].used = true;
+		slots_[i].key = key;
+		size_++;
+		return slots_[i].value;
+	}
+
+	size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	// removes all the elements but keeps the storage
+	void clear() {
+		if (size_ == 0)
+			return;
+		for (auto &s : slots_)
+			s = Slot();
+		size_ = 0;
+	}
+
+	// calls f(key, value) for each element
+	template<class F>
+	void forEach(F f) {
+		for (auto &s : slots_)
+			if (s.used)
+				f(s.key, s.value);
+	}
+
+private:
+	struct Slot {
+		K key {};
+		V value {};
+		bool used = false;
+	};
+	std::vector<Slot> slots_;	// size is zero or a power of two
+	size_t size_ = 0;
+
+	size_t mask() const { return slots_.size() - 1; }
+
+	static size_t hash(K key) {
+		// murmur3 finalizer; spreads sequential ints and aligned pointers over the whole table
+		uint64_t h = (uint64_t)(uintptr_t)key;
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdull;
+		h ^= h >> 33;
+		h *= 0xc4ceb9fe1a85ec53ull;
+		h ^= h >> 33;
+		return (size_t)h;
+	}
+
+	void grow() {
+		std::vector<Slot> old;
+		old.swap(slots_);
+		slots_.resize(old.empty() ? 16 : old.size() * 2);
+		size_ = 0;
+		for (auto &s : old)
+			if (s.used)
+				(*this)[s.key] = std::move(s.value);
+	}
+};
+
+#endif /* UTILS_FLATMAP_H_ */
@@ -0,0 +1,65 @@
+/*
+ * FrameArena.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+constexpr size_t FrameArena::BlockSize;
+std::atomic<uint64_t> FrameArena::frame_ {0};
+
+FrameArena& FrameArena::get() {
+	static thread_local FrameArena arena;
+	return arena;
+}
+
+FrameArena::~FrameArena() {
+	for (auto &b : blocks_)
+		free(b.data);
+}
+
+void FrameArena::reset() {
+#ifdef DEBUG
+	for (unsigned i=0; i<blocks_.size() && i<=current_; i++)
+		memset(blocks_[i].data, 0xDD, i < current_ ? blocks_[i].size : offset_);
+#endif
+	current_ = 0;
+	offset_ = 0;
+}
+
+void* FrameArena::allocate(size_t size, size_t align) {
+	uint64_t frame = frame_.load(std::memory_order_acquire);
+	if (frame != frameSeen_) {
+		reset();
+		frameSeen_ = frame;
+	}
+	// the blocks come from malloc, so aligning the offset aligns the address (up to alignof(max_align_t)):
+	while (current_ < blocks_.size()) {
+		Block &b = blocks_[current_];
+		size_t start = (offset_ + align - 1) & ~(align - 1);
+		if (start + size <= b.size) {
+			offset_ = start + size;
+			return b.data + start;
+		}
+		// doesn't fit, the rest of this block is wasted for this frame
+		current_++;
+		offset_ = 0;
+	}
+	// out of blocks; the new one is big enough for this allocation even if it's huge:
+	Block b;
+	b.size = std::max(BlockSize, size);
+	b.data = static_cast<char*>(malloc(b.size));
+	if (!b.data)
+		throw std::bad_alloc();
+	blocks_.push_back(b);
+	current_ = blocks_.size() - 1;
+	offset_ = size;
+	return b.data;
+}
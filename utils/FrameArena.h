@@ -0,0 +1,82 @@
+/*
+ * FrameArena.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef UTILS_FRAMEARENA_H_
+#define UTILS_FRAMEARENA_H_
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Per-thread bump allocator for data that lives at most until the end of the current frame (query results,
+ * deferred actions, job lists): allocating is a pointer increment and freeing is a no-op; all the memory of a frame is
+ * reclaimed at once when the frame ends (World::update calls nextFrame()).
+ * Each thread allocates from its own arena, so there's no locking; memory may be freed (well, dropped) and used on
+ * any thread. A thread's arena is reset the first time it allocates in a new frame; in DEBUG builds the memory of the
+ * old frame is poisoned (0xDD) at that point, so a stale pointer reads garbage instead of plausible data.
+ *
+ * Nothing allocated here may be kept across nextFrame(). Worlds that are updated concurrently must not use it,
+ * since each of them ends the frame for everybody.
+ */
+class FrameArena {
+public:
+	static constexpr size_t BlockSize = 256 * 1024;
+
+	// the arena of the calling thread
+	static FrameArena& get();
+
+	// ends the current frame for all the threads; their memory is reclaimed when they next allocate
+	static void nextFrame() { frame_.fetch_add(1, std::memory_order_release); }
+
+	void* allocate(size_t size, size_t align);
+
+	FrameArena() = default;
+	FrameArena(FrameArena const&) = delete;
+	~FrameArena();
+
+private:
+	struct Block {
+		char* data;
+		size_t size;
+	};
+	std::vector<Block> blocks_;
+	unsigned current_ = 0;		// the block we're allocating from
+	size_t offset_ = 0;			// in the current block
+	uint64_t frameSeen_ = 0;
+
+	static std::atomic<uint64_t> frame_;
+
+	void reset();
+};
+
+// STL allocator on the calling thread's FrameArena
+template<class T>
+class FrameAllocator {
+public:
+	typedef T value_type;
+
+	FrameAllocator() = default;
+	template<class U>
+	FrameAllocator(FrameAllocator<U> const&) {}
+
+	T* allocate(size_t n) {
+		return static_cast<T*>(FrameArena::get().allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T*, size_t) {}
+
+	template<class U>
+	bool operator == (FrameAllocator<U> const&) const { return true; }
+	template<class U>
+	bool operator != (FrameAllocator<U> const&) const { return false; }
+};
+
+template<class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif /* UTILS_FRAMEARENA_H_ */
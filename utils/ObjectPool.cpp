@@ -0,0 +1,199 @@
+/*
+ * ObjectPool.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#include "ObjectPool.h"
+
+#include <mutex>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+
+constexpr size_t ObjectPool::ChunkSize;
+constexpr size_t ObjectPool::MaxObjectSize;
+constexpr size_t ObjectPool::Alignment;
+constexpr unsigned ObjectPool::MaxFreeChunks;
+
+thread_local ObjectPool::Context* ObjectPool::current_ = nullptr;
+
+// at the start of each chunk; the chunks are aligned to ChunkSize, so an object finds its chunk by masking its address
+struct ObjectPool::Chunk {
+	Context* owner;		// the context allocating from it (for a reusing context: the context it belongs to), if any
+	unsigned live;		// objects not freed yet
+	Chunk* next;		// in the list of free chunks, or in the owner's fullChunks_
+};
+
+namespace {
+
+constexpr size_t roundUp(size_t x, size_t a) {
+	return (x + a - 1) & ~(a - 1);
+}
+
+// never destroyed, so the objects and contexts that are destroyed at exit (static ones) can still use it
+struct PoolState {
+	std::mutex mutex;
+	void* freeChunks = nullptr;
+	unsigned nFreeChunks = 0;
+	ObjectPool::Stats stats;
+};
+
+PoolState& state() {
+	static PoolState* s = new PoolState();
+	return *s;
+}
+
+constexpr unsigned nSizeClasses = ObjectPool::MaxObjectSize / ObjectPool::Alignment;
+
+// [size] is already rounded up to Alignment
+inline unsigned sizeClass(size_t size) {
+	return size / ObjectPool::Alignment - 1;
+}
+
+} // namespace
+
+ObjectPool::Context::Context(Policy policy) {
+	if (policy == Policy::ReuseSlots)
+		freeSlots_ = new void*[nSizeClasses]();
+}
+
+ObjectPool::Context::~Context() {
+	std::lock_guard<std::mutex> lk(state().mutex);
+	if (freeSlots_) {
+		// the free slots are only dead objects, the chunks' live counts don't include them:
+		for (unsigned i=0; i<nSizeClasses; i++)
+			for (void* p = freeSlots_[i]; p; p = *static_cast<void**>(p))
+				state().stats.freeSlots--;
+		delete [] freeSlots_;
+		while (fullChunks_) {
+			Chunk* chunk = fullChunks_;
+			fullChunks_ = chunk->next;
+			chunk->owner = nullptr;
+			if (chunk->live == 0)
+				releaseChunk(chunk);
+		}
+	}
+	if (!chunk_)
+		return;
+	chunk_->owner = nullptr;
+	if (chunk_->live == 0)
+		releaseChunk(chunk_);
+}
+
+// call with the lock held
+void ObjectPool::releaseChunk(Chunk* chunk) {
+	PoolState &s = state();
+	s.stats.chunksInUse--;
+	if (s.nFreeChunks >= MaxFreeChunks) {
+		::free(chunk);
+		return;
+	}
+	chunk->next = static_cast<Chunk*>(s.freeChunks);
+	s.freeChunks = chunk;
+	s.nFreeChunks++;
+	s.stats.chunksFree++;
+}
+
+void* ObjectPool::allocate(size_t size, Context &ctx) {
+	PoolState &s = state();
+	if (size > MaxObjectSize) {
+		void* p = ::operator new(size);
+		std::lock_guard<std::mutex> lk(s.mutex);
+		s.stats.heapObjects++;
+		s.stats.liveObjects++;
+		return p;
+	}
+	size = roundUp(size, Alignment);
+	std::lock_guard<std::mutex> lk(s.mutex);
+	if (ctx.freeSlots_ && ctx.freeSlots_[sizeClass(size)]) {
+		// reuse a freed slot of the same size:
+		void* &head = ctx.freeSlots_[sizeClass(size)];
+		void* p = head;
+		head = *static_cast<void**>(p);
+		reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(ChunkSize - 1))->live++;
+		s.stats.freeSlots--;
+		s.stats.liveObjects++;
+		s.stats.liveBytes += size;
+		return p;
+	}
+	if (!ctx.chunk_ || ctx.offset_ + size > ChunkSize) {
+		// retire the current chunk and move to a new one:
+		if (ctx.chunk_ && ctx.freeSlots_) {
+			// its slots may be on the free lists, it stays with the context:
+			ctx.chunk_->next = ctx.fullChunks_;
+			ctx.fullChunks_ = ctx.chunk_;
+		} else if (ctx.chunk_) {
+			ctx.chunk_->owner = nullptr;
+			if (ctx.chunk_->live == 0)
+				releaseChunk(ctx.chunk_);
+		}
+		Chunk* chunk = static_cast<Chunk*>(s.freeChunks);
+		if (chunk) {
+			s.freeChunks = chunk->next;
+			s.nFreeChunks--;
+			s.stats.chunksFree--;
+		} else {
+			chunk = static_cast<Chunk*>(aligned_alloc(ChunkSize, ChunkSize));
+			if (!chunk)
+				throw std::bad_alloc();
+		}
+		s.stats.chunksInUse++;
+		chunk->owner = &ctx;
+		chunk->live = 0;
+		chunk->next = nullptr;
+		ctx.chunk_ = chunk;
+		ctx.offset_ = roundUp(sizeof(Chunk), Alignment);
+	}
+	void* p = reinterpret_cast<char*>(ctx.chunk_) + ctx.offset_;
+	ctx.offset_ += size;
+	ctx.chunk_->live++;
+	s.stats.liveObjects++;
+	s.stats.liveBytes += size;
+	return p;
+}
+
+void ObjectPool::free(void* p, size_t size) {
+	if (!p)
+		return;
+	PoolState &s = state();
+	if (size > MaxObjectSize) {
+		::operator delete(p);
+		std::lock_guard<std::mutex> lk(s.mutex);
+		s.stats.heapObjects--;
+		s.stats.liveObjects--;
+		return;
+	}
+	Chunk* chunk = reinterpret_cast<Chunk*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(ChunkSize - 1));
+	std::lock_guard<std::mutex> lk(s.mutex);
+	size = roundUp(size, Alignment);
+	s.stats.liveObjects--;
+	s.stats.liveBytes -= size;
+	chunk->live--;
+	if (chunk->owner && chunk->owner->freeSlots_) {
+		// the slot goes on the owner's free list, the chunk stays with it even when it's empty:
+		void* &head = chunk->owner->freeSlots_[sizeClass(size)];
+		*static_cast<void**>(p) = head;
+		head = p;
+		s.stats.freeSlots++;
+		return;
+	}
+	if (chunk->live > 0)
+		return;
+	if (chunk->owner)
+		chunk->owner->offset_ = roundUp(sizeof(Chunk), Alignment);	// still being allocated from, start over
+	else
+		releaseChunk(chunk);
+}
+
+ObjectPool::Stats ObjectPool::getStats() {
+	std::lock_guard<std::mutex> lk(state().mutex);
+	return state().stats;
+}
+
+float ObjectPool::Stats::getFragmentation() const {
+	if (!chunksInUse)
+		return 0;
+	return 1.f - (float)liveBytes / (chunksInUse * ChunkSize);
+}
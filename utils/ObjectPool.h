@@ -0,0 +1,94 @@
+/*
+ * ObjectPool.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: bog
+ */
+
+#ifndef UTILS_OBJECTPOOL_H_
+#define UTILS_OBJECTPOOL_H_
+
+#include <cstddef>
+
+/*
+ * Allocator for the many small objects of the simulation (body parts, food chunks, gametes), meant to keep the heap
+ * from fragmenting over long runs.
+ * Objects are allocated in 16KB chunks, each chunk belonging to one allocation context: the body parts of a bug
+ * go into the bug's own context, the objects of other pooled types into their type's shared context.
+ * Contexts come in two kinds:
+ *  - bump-only (a bug's parts): inside a chunk the objects are simply placed one after the other; a chunk is not
+ * 	reused until all its objects are freed, and then it is reused as a whole (or given back to the system if there are
+ * 	enough free chunks). Since these objects die together (a bug's parts when it decays), the chunks empty out
+ * 	cleanly instead of leaving holes all over the heap, and a bug's parts end up contiguous in memory.
+ *  - reusing (the shared contexts, whose objects die one by one): a freed object's slot goes on its size's free list
+ * 	and new objects of that size take the free slots before any new one is bumped. Such a context keeps its chunks
+ * 	until it's destroyed, so its memory is its objects' high water mark.
+ * Objects bigger than MaxObjectSize go to the regular heap.
+ *
+ * Thread safe; all operations take one (short) lock.
+ */
+class ObjectPool {
+	struct Chunk;
+
+public:
+	static constexpr size_t ChunkSize = 16 * 1024;
+	static constexpr size_t MaxObjectSize = ChunkSize / 4;
+	static constexpr size_t Alignment = 16;
+	static constexpr unsigned MaxFreeChunks = 64;	// more than this are given back to the system
+
+	enum class Policy {
+		BumpOnly,		// for objects that die together
+		ReuseSlots,		// for objects that die one by one
+	};
+
+	class Context {
+	public:
+		explicit Context(Policy policy = Policy::BumpOnly);
+		Context(Context const&) = delete;
+		// the context's objects may outlive it; its chunks are released when they're empty
+		~Context();
+
+	private:
+		friend class ObjectPool;
+		Chunk* chunk_ = nullptr;			// the one we're allocating from
+		size_t offset_ = 0;					// in chunk_
+		void** freeSlots_ = nullptr;		// (ReuseSlots only) the free lists' heads, one per size (in Alignment steps)
+		Chunk* fullChunks_ = nullptr;		// (ReuseSlots only) the chunks we're not bumping in any more
+	};
+
+	// makes [ctx] the calling thread's current context (until the scope ends), for the types that allocate from it
+	class Scope {
+	public:
+		explicit Scope(Context &ctx) : prev_(current_) { current_ = &ctx; }
+		~Scope() { current_ = prev_; }
+	private:
+		Context* prev_;
+	};
+
+	// returns nullptr if there's no current context on this thread
+	static Context* getCurrentContext() { return current_; }
+
+	static void* allocate(size_t size, Context &ctx);
+	// [size] must be the same as when allocated
+	static void free(void* p, size_t size);
+
+	struct Stats {
+		size_t liveObjects = 0;
+		size_t liveBytes = 0;		// of the pooled objects, rounded up to Alignment
+		size_t freeSlots = 0;		// freed slots waiting on the free lists of the reusing contexts
+		size_t heapObjects = 0;		// the live objects that were too big for the pool
+		size_t chunksInUse = 0;
+		size_t chunksFree = 0;
+
+		// the part of the chunks in use that's not taken by live objects (wasted by dead objects or not used yet)
+		float getFragmentation() const;
+	};
+	static Stats getStats();
+
+private:
+	static thread_local Context* current_;
+
+	static void releaseChunk(Chunk* chunk);
+};
+
+#endif /* UTILS_OBJECTPOOL_H_ */
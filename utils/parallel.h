@@ -9,6 +9,7 @@
 #define UTILS_PARALLEL_H_
 
 #include "ThreadPool.h"
+#include "FrameArena.h"
 
 #include <iterator>
 #include <algorithm>
@@ -28,7 +29,7 @@ void parallel_for(ITER itB, ITER itE, ThreadPool &pool, F predicate)
 	if (jobs * itemsPerJob < rangeSize)
 		++jobs;
 
-	std::vector<PoolTaskHandle> tasks;
+	FrameVector<PoolTaskHandle> tasks;
 	decltype(itB) start = itB;
 
 	for (unsigned i=0; i<jobs; ++i) {
@@ -47,5 +48,42 @@ void parallel_for(ITER itB, ITER itE, ThreadPool &pool, F predicate)
 		t->wait();
 }
 
+/*
+ * Same as parallel_for, but meant for ranges that are sorted by locality (for example spatially, along a Z-order curve).
+ * The range is split into (threadCount * slicesPerThread) contiguous slices, so each job works on a compact region,
+ * and the slices are queued in a strided order (0, n, 2n, ..., 1, n+1, ...) with n = slicesPerThread, so that the
+ * jobs that run concurrently are far apart in the range and don't compete for the same resources (locks, cache lines).
+ */
+template<class ITER, class F>
+void parallel_for_coherent(ITER itB, ITER itE, ThreadPool &pool, F predicate, unsigned slicesPerThread = 4)
+{
+	size_t rangeSize = std::distance(itB, itE);
+	if (rangeSize == 0)
+		return;
+	unsigned slices = std::min(rangeSize, (size_t)pool.getThreadCount() * std::max(1u, slicesPerThread));
+	unsigned stride = std::max(1u, slices / pool.getThreadCount());
+	size_t itemsPerSlice = rangeSize / slices;
+	size_t remainder = rangeSize % slices;
+
+	FrameVector<PoolTaskHandle> tasks;
+	tasks.reserve(slices);
+	for (unsigned k=0; k<stride; k++) {
+		for (unsigned i=k; i<slices; i+=stride) {
+			// the first [remainder] slices get one extra element each:
+			size_t sliceStart = i * itemsPerSlice + std::min<size_t>(i, remainder);
+			size_t sliceSize = itemsPerSlice + (i < remainder ? 1 : 0);
+			ITER start = itB;
+			std::advance(start, sliceStart);
+			tasks.push_back(pool.queueTask([start, sliceSize, predicate] () mutable {
+				for (size_t j=0; j<sliceSize; j++, ++start)
+					predicate(*start);
+			}));
+		}
+	}
+	// wait for pool tasks to finish:
+	for (auto &t : tasks)
+		t->wait();
+}
+
 
 #endif /* UTILS_PARALLEL_H_ */